@@ -65,12 +65,38 @@ def compile_shaders(shader_folder, shader_compiler_path, delete_source_files=Fal
                     print(f"Deleted shader source file '{file_path}'")
 
 
+def cook_meshes(asset_folder, cooker_path, force=False):
+    print(f"Cooking meshes with cooker '{cooker_path}' in directory '{asset_folder}'")
+    asset_folder = Path(asset_folder)
+    if not asset_folder.exists() or not asset_folder.is_dir():
+        print(f"Directory '{asset_folder}' doesn't exist or is not a directory")
+        return
+
+    cooker_path = Path(cooker_path)
+    if not cooker_path.exists() or not cooker_path.is_file():
+        print(f"Mesh Cooker EXE '{cooker_path}' doesn't exist or is not an executable")
+        return
+
+    command = [cooker_path, asset_folder]
+    if force:
+        command.append('--force')
+    result = subprocess.run(command)
+    if result.returncode != 0:
+        print(f"Mesh cooking failed with return code {result.returncode}, source meshes will be loaded instead")
+        return
+
+    print(f"Successfully cooked meshes in '{asset_folder}'")
+
+
 def event_copy_folder(args):
     copy_folder(args.src, args.dst, args.ignoredFiles, args.deleteExistingTarget)
 
 def event_compile_shaders(args):
     compile_shaders(args.srcFolder, args.compilerPath, args.deleteShaderSources)
 
+def event_cook_meshes(args):
+    cook_meshes(args.srcFolder, args.cookerPath, args.force)
+
 def main():
     parser = argparse.ArgumentParser()
 
@@ -92,6 +118,14 @@ def main():
                              help='Whether to delete the original shader source files after compilation')
     compile_parser.set_defaults(func=event_compile_shaders)
 
+    # MESHCOOK command
+    cook_parser = subparsers.add_parser('MESHCOOK', help='Cook source meshes into the binary mesh format')
+    cook_parser.add_argument('srcFolder', help='Folder to cook meshes in recursively')
+    cook_parser.add_argument('cookerPath', help='Path and name of the mesh cooker executable')
+    cook_parser.add_argument('--force', action=argparse.BooleanOptionalAction, default=False,
+                             help='Whether to cook meshes even if their cooked files are up to date')
+    cook_parser.set_defaults(func=event_cook_meshes)
+
     args = parser.parse_args()
     args.func(args)
 
@@ -7,6 +7,13 @@ namespace Prism::Assets
     {
     public:
         explicit Asset(const std::string& name);
+        virtual ~Asset() = default;
+
+        // Approximate CPU memory held by the asset's payload in bytes, used for the per type memory budgets
+        [[nodiscard]] virtual size_t getMemoryUsage() const
+        {
+            return 0;
+        }
 
         [[nodiscard]] std::string getName() const
         {
@@ -0,0 +1,248 @@
+﻿#include "AssetCache.hpp"
+
+#include <ranges>
+
+#include "../Utilities/Hash.hpp"
+
+namespace
+{
+    // Feeds the normalized form of path to consumer character by character without allocating
+    template <typename F>
+    void forEachNormalizedChar(const std::string_view path, F&& consumer)
+    {
+        char previous = '/';
+        bool atSegmentStart = true;
+        size_t i = 0;
+        while (i < path.size())
+        {
+            const char c = path[i] == '\\' ? '/' : path[i];
+            if (atSegmentStart)
+            {
+                // Skip "./" segments and duplicate separators, but keep a leading separator of absolute paths
+                if (c == '/' && (previous == '/' && i != 0))
+                {
+                    ++i;
+                    continue;
+                }
+                const char next = i + 1 < path.size() ? (path[i + 1] == '\\' ? '/' : path[i + 1]) : '/';
+                if (c == '.' && next == '/')
+                {
+                    i += 2;
+                    continue;
+                }
+            }
+            consumer(c);
+            atSegmentStart = c == '/';
+            previous = c;
+            ++i;
+        }
+    }
+}
+
+Prism::Assets::AssetCache::Key Prism::Assets::AssetCache::makeKey(const uint32_t typeId, const std::string_view name)
+{
+    uint64_t hash = Utility::Hash::fnv1aOffsetBasis;
+    forEachNormalizedChar(name, [&hash](const char c)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= Utility::Hash::fnv1aPrime;
+    });
+    return {typeId, hash};
+}
+
+std::string Prism::Assets::AssetCache::normalizePath(const std::string_view path)
+{
+    std::string normalized;
+    normalized.reserve(path.size());
+    forEachNormalizedChar(path, [&normalized](const char c)
+    {
+        normalized.push_back(c);
+    });
+    return normalized;
+}
+
+bool Prism::Assets::AssetCache::equalsNormalized(const std::string_view normalizedName, const std::string_view name)
+{
+    size_t index = 0;
+    bool equal = true;
+    forEachNormalizedChar(name, [&](const char c)
+    {
+        equal = equal && index < normalizedName.size() && normalizedName[index] == c;
+        ++index;
+    });
+    return equal && index == normalizedName.size();
+}
+
+std::shared_ptr<Prism::Assets::Asset> Prism::Assets::AssetCache::find(const uint32_t typeId,
+                                                                      const std::string_view name) const
+{
+    const auto key = makeKey(typeId, name);
+    const auto& shard = getShard(key);
+    std::shared_lock lock(shard.mutex);
+    const auto result = shard.entries.find(key);
+    if (result == shard.entries.end())
+    {
+        return nullptr;
+    }
+    for (const auto& entry : result->second)
+    {
+        if (equalsNormalized(entry->normalizedName, name))
+        {
+            // Only write if the tick changed to not bounce the cache line between readers within the same frame
+            const auto tick = currentTick.load(std::memory_order_relaxed);
+            if (entry->lastAccessTick.load(std::memory_order_relaxed) != tick)
+            {
+                entry->lastAccessTick.store(tick, std::memory_order_relaxed);
+            }
+            return entry->asset;
+        }
+    }
+    return nullptr;
+}
+
+void Prism::Assets::AssetCache::modify(const uint32_t typeId, const std::string_view name,
+                                       const std::function<void(Entry& entry, bool created)>& function)
+{
+    const auto key = makeKey(typeId, name);
+    auto& shard = getShard(key);
+    std::unique_lock lock(shard.mutex);
+    auto& entries = shard.entries[key];
+    for (const auto& entry : entries)
+    {
+        if (equalsNormalized(entry->normalizedName, name))
+        {
+            function(*entry, false);
+            return;
+        }
+    }
+    const auto& entry = entries.emplace_back(std::make_unique<Entry>());
+    entry->normalizedName = normalizePath(name);
+    entry->lastAccessTick = currentTick.load(std::memory_order_relaxed);
+    function(*entry, true);
+}
+
+void Prism::Assets::AssetCache::modifyExisting(const uint32_t typeId, const std::string_view name,
+                                               const std::function<void(Entry* entry)>& function)
+{
+    const auto key = makeKey(typeId, name);
+    auto& shard = getShard(key);
+    std::unique_lock lock(shard.mutex);
+    const auto result = shard.entries.find(key);
+    if (result != shard.entries.end())
+    {
+        for (auto entryIter = result->second.begin(); entryIter != result->second.end(); ++entryIter)
+        {
+            if (equalsNormalized((*entryIter)->normalizedName, name))
+            {
+                function(entryIter->get());
+                // Entries that neither hold nor load an asset are dropped within the same lock
+                if (!(*entryIter)->asset && !(*entryIter)->isLoading())
+                {
+                    result->second.erase(entryIter);
+                    if (result->second.empty())
+                    {
+                        shard.entries.erase(result);
+                    }
+                }
+                return;
+            }
+        }
+    }
+    function(nullptr);
+}
+
+void Prism::Assets::AssetCache::erase(const uint32_t typeId, const std::string_view name)
+{
+    const auto key = makeKey(typeId, name);
+    auto& shard = getShard(key);
+    std::unique_lock lock(shard.mutex);
+    const auto result = shard.entries.find(key);
+    if (result == shard.entries.end())
+    {
+        return;
+    }
+    std::erase_if(result->second, [name](const std::unique_ptr<Entry>& entry)
+    {
+        return equalsNormalized(entry->normalizedName, name);
+    });
+    if (result->second.empty())
+    {
+        shard.entries.erase(result);
+    }
+}
+
+size_t Prism::Assets::AssetCache::eraseIfUnreferenced(const uint32_t typeId, const std::string_view name)
+{
+    const auto key = makeKey(typeId, name);
+    auto& shard = getShard(key);
+    // New references are only handed out under the shard lock, so the use count can't grow while we hold it
+    std::unique_lock lock(shard.mutex);
+    const auto result = shard.entries.find(key);
+    if (result == shard.entries.end())
+    {
+        return 0;
+    }
+    for (auto entryIter = result->second.begin(); entryIter != result->second.end(); ++entryIter)
+    {
+        const auto& entry = *entryIter;
+        if (!equalsNormalized(entry->normalizedName, name))
+        {
+            continue;
+        }
+        if (!entry->isUnreferenced() || entry->isLoading())
+        {
+            return 0;
+        }
+        const auto freedMemory = entry->asset->getMemoryUsage();
+        result->second.erase(entryIter);
+        if (result->second.empty())
+        {
+            shard.entries.erase(result);
+        }
+        return freedMemory;
+    }
+    return 0;
+}
+
+void Prism::Assets::AssetCache::forEach(const uint32_t typeId, const std::function<void(const Entry& entry)>& function) const
+{
+    for (const auto& shard : shards)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [key, entries] : shard.entries)
+        {
+            if (key.typeId != typeId)
+            {
+                continue;
+            }
+            for (const auto& entry : entries)
+            {
+                function(*entry);
+            }
+        }
+    }
+}
+
+void Prism::Assets::AssetCache::forEach(const std::function<void(const Entry& entry)>& function) const
+{
+    for (const auto& shard : shards)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& entries : shard.entries | std::views::values)
+        {
+            for (const auto& entry : entries)
+            {
+                function(*entry);
+            }
+        }
+    }
+}
+
+void Prism::Assets::AssetCache::clear()
+{
+    for (auto& shard : shards)
+    {
+        std::unique_lock lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
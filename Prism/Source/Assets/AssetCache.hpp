@@ -0,0 +1,140 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Asset.hpp"
+
+namespace Prism::Assets
+{
+    /*
+     * Concurrent cache of assets keyed by asset type and the hash of the normalized asset path.
+     * Entries are spread over independently locked shards, lookups only take a shared lock on a single shard and
+     * neither allocate nor copy the requested name.
+     */
+    class AssetCache
+    {
+    public:
+        struct Key
+        {
+            uint32_t typeId;
+            uint64_t pathHash;
+
+            bool operator==(const Key& other) const = default;
+        };
+
+        struct Entry
+        {
+            // Kept for collision checks, two different paths may share a hash
+            std::string normalizedName;
+            std::shared_ptr<Asset> asset;
+            // Tick of the last lookup, used to evict the least recently used assets first
+            std::atomic_uint64_t lastAccessTick = 0;
+            // Valid while the asset is being loaded
+            std::shared_future<std::shared_ptr<Asset>> pendingFuture;
+            std::vector<std::function<void(const std::shared_ptr<Asset>&)>> pendingCallbacks;
+
+            // Only the cache itself references the asset, therefore it can be evicted
+            [[nodiscard]] bool isUnreferenced() const
+            {
+                return asset && asset.use_count() == 1;
+            }
+
+            [[nodiscard]] bool isLoading() const
+            {
+                return pendingFuture.valid();
+            }
+        };
+
+        AssetCache() = default;
+        AssetCache(const AssetCache& other) = delete;
+        AssetCache(AssetCache&& other) noexcept = delete;
+        AssetCache& operator=(const AssetCache& other) = delete;
+        AssetCache& operator=(AssetCache&& other) noexcept = delete;
+        ~AssetCache() = default;
+
+        template <typename T>
+        [[nodiscard]] static uint32_t getTypeId()
+        {
+            static const uint32_t id = lastTypeId++;
+            return id;
+        }
+
+        [[nodiscard]] static Key makeKey(uint32_t typeId, std::string_view name);
+
+        // Unifies path separators and removes redundant "./" segments and duplicate separators
+        [[nodiscard]] static std::string normalizePath(std::string_view path);
+
+        // Returns the loaded asset or nullptr if it isn't loaded (yet), takes a shared lock only
+        [[nodiscard]] std::shared_ptr<Asset> find(uint32_t typeId, std::string_view name) const;
+
+        // Runs function with the entry of name under an exclusive shard lock, the entry is created if it doesn't exist
+        void modify(uint32_t typeId, std::string_view name, const std::function<void(Entry& entry, bool created)>& function);
+
+        /*
+         * Runs function with the entry of name under an exclusive shard lock, function receives nullptr if there is none.
+         * The entry is removed afterwards if it holds no asset and isn't loading anymore.
+         */
+        void modifyExisting(uint32_t typeId, std::string_view name, const std::function<void(Entry* entry)>& function);
+
+        void erase(uint32_t typeId, std::string_view name);
+
+        // Removes the entry if its asset is not referenced outside the cache, returns the freed memory usage
+        size_t eraseIfUnreferenced(uint32_t typeId, std::string_view name);
+
+        // Advances the tick stamped onto looked up entries, called once per frame
+        void advanceTick()
+        {
+            currentTick.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Visits all entries of a type, shards are locked shared one after another
+        void forEach(uint32_t typeId, const std::function<void(const Entry& entry)>& function) const;
+
+        // Visits all entries of all types
+        void forEach(const std::function<void(const Entry& entry)>& function) const;
+
+        void clear();
+
+    private:
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const
+            {
+                return static_cast<size_t>(key.pathHash ^ (static_cast<uint64_t>(key.typeId) * 0x9E3779B97F4A7C15ull));
+            }
+        };
+
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+            // Collisions of the full key are rare, therefore a small vector per key suffices
+            std::unordered_map<Key, std::vector<std::unique_ptr<Entry>>, KeyHash> entries;
+        };
+
+        inline constexpr static size_t shardCount = 32;
+
+        [[nodiscard]] Shard& getShard(const Key& key)
+        {
+            return shards[KeyHash()(key) % shardCount];
+        }
+
+        [[nodiscard]] const Shard& getShard(const Key& key) const
+        {
+            return shards[KeyHash()(key) % shardCount];
+        }
+
+        [[nodiscard]] static bool equalsNormalized(std::string_view normalizedName, std::string_view name);
+
+        inline static std::atomic_uint32_t lastTypeId = 0;
+        std::atomic_uint64_t currentTick = 0;
+        std::array<Shard, shardCount> shards;
+    };
+}
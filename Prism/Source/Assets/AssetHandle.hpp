@@ -0,0 +1,69 @@
+﻿#pragma once
+#include <memory>
+#include <type_traits>
+
+namespace Prism::Assets
+{
+    /*
+     * Shared ownership of a loaded asset. The AssetManager only evicts assets that are not referenced by any handle,
+     * requesting an evicted asset again transparently reloads it.
+     */
+    template <typename T>
+    class AssetHandle
+    {
+    public:
+        AssetHandle() = default;
+
+        AssetHandle(std::nullptr_t)
+        {
+        }
+
+        explicit AssetHandle(std::shared_ptr<T> asset) : asset(std::move(asset))
+        {
+        }
+
+        // Allows passing handles of derived asset types where a base type is expected
+        template <typename U> requires std::is_base_of_v<T, U> && (!std::is_same_v<T, U>)
+        AssetHandle(const AssetHandle<U>& other) : asset(other.getShared())
+        {
+        }
+
+        [[nodiscard]] T* get() const
+        {
+            return asset.get();
+        }
+
+        T* operator->() const
+        {
+            return asset.get();
+        }
+
+        T& operator*() const
+        {
+            return *asset;
+        }
+
+        explicit operator bool() const
+        {
+            return asset != nullptr;
+        }
+
+        bool operator==(const AssetHandle& other) const
+        {
+            return asset == other.asset;
+        }
+
+        void reset()
+        {
+            asset.reset();
+        }
+
+        [[nodiscard]] const std::shared_ptr<T>& getShared() const
+        {
+            return asset;
+        }
+
+    private:
+        std::shared_ptr<T> asset;
+    };
+}
@@ -0,0 +1,227 @@
+﻿#include "AssetManager.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+#include "ShaderAsset.hpp"
+#include "StaticMeshAsset.hpp"
+#include "TextureAsset.hpp"
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/ServiceLocator.hpp"
+
+namespace
+{
+    constexpr size_t bytesPerMiB = 1024 * 1024;
+
+    Prism::Utility::ConsoleVariable<uint32_t> cvarTextureBudget(
+        "assets.textureBudgetMiB", 512, 0, 65536,
+        "CPU memory budget of cached textures in MiB, 0 disables the limit");
+    Prism::Utility::ConsoleVariable<uint32_t> cvarStaticMeshBudget(
+        "assets.staticMeshBudgetMiB", 256, 0, 65536,
+        "CPU memory budget of cached static meshes in MiB, 0 disables the limit");
+    Prism::Utility::ConsoleVariable<uint32_t> cvarShaderBudget(
+        "assets.shaderBudgetMiB", 16, 0, 65536,
+        "CPU memory budget of cached shaders in MiB, 0 disables the limit");
+}
+
+void Prism::Assets::AssetManager::initialize()
+{
+    jobSystem = Utility::ServiceLocator::getService<Utility::JobSystem>();
+    applyMemoryBudgetSettings();
+}
+
+void Prism::Assets::AssetManager::declareDependencies(Utility::ServiceDependencies& dependencies)
+{
+    dependencies.add<Utility::JobSystem>();
+}
+
+void Prism::Assets::AssetManager::dispatchCompletedRequests()
+{
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::scoped_lock lock(completedCallbacksMutex);
+        callbacks.swap(completedCallbacks);
+    }
+    for (const auto& callback : callbacks)
+    {
+        callback();
+    }
+    applyMemoryBudgetSettings();
+    // Handles released during the frame make their assets evictable, so the budgets are enforced every frame
+    trimToBudget();
+    cache.advanceTick();
+}
+
+std::vector<Prism::Assets::AssetTypeMemoryUsage> Prism::Assets::AssetManager::getMemoryUsagePerType() const
+{
+    std::vector<uint32_t> typeIds;
+    {
+        std::scoped_lock lock(typeInfosMutex);
+        for (const auto typeId : typeInfos | std::views::keys)
+        {
+            typeIds.emplace_back(typeId);
+        }
+    }
+    std::vector<AssetTypeMemoryUsage> usages;
+    usages.reserve(typeIds.size());
+    for (const auto typeId : typeIds)
+    {
+        usages.emplace_back(getTypeMemoryUsage(typeId));
+    }
+    return usages;
+}
+
+void Prism::Assets::AssetManager::trimToBudget()
+{
+    std::vector<uint32_t> typeIds;
+    {
+        std::scoped_lock lock(typeInfosMutex);
+        for (const auto& [typeId, typeInfo] : typeInfos)
+        {
+            if (typeInfo.memoryBudget > 0)
+            {
+                typeIds.emplace_back(typeId);
+            }
+        }
+    }
+    for (const auto typeId : typeIds)
+    {
+        enforceMemoryBudget(typeId);
+    }
+}
+
+Prism::Assets::AssetTypeMemoryUsage Prism::Assets::AssetManager::getTypeMemoryUsage(const uint32_t typeId) const
+{
+    AssetTypeMemoryUsage usage;
+    {
+        std::scoped_lock lock(typeInfosMutex);
+        const auto typeInfo = typeInfos.find(typeId);
+        if (typeInfo != typeInfos.end())
+        {
+            usage.typeName = typeInfo->second.typeName;
+            usage.memoryBudget = typeInfo->second.memoryBudget;
+        }
+    }
+    cache.forEach(typeId, [&usage](const AssetCache::Entry& entry)
+    {
+        if (!entry.asset)
+        {
+            return;
+        }
+        ++usage.assetCount;
+        if (entry.isUnreferenced())
+        {
+            ++usage.unreferencedAssetCount;
+        }
+        usage.memoryUsage += entry.asset->getMemoryUsage();
+    });
+    return usage;
+}
+
+void Prism::Assets::AssetManager::enforceMemoryBudget(const uint32_t typeId)
+{
+    struct EvictionCandidate
+    {
+        std::string name;
+        uint64_t lastAccessTick;
+    };
+
+    size_t budget;
+    std::string typeName;
+    {
+        std::scoped_lock lock(typeInfosMutex);
+        const auto typeInfo = typeInfos.find(typeId);
+        if (typeInfo == typeInfos.end() || typeInfo->second.memoryBudget == 0)
+        {
+            return;
+        }
+        budget = typeInfo->second.memoryBudget;
+        typeName = typeInfo->second.typeName;
+    }
+
+    size_t memoryUsage = 0;
+    std::vector<EvictionCandidate> candidates;
+    cache.forEach(typeId, [&](const AssetCache::Entry& entry)
+    {
+        if (!entry.asset)
+        {
+            return;
+        }
+        memoryUsage += entry.asset->getMemoryUsage();
+        if (entry.isUnreferenced())
+        {
+            candidates.push_back({entry.normalizedName, entry.lastAccessTick.load(std::memory_order_relaxed)});
+        }
+    });
+    if (memoryUsage <= budget)
+    {
+        return;
+    }
+
+    std::ranges::sort(candidates, {}, &EvictionCandidate::lastAccessTick);
+    size_t evictedCount = 0;
+    for (const auto& candidate : candidates)
+    {
+        if (memoryUsage <= budget)
+        {
+            break;
+        }
+        // The asset may have been referenced again since we collected the candidates, the cache checks that again
+        const auto freedMemory = cache.eraseIfUnreferenced(typeId, candidate.name);
+        if (freedMemory > 0)
+        {
+            memoryUsage -= std::min(freedMemory, memoryUsage);
+            ++evictedCount;
+        }
+    }
+    if (evictedCount > 0)
+    {
+        LOG_DEBUG("Evicted {} assets of type {}, memory usage is now {} of {} bytes", evictedCount, typeName,
+                  memoryUsage, budget);
+    }
+}
+
+void Prism::Assets::AssetManager::applyMemoryBudgetSettings()
+{
+    applyMemoryBudgetSetting<TextureAsset>(cvarTextureBudget.get(), appliedTextureBudgetMiB);
+    applyMemoryBudgetSetting<StaticMeshAsset>(cvarStaticMeshBudget.get(), appliedStaticMeshBudgetMiB);
+    applyMemoryBudgetSetting<ShaderAsset>(cvarShaderBudget.get(), appliedShaderBudgetMiB);
+}
+
+template <Prism::Assets::SubtypeOfAsset T>
+void Prism::Assets::AssetManager::applyMemoryBudgetSetting(const uint32_t budgetMiB, uint32_t& appliedBudgetMiB)
+{
+    // Only overwrite on change, so budgets set through setMemoryBudget stay until the console variable is edited
+    if (budgetMiB == appliedBudgetMiB)
+    {
+        return;
+    }
+    appliedBudgetMiB = budgetMiB;
+    std::scoped_lock lock(typeInfosMutex);
+    auto& typeInfo = typeInfos[AssetCache::getTypeId<T>()];
+    if (typeInfo.typeName.empty())
+    {
+        typeInfo.typeName = typeid(T).name();
+    }
+    typeInfo.memoryBudget = static_cast<size_t>(budgetMiB) * bytesPerMiB;
+}
+
+void Prism::Assets::AssetManager::deInitialize()
+{
+    // Loads still in flight reference this manager, wait for them before the services are torn down
+    std::vector<std::shared_future<std::shared_ptr<Asset>>> inFlight;
+    cache.forEach([&inFlight](const AssetCache::Entry& entry)
+    {
+        if (entry.isLoading())
+        {
+            inFlight.emplace_back(entry.pendingFuture);
+        }
+    });
+    for (const auto& future : inFlight)
+    {
+        future.wait();
+    }
+
+    std::scoped_lock lock(completedCallbacksMutex);
+    completedCallbacks.clear();
+}
@@ -1,12 +1,20 @@
 #pragma once
+#include <functional>
+#include <future>
+#include <mutex>
 #include <vector>
 #include <map>
 
 #include "Asset.hpp"
+#include "AssetCache.hpp"
+#include "AssetHandle.hpp"
 #include "IAssetFactory.hpp"
 #include "../Utilities/IService.hpp"
+#include "../Utilities/JobSystem.hpp"
 #include "../Utilities/TypeMap.hpp"
 #include "../Utilities/Globals.hpp"
+#include "../Utilities/Profiling/AllocationTracker.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
 
 namespace Prism::Assets
 {
@@ -16,106 +24,304 @@ namespace Prism::Assets
     template <typename T>
     concept ImplementsIAssetFactory = std::is_base_of_v<IAssetFactory, T> && !std::is_abstract_v<T>;
 
+    // Handle to an asset that is possibly still loading, copies share the same underlying load
+    template <SubtypeOfAsset T>
+    class AssetRequest
+    {
+    public:
+        AssetRequest() = default;
+
+        AssetRequest(std::string name, std::shared_future<std::shared_ptr<Asset>> future)
+            : name(std::move(name)), future(std::move(future))
+        {
+        }
+
+        [[nodiscard]] bool isValid() const
+        {
+            return future.valid();
+        }
+
+        [[nodiscard]] bool isReady() const
+        {
+            return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        // Blocks until the asset is loaded, returns an empty handle if loading failed
+        [[nodiscard]] AssetHandle<T> get() const
+        {
+            if (!future.valid())
+            {
+                return AssetHandle<T>();
+            }
+            return AssetHandle<T>(std::static_pointer_cast<T>(future.get()));
+        }
+
+        [[nodiscard]] std::string getName() const
+        {
+            return name;
+        }
+
+    private:
+        std::string name;
+        std::shared_future<std::shared_ptr<Asset>> future;
+    };
+
+    struct AssetTypeMemoryUsage
+    {
+        std::string typeName;
+        size_t assetCount = 0;
+        size_t unreferencedAssetCount = 0;
+        size_t memoryUsage = 0;
+        // 0 means unlimited
+        size_t memoryBudget = 0;
+    };
+
     class AssetManager final : public Utility::IService
     {
     public:
         ~AssetManager() override = default;
 
+        // Loads the asset on the calling thread if it isn't cached yet, waits for it if it is currently being loaded
         template <SubtypeOfAsset T>
-        RawPtr<T> getAsset(const std::string& name)
+        AssetHandle<T> getAsset(const std::string& name)
         {
-            auto typeResult = assets.find<T>();
-            RawPtr<std::vector<std::unique_ptr<Asset>>> assetList;
-
-            // Create asset vector if it doesn't exist, otherwise retrieve it
-            if (typeResult == assets.end())
+            // Fast path, cached assets are found without allocating or taking an exclusive lock
+            if (auto cachedAsset = cache.find(AssetCache::getTypeId<T>(), name))
             {
-                std::vector<std::unique_ptr<Asset>> assetsOfType;
-                assets.put<T>(std::move(assetsOfType));
-                assetList = &assets.find<T>()->second;
+                return AssetHandle<T>(std::static_pointer_cast<T>(std::move(cachedAsset)));
             }
-            else
+            auto [future, promise] = findOrAddRequest<T>(name, {});
+            if (promise)
             {
-                assetList = &typeResult->second;
+                completeLoad<T>(name, *promise);
             }
+            return AssetHandle<T>(std::static_pointer_cast<T>(future.get()));
+        }
 
-            // Search for asset of name
-            auto result = std::find_if(assetList->begin(), assetList->end(), [&name](auto& a)
+        /*
+         * Schedules loading the asset on the job system and returns immediately.
+         * Requests for an asset that is already loading share the same load, onCompleted is always invoked on the
+         * main thread from dispatchCompletedRequests, with an empty handle if the asset failed to load.
+         */
+        template <SubtypeOfAsset T>
+        AssetRequest<T> requestAsset(const std::string& name, std::function<void(AssetHandle<T>)> onCompleted = {})
+        {
+            std::function<void(const std::shared_ptr<Asset>&)> callback;
+            if (onCompleted)
             {
-                return a->getName() == name;
-            });
-
-            // If asset doesn't exist, load and cache it
-            if (result == assetList->end())
+                callback = [onCompleted = std::move(onCompleted)](const std::shared_ptr<Asset>& asset)
+                {
+                    onCompleted(AssetHandle<T>(std::static_pointer_cast<T>(asset)));
+                };
+            }
+            auto [future, promise] = findOrAddRequest<T>(name, std::move(callback));
+            if (promise)
             {
-                auto asset = loadAsset<T>(name);
-                if (!asset)
+                jobSystem->enqueue([this, name, promise]
                 {
-                    return RawPtr<T>();
-                }
-                // Cache object pointer here as we move the unique one afterwards!
-                auto objAssetPtr = RawPtr<T>(static_cast<T*>(asset.get()));
-                assetList->emplace_back(std::move(asset));
-                return objAssetPtr;
+                    completeLoad<T>(name, *promise);
+                });
             }
-
-            return RawPtr<T>(static_cast<T*>(result->get()));
+            return AssetRequest<T>(name, std::move(future));
         }
 
         template <SubtypeOfAsset T>
-        std::vector<RawPtr<T>> getAssets()
+        std::vector<AssetHandle<T>> getAssets()
         {
-            auto assetIter = assets.find<T>();
-            if (assetIter != assets.end())
+            std::vector<AssetHandle<T>> results;
+            cache.forEach(AssetCache::getTypeId<T>(), [&results](const AssetCache::Entry& entry)
             {
-                std::vector<RawPtr<T>> results;
-                results.reserve(assetIter->second.size());
-                for (auto& asset : assetIter->second)
+                if (entry.asset)
                 {
-                    results.emplace_back(RawPtr<T>(static_cast<T*>(asset.get())));
+                    results.emplace_back(std::static_pointer_cast<T>(entry.asset));
                 }
-                return results;
-            }
-
-            return std::vector<RawPtr<T>>();
+            });
+            return results;
         }
 
+        // Runs the completion callbacks of finished requests, must be called once per frame from the main thread
+        void dispatchCompletedRequests();
+
         template <ImplementsIAssetFactory T, SubtypeOfAsset U>
         void registerAssetFactory()
         {
             assetFactories.put<U>(std::make_unique<T>());
+            std::scoped_lock lock(typeInfosMutex);
+            typeInfos[AssetCache::getTypeId<U>()].typeName = typeid(U).name();
+        }
+
+        /*
+         * Limits the CPU memory of all cached assets of type T, 0 disables the limit.
+         * When exceeded, the least recently used assets that are not referenced by any handle are evicted.
+         */
+        template <SubtypeOfAsset T>
+        void setMemoryBudget(const size_t budgetBytes)
+        {
+            {
+                std::scoped_lock lock(typeInfosMutex);
+                typeInfos[AssetCache::getTypeId<T>()].memoryBudget = budgetBytes;
+            }
+            enforceMemoryBudget(AssetCache::getTypeId<T>());
         }
 
-        void initialize() override
+        template <SubtypeOfAsset T>
+        [[nodiscard]] size_t getMemoryUsage() const
         {
+            return getTypeMemoryUsage(AssetCache::getTypeId<T>()).memoryUsage;
         }
 
-        void initializeDeferred() override
+        [[nodiscard]] std::vector<AssetTypeMemoryUsage> getMemoryUsagePerType() const;
+
+        /*
+         * Drops the cached asset right away if no handle references it anymore, returns whether it was evicted.
+         * Used for assets that are only needed once, like textures whose pixels were uploaded to the GPU.
+         */
+        template <SubtypeOfAsset T>
+        bool evictIfUnreferenced(const std::string& name)
         {
+            return cache.eraseIfUnreferenced(AssetCache::getTypeId<T>(), name) > 0;
         }
 
-        void deInitialize() override
+        // Evicts unreferenced assets of all types that exceed their budget, runs once per frame
+        void trimToBudget();
+
+        void initialize() override;
+
+        void initializeDeferred() override
         {
         }
 
+        void deInitialize() override;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override;
+
         std::string getFullName() override
         {
             return "Prism::Assets::AssetManager";
         }
 
     private:
-        TypeMap<std::vector<std::unique_ptr<Asset>>> assets;
+        struct RequestResult
+        {
+            std::shared_future<std::shared_ptr<Asset>> future;
+            // Only set for the request that has to perform the load
+            std::shared_ptr<std::promise<std::shared_ptr<Asset>>> promise;
+        };
+
+        struct AssetTypeInfo
+        {
+            std::string typeName;
+            size_t memoryBudget = 0;
+        };
+
+        RawPtr<Utility::JobSystem> jobSystem;
+        AssetCache cache;
         TypeMap<std::unique_ptr<IAssetFactory>> assetFactories;
+        mutable std::mutex typeInfosMutex;
+        std::map<uint32_t, AssetTypeInfo> typeInfos;
+        std::mutex completedCallbacksMutex;
+        std::vector<std::function<void()>> completedCallbacks;
+        // Last applied values of the assets.*BudgetMiB console variables, budgets are only overwritten when they change
+        uint32_t appliedTextureBudgetMiB = UINT32_MAX;
+        uint32_t appliedStaticMeshBudgetMiB = UINT32_MAX;
+        uint32_t appliedShaderBudgetMiB = UINT32_MAX;
+
+        [[nodiscard]] AssetTypeMemoryUsage getTypeMemoryUsage(uint32_t typeId) const;
+        void enforceMemoryBudget(uint32_t typeId);
+        void applyMemoryBudgetSettings();
+
+        template <SubtypeOfAsset T>
+        void applyMemoryBudgetSetting(uint32_t budgetMiB, uint32_t& appliedBudgetMiB);
+
+        template <SubtypeOfAsset T>
+        RequestResult findOrAddRequest(const std::string& name, std::function<void(const std::shared_ptr<Asset>&)> callback)
+        {
+            RequestResult result;
+            cache.modify(AssetCache::getTypeId<T>(), name, [&](AssetCache::Entry& entry, bool)
+            {
+                if (entry.asset)
+                {
+                    if (callback)
+                    {
+                        queueCompletedCallback(std::move(callback), entry.asset);
+                    }
+                    std::promise<std::shared_ptr<Asset>> readyPromise;
+                    readyPromise.set_value(entry.asset);
+                    result.future = readyPromise.get_future().share();
+                    return;
+                }
+
+                // Join an in-flight load instead of loading the same asset twice
+                if (!entry.isLoading())
+                {
+                    result.promise = std::make_shared<std::promise<std::shared_ptr<Asset>>>();
+                    entry.pendingFuture = result.promise->get_future().share();
+                }
+                if (callback)
+                {
+                    entry.pendingCallbacks.emplace_back(std::move(callback));
+                }
+                result.future = entry.pendingFuture;
+            });
+            return result;
+        }
+
+        template <SubtypeOfAsset T>
+        void completeLoad(const std::string& name, std::promise<std::shared_ptr<Asset>>& promise)
+        {
+            std::shared_ptr<Asset> asset;
+            try
+            {
+                asset = loadAsset<T>(name);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Exception while loading asset {}: {}", name, e.what());
+            }
+
+            cache.modifyExisting(AssetCache::getTypeId<T>(), name, [&](AssetCache::Entry* entry)
+            {
+                if (!entry)
+                {
+                    return;
+                }
+                // Failed loads leave an empty entry behind that gets dropped, so they can be retried later
+                entry->asset = asset;
+                entry->pendingFuture = {};
+                for (auto& callback : entry->pendingCallbacks)
+                {
+                    queueCompletedCallback(std::move(callback), asset);
+                }
+                entry->pendingCallbacks.clear();
+            });
+            // The requester holds a reference through the future, so the new asset can't be evicted right away
+            promise.set_value(asset);
+            if (asset)
+            {
+                enforceMemoryBudget(AssetCache::getTypeId<T>());
+            }
+        }
+
+        void queueCompletedCallback(std::function<void(const std::shared_ptr<Asset>&)> callback,
+                                    std::shared_ptr<Asset> asset)
+        {
+            std::scoped_lock lock(completedCallbacksMutex);
+            completedCallbacks.emplace_back([callback = std::move(callback), asset = std::move(asset)]
+            {
+                callback(asset);
+            });
+        }
 
         template <SubtypeOfAsset T>
-        std::unique_ptr<T> loadAsset(const std::string& name)
+        std::shared_ptr<T> loadAsset(const std::string& name)
         {
+            PRISM_PROFILE_SCOPE("AssetManager::loadAsset");
+            PRISM_ALLOCATION_SCOPE("Assets");
             auto asset = assetFactories.find<T>()->second->loadAsset(name);
             if (!asset)
             {
                 return nullptr;
             }
-            return std::unique_ptr<T>(static_cast<T*>(asset.release()));
+            return std::shared_ptr<T>(static_cast<T*>(asset.release()));
         }
     };
 }
@@ -0,0 +1,46 @@
+﻿#include "AssetMemoryGuiComponent.hpp"
+
+#include "AssetManager.hpp"
+#include "../Rendering/Vulkan/ImGui/imgui.h"
+#include "../Utilities/ServiceLocator.hpp"
+
+void Prism::Assets::AssetMemoryGuiComponent::renderUi()
+{
+    const auto assetManager = Utility::ServiceLocator::getService<AssetManager>();
+    ImGui::Begin("Asset Memory");
+    if (ImGui::BeginTable("Table_AssetMemory", 5, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg))
+    {
+        for (const char* header : {"Type", "Assets", "Unreferenced", "MiB", "Budget MiB"})
+        {
+            ImGui::TableSetupColumn(header);
+        }
+        ImGui::TableHeadersRow();
+        for (const auto& usage : assetManager->getMemoryUsagePerType())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(usage.typeName.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", usage.assetCount);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", usage.unreferencedAssetCount);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(usage.memoryUsage) / (1024.0 * 1024.0));
+            ImGui::TableNextColumn();
+            if (usage.memoryBudget == 0)
+            {
+                ImGui::TextUnformatted("Unlimited");
+            }
+            else
+            {
+                ImGui::Text("%.2f", static_cast<double>(usage.memoryBudget) / (1024.0 * 1024.0));
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void Prism::Assets::AssetMemoryGuiComponent::shutdown()
+{
+}
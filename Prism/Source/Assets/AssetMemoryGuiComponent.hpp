@@ -0,0 +1,14 @@
+﻿#pragma once
+#include "../Rendering/Vulkan/ImGui/IImmediateModeGuiComponent.hpp"
+
+namespace Prism::Assets
+{
+    // CPU memory of the cached assets per type against the budgets set by the assets.*BudgetMiB console variables
+    class AssetMemoryGuiComponent : public Rendering::IImmediateModeGuiComponent
+    {
+    public:
+        AssetMemoryGuiComponent() = default;
+        void renderUi() override;
+        void shutdown() override;
+    };
+}
@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "../Rendering/Vertex.hpp"
+
+namespace Prism::Assets
+{
+    /*
+     * Binary layout of a cooked static mesh (.pmesh), written by the StaticMeshCooker and memory mapped at runtime:
+     * [CookedStaticMeshHeader][padding][vertex stream][padding][index stream]
+     * Both streams start on a streamAlignment boundary and can be handed to the GPU uploader as they are.
+     */
+    struct CookedStaticMeshHeader
+    {
+        std::array<char, 4> magic;
+        uint32_t version;
+        // FNV-1a hash of the source file contents the mesh was cooked from
+        uint64_t sourceHash;
+        uint32_t vertexStride;
+        uint32_t indexStride;
+        uint64_t vertexCount;
+        uint64_t indexCount;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        std::array<float, 3> boundsMin;
+        std::array<float, 3> boundsMax;
+    };
+
+    class CookedStaticMesh
+    {
+    public:
+        inline constexpr static std::array<char, 4> magic = {'P', 'M', 'S', 'H'};
+        // Bump whenever the header or the Vertex layout changes, stale files will then be recooked or ignored
+        inline constexpr static uint32_t version = 1;
+        inline constexpr static uint64_t streamAlignment = 64;
+        inline constexpr static std::string_view fileExtension = ".pmesh";
+
+        // Cooked meshes live next to their source file, e.g. Crate.obj -> Crate.pmesh
+        [[nodiscard]] static std::string getCookedFileName(const std::string& sourceFileName)
+        {
+            return std::filesystem::path(sourceFileName).replace_extension(fileExtension).generic_string();
+        }
+
+        [[nodiscard]] static bool isCookedFileName(const std::string& fileName)
+        {
+            return std::filesystem::path(fileName).extension() == fileExtension;
+        }
+
+        [[nodiscard]] static constexpr uint64_t alignOffset(const uint64_t offset)
+        {
+            return (offset + streamAlignment - 1) & ~(streamAlignment - 1);
+        }
+    };
+
+    static_assert(sizeof(CookedStaticMeshHeader) == 80, "CookedStaticMeshHeader layout changed, bump the version!");
+    static_assert(std::is_trivially_copyable_v<CookedStaticMeshHeader>);
+    static_assert(std::is_trivially_copyable_v<Rendering::Vertex>);
+    static_assert(sizeof(Rendering::Vertex) == 44, "Vertex layout changed, bump the cooked mesh version!");
+}
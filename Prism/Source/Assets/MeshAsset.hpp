@@ -1,7 +1,9 @@
 ﻿#pragma once
 
+#include <span>
 #include <vector>
 #include "../Rendering/Vertex.hpp"
+#include "../Utilities/MappedFile.hpp"
 
 #include "Asset.hpp"
 
@@ -12,22 +14,83 @@ namespace Prism::Assets
     public:
         explicit MeshAsset(const std::string& name, std::vector<Rendering::Vertex> vertices,
                            std::vector<uint32_t> indices)
-            : Asset(name), vertices(std::move(vertices)), indices(std::move(indices))
+            : Asset(name), vertexStorage(std::move(vertices)), indexStorage(std::move(indices)),
+              vertices(vertexStorage), indices(indexStorage)
         {
+            calculateBounds();
         }
 
-        [[nodiscard]] std::vector<Rendering::Vertex>& getVertices()
+        // Streams point directly into the mapped file, which is kept alive for the lifetime of the asset
+        explicit MeshAsset(const std::string& name, std::unique_ptr<Utility::MappedFile> mappedFile,
+                           const std::span<const Rendering::Vertex> vertices, const std::span<const uint32_t> indices,
+                           const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+            : Asset(name), mappedFile(std::move(mappedFile)), vertices(vertices), indices(indices),
+              boundsMin(boundsMin), boundsMax(boundsMax)
+        {
+        }
+
+        MeshAsset(const MeshAsset& other) = delete;
+        MeshAsset(MeshAsset&& other) noexcept = delete;
+        MeshAsset& operator=(const MeshAsset& other) = delete;
+        MeshAsset& operator=(MeshAsset&& other) noexcept = delete;
+        ~MeshAsset() override = default;
+
+        [[nodiscard]] std::span<const Rendering::Vertex> getVertices() const
         {
             return vertices;
         }
 
-        [[nodiscard]] std::vector<uint32_t>& getIndices()
+        [[nodiscard]] std::span<const uint32_t> getIndices() const
         {
             return indices;
         }
 
+        [[nodiscard]] glm::vec3 getBoundsMin() const
+        {
+            return boundsMin;
+        }
+
+        [[nodiscard]] glm::vec3 getBoundsMax() const
+        {
+            return boundsMax;
+        }
+
+        [[nodiscard]] bool isMemoryMapped() const
+        {
+            return mappedFile != nullptr;
+        }
+
+        [[nodiscard]] size_t getMemoryUsage() const override
+        {
+            if (mappedFile)
+            {
+                return mappedFile->getSize();
+            }
+            return vertexStorage.capacity() * sizeof(Rendering::Vertex) + indexStorage.capacity() * sizeof(uint32_t);
+        }
+
     private:
-        std::vector<Rendering::Vertex> vertices;
-        std::vector<uint32_t> indices;
+        void calculateBounds()
+        {
+            if (vertices.empty())
+            {
+                return;
+            }
+            boundsMin = vertices.front().position;
+            boundsMax = vertices.front().position;
+            for (const auto& vertex : vertices)
+            {
+                boundsMin = glm::min(boundsMin, vertex.position);
+                boundsMax = glm::max(boundsMax, vertex.position);
+            }
+        }
+
+        std::unique_ptr<Utility::MappedFile> mappedFile;
+        std::vector<Rendering::Vertex> vertexStorage;
+        std::vector<uint32_t> indexStorage;
+        std::span<const Rendering::Vertex> vertices;
+        std::span<const uint32_t> indices;
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
     };
 }
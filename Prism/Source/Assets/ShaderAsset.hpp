@@ -16,6 +16,11 @@ namespace Prism::Assets
             return shader;
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override
+        {
+            return shader.capacity();
+        }
+
     private:
         std::vector<char> shader;
     };
@@ -11,5 +11,12 @@ namespace Prism::Assets
             : MeshAsset(name, std::move(vertices), std::move(indices))
         {
         }
+
+        StaticMeshAsset(const std::string& name, std::unique_ptr<Utility::MappedFile> mappedFile,
+                        const std::span<const Rendering::Vertex> vertices, const std::span<const uint32_t> indices,
+                        const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+            : MeshAsset(name, std::move(mappedFile), vertices, indices, boundsMin, boundsMax)
+        {
+        }
     };
 }
@@ -1,13 +1,88 @@
 ﻿#include "StaticMeshAssetFactory.hpp"
 
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+#include "CookedStaticMesh.hpp"
 #include "StaticMeshAsset.hpp"
+#include "StaticMeshCooker.hpp"
 #include "../Utilities/Globals.hpp"
+#include "../Utilities/Hash.hpp"
+#include "../Utilities/MappedFile.hpp"
 
 // Define LAST!
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "../Utilities/tiny_obj_loader.h"
 
+namespace
+{
+    struct ObjIndexHash
+    {
+        size_t operator()(const tinyobj::index_t& index) const
+        {
+            const std::array<int, 3> values = {index.vertex_index, index.normal_index, index.texcoord_index};
+            return static_cast<size_t>(Prism::Utility::Hash::fnv1a64(values.data(), sizeof(values)));
+        }
+    };
+
+    struct ObjIndexEquals
+    {
+        bool operator()(const tinyobj::index_t& lhs, const tinyobj::index_t& rhs) const
+        {
+            return lhs.vertex_index == rhs.vertex_index && lhs.normal_index == rhs.normal_index &&
+                lhs.texcoord_index == rhs.texcoord_index;
+        }
+    };
+
+    bool isCookedFileCurrent(const std::string& sourceFileName, const std::string& cookedFileName)
+    {
+        std::error_code errorCode;
+        if (!std::filesystem::exists(cookedFileName, errorCode))
+        {
+            return false;
+        }
+        // A cooked file without its source is fine, e.g. in a distribution that only ships cooked assets
+        if (!std::filesystem::exists(sourceFileName, errorCode))
+        {
+            return true;
+        }
+        // Compares the source hash stored by the cooker, mtimes change with checkouts and copies
+        return Prism::Assets::StaticMeshCooker::isUpToDate(sourceFileName, cookedFileName);
+    }
+}
+
 std::unique_ptr<Prism::Assets::Asset> Prism::Assets::StaticMeshAssetFactory::loadAsset(const std::string& fileName)
+{
+    if (CookedStaticMesh::isCookedFileName(fileName))
+    {
+        return loadCooked(fileName, fileName);
+    }
+
+    const auto cookedFileName = CookedStaticMesh::getCookedFileName(fileName);
+    if (isCookedFileCurrent(fileName, cookedFileName))
+    {
+        // Keep the requested name so lookups by the source file name keep hitting the cache
+        if (auto cookedAsset = loadCooked(cookedFileName, fileName))
+        {
+            return cookedAsset;
+        }
+        LOG_WARN("Failed to load cooked mesh: {}, falling back to source file: {}", cookedFileName, fileName);
+    }
+
+    std::vector<Rendering::Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!parseObj(fileName, vertices, indices))
+    {
+        return nullptr;
+    }
+
+    return std::make_unique<StaticMeshAsset>(fileName, std::move(vertices), std::move(indices));
+}
+
+bool Prism::Assets::StaticMeshAssetFactory::parseObj(const std::string& fileName,
+                                                     std::vector<Rendering::Vertex>& vertices,
+                                                     std::vector<uint32_t>& indices)
 {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
@@ -25,57 +100,134 @@ std::unique_ptr<Prism::Assets::Asset> Prism::Assets::StaticMeshAssetFactory::loa
         {
             LOG_ERROR("Errors while loading file: {}, errors: {}", fileName, errors);
         }
-        return nullptr;
+        return false;
     }
-    std::vector<Rendering::Vertex> vertices;
-    std::vector<uint32_t> indices;
+
+    if (attrib.normals.empty())
+    {
+        LOG_INFO("No normals in file: {}", fileName);
+    }
+    if (attrib.texcoords.empty())
+    {
+        LOG_INFO("No texcoords in file: {}", fileName);
+    }
+
+    size_t indexCount = 0;
+    for (const auto& shape : shapes)
+    {
+        indexCount += shape.mesh.indices.size();
+    }
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(indexCount);
+    indices.reserve(indexCount);
+
+    // OBJ indexes position, normal and texcoord separately, identical triples map to the same vertex
+    std::unordered_map<tinyobj::index_t, uint32_t, ObjIndexHash, ObjIndexEquals> uniqueVertices;
+    uniqueVertices.reserve(indexCount);
     for (const auto& shape : shapes)
     {
         for (const auto& index : shape.mesh.indices)
         {
-            Rendering::Vertex vertex{};
-
-            vertex.position = {
-                attrib.vertices[3 * index.vertex_index + 0],
-                attrib.vertices[3 * index.vertex_index + 1],
-                attrib.vertices[3 * index.vertex_index + 2]
-            };
-
-            if (!attrib.normals.empty())
+            const auto [iter, inserted] = uniqueVertices.try_emplace(index, static_cast<uint32_t>(vertices.size()));
+            if (inserted)
             {
-                vertex.normal = {
-                    attrib.normals[3 * index.normal_index + 0],
-                    attrib.normals[3 * index.normal_index + 1],
-                    attrib.normals[3 * index.normal_index + 2]
+                Rendering::Vertex vertex{};
+
+                vertex.position = {
+                    attrib.vertices[3 * index.vertex_index + 0],
+                    attrib.vertices[3 * index.vertex_index + 1],
+                    attrib.vertices[3 * index.vertex_index + 2]
                 };
-            }
-            else
-            {
-                vertex.normal = glm::vec3(0.0f, 0.0f, 0.0f);
-                LOG_INFO("No normals in file: {}", fileName);
-            }
 
+                if (!attrib.normals.empty())
+                {
+                    vertex.normal = {
+                        attrib.normals[3 * index.normal_index + 0],
+                        attrib.normals[3 * index.normal_index + 1],
+                        attrib.normals[3 * index.normal_index + 2]
+                    };
+                }
+                else
+                {
+                    vertex.normal = glm::vec3(0.0f, 0.0f, 0.0f);
+                }
 
-            if (!attrib.texcoords.empty())
-            {
-                vertex.texCoord = {
-                    attrib.texcoords[2 * index.texcoord_index + 0],
-                    1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
-                };
-            }
-            else
-            {
-                vertex.texCoord = glm::vec2(0.0f, 0.0f);
-                LOG_INFO("No texcoords in file: {}", fileName);
+                if (!attrib.texcoords.empty())
+                {
+                    vertex.texCoord = {
+                        attrib.texcoords[2 * index.texcoord_index + 0],
+                        1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
+                    };
+                }
+                else
+                {
+                    vertex.texCoord = glm::vec2(0.0f, 0.0f);
+                }
+
+                vertex.color = {1.0f, 1.0f, 1.0f};
+
+                vertices.emplace_back(vertex);
             }
+            indices.emplace_back(iter->second);
+        }
+    }
+    vertices.shrink_to_fit();
 
+    return true;
+}
 
-            vertex.color = {1.0f, 1.0f, 1.0f};
+std::unique_ptr<Prism::Assets::Asset> Prism::Assets::StaticMeshAssetFactory::loadCooked(
+    const std::string& cookedFileName, const std::string& assetName)
+{
+    auto mappedFile = Utility::MappedFile::open(cookedFileName);
+    if (!mappedFile)
+    {
+        return nullptr;
+    }
 
-            vertices.emplace_back(vertex);
-            indices.emplace_back(static_cast<uint32_t>(indices.size()));
-        }
+    const auto fileSize = mappedFile->getSize();
+    if (fileSize < sizeof(CookedStaticMeshHeader))
+    {
+        LOG_ERROR("Cooked mesh file is too small: {}", cookedFileName);
+        return nullptr;
+    }
+
+    CookedStaticMeshHeader header;
+    std::memcpy(&header, mappedFile->getData(), sizeof(header));
+    if (header.magic != CookedStaticMesh::magic || header.version != CookedStaticMesh::version)
+    {
+        LOG_ERROR("Cooked mesh file has an invalid magic or outdated version: {}, version: {}", cookedFileName,
+                  header.version);
+        return nullptr;
+    }
+    if (header.vertexStride != sizeof(Rendering::Vertex) || header.indexStride != sizeof(uint32_t))
+    {
+        LOG_ERROR("Cooked mesh file has mismatching strides: {}", cookedFileName);
+        return nullptr;
+    }
+
+    // Bounds checks are done via division to not overflow with corrupted counts
+    const auto streamFits = [fileSize](const uint64_t offset, const uint64_t count, const uint64_t stride)
+    {
+        return offset % CookedStaticMesh::streamAlignment == 0 && offset <= fileSize &&
+            count <= (fileSize - offset) / stride;
+    };
+    if (!streamFits(header.vertexOffset, header.vertexCount, header.vertexStride) ||
+        !streamFits(header.indexOffset, header.indexCount, header.indexStride))
+    {
+        LOG_ERROR("Cooked mesh file is truncated or corrupted: {}", cookedFileName);
+        return nullptr;
     }
 
-    return std::make_unique<StaticMeshAsset>(fileName, vertices, indices);
+    // The mapping is page aligned and the streams are aligned within the file, so they can be referenced in place
+    const std::span vertices(reinterpret_cast<const Rendering::Vertex*>(mappedFile->getData() + header.vertexOffset),
+                             static_cast<size_t>(header.vertexCount));
+    const std::span indices(reinterpret_cast<const uint32_t*>(mappedFile->getData() + header.indexOffset),
+                            static_cast<size_t>(header.indexCount));
+    const glm::vec3 boundsMin(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    const glm::vec3 boundsMax(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+
+    return std::make_unique<StaticMeshAsset>(assetName, std::move(mappedFile), vertices, indices, boundsMin,
+                                             boundsMax);
 }
@@ -1,11 +1,22 @@
 ﻿#pragma once
+#include <vector>
+
 #include "IAssetFactory.hpp"
+#include "../Rendering/Vertex.hpp"
 
 namespace Prism::Assets
 {
     class StaticMeshAssetFactory : public IAssetFactory
     {
     public:
+        // Loads either a cooked .pmesh directly or a source mesh, preferring an up-to-date cooked sibling if available
         std::unique_ptr<Asset> loadAsset(const std::string& fileName) override;
+
+        // Parses an OBJ file into deduplicated vertex and index streams, shared with the offline StaticMeshCooker
+        static bool parseObj(const std::string& fileName, std::vector<Rendering::Vertex>& vertices,
+                             std::vector<uint32_t>& indices);
+
+        // Maps a cooked mesh file, the returned asset references the mapped streams without copying them
+        static std::unique_ptr<Asset> loadCooked(const std::string& cookedFileName, const std::string& assetName);
     };
 }
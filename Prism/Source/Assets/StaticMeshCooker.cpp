@@ -0,0 +1,137 @@
+﻿#include "StaticMeshCooker.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "CookedStaticMesh.hpp"
+#include "StaticMeshAssetFactory.hpp"
+#include "../Utilities/Hash.hpp"
+#include "../Utilities/MappedFile.hpp"
+#include "../Utilities/Logging/Log.hpp"
+
+namespace
+{
+    void writePadding(std::ofstream& stream, const uint64_t targetOffset)
+    {
+        static constexpr std::array<char, Prism::Assets::CookedStaticMesh::streamAlignment> zeros = {};
+        const auto currentOffset = static_cast<uint64_t>(stream.tellp());
+        stream.write(zeros.data(), static_cast<std::streamsize>(targetOffset - currentOffset));
+    }
+}
+
+bool Prism::Assets::StaticMeshCooker::cook(const std::string& sourceFileName, const std::string& cookedFileName)
+{
+    const auto sourceHash = hashFile(sourceFileName);
+    if (!sourceHash)
+    {
+        return false;
+    }
+
+    std::vector<Rendering::Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!StaticMeshAssetFactory::parseObj(sourceFileName, vertices, indices))
+    {
+        return false;
+    }
+
+    CookedStaticMeshHeader header = {};
+    header.magic = CookedStaticMesh::magic;
+    header.version = CookedStaticMesh::version;
+    header.sourceHash = *sourceHash;
+    header.vertexStride = sizeof(Rendering::Vertex);
+    header.indexStride = sizeof(uint32_t);
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+    header.vertexOffset = CookedStaticMesh::alignOffset(sizeof(CookedStaticMeshHeader));
+    header.indexOffset = CookedStaticMesh::alignOffset(header.vertexOffset + vertices.size() * sizeof(Rendering::Vertex));
+
+    glm::vec3 boundsMin(0.0f);
+    glm::vec3 boundsMax(0.0f);
+    if (!vertices.empty())
+    {
+        boundsMin = vertices.front().position;
+        boundsMax = vertices.front().position;
+        for (const auto& vertex : vertices)
+        {
+            boundsMin = glm::min(boundsMin, vertex.position);
+            boundsMax = glm::max(boundsMax, vertex.position);
+        }
+    }
+    header.boundsMin = {boundsMin.x, boundsMin.y, boundsMin.z};
+    header.boundsMax = {boundsMax.x, boundsMax.y, boundsMax.z};
+
+    // Write to a temporary file first so a crashed or failed cook never leaves a half written mesh behind
+    const auto temporaryFileName = cookedFileName + ".tmp";
+    {
+        std::ofstream stream(temporaryFileName, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            LOG_ERROR("Failed to open cooked mesh file for writing: {}", temporaryFileName);
+            return false;
+        }
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writePadding(stream, header.vertexOffset);
+        stream.write(reinterpret_cast<const char*>(vertices.data()),
+                     static_cast<std::streamsize>(vertices.size() * sizeof(Rendering::Vertex)));
+        writePadding(stream, header.indexOffset);
+        stream.write(reinterpret_cast<const char*>(indices.data()),
+                     static_cast<std::streamsize>(indices.size() * sizeof(uint32_t)));
+
+        if (!stream)
+        {
+            LOG_ERROR("Failed to write cooked mesh file: {}", temporaryFileName);
+            return false;
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryFileName, cookedFileName, errorCode);
+    if (errorCode)
+    {
+        LOG_ERROR("Failed to move cooked mesh file to: {}, error: {}", cookedFileName, errorCode.message());
+        std::filesystem::remove(temporaryFileName, errorCode);
+        return false;
+    }
+
+    LOG_INFO("Cooked mesh: {} -> {}, vertices: {}, indices: {}", sourceFileName, cookedFileName, header.vertexCount,
+             header.indexCount);
+    return true;
+}
+
+bool Prism::Assets::StaticMeshCooker::isUpToDate(const std::string& sourceFileName, const std::string& cookedFileName)
+{
+    std::error_code errorCode;
+    if (!std::filesystem::exists(cookedFileName, errorCode) ||
+        std::filesystem::file_size(cookedFileName, errorCode) < sizeof(CookedStaticMeshHeader))
+    {
+        return false;
+    }
+
+    CookedStaticMeshHeader header;
+    {
+        std::ifstream stream(cookedFileName, std::ios::binary);
+        if (!stream || !stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            return false;
+        }
+    }
+    if (header.magic != CookedStaticMesh::magic || header.version != CookedStaticMesh::version)
+    {
+        return false;
+    }
+
+    const auto sourceHash = hashFile(sourceFileName);
+    return sourceHash && *sourceHash == header.sourceHash;
+}
+
+std::optional<uint64_t> Prism::Assets::StaticMeshCooker::hashFile(const std::string& fileName)
+{
+    const auto mappedFile = Utility::MappedFile::open(fileName);
+    if (!mappedFile)
+    {
+        return std::nullopt;
+    }
+    return Utility::Hash::fnv1a64(mappedFile->getData(), mappedFile->getSize());
+}
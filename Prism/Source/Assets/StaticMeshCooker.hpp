@@ -0,0 +1,19 @@
+﻿#pragma once
+#include <optional>
+#include <string>
+
+namespace Prism::Assets
+{
+    // Converts source meshes into the cooked binary format described in CookedStaticMesh.hpp
+    class StaticMeshCooker
+    {
+    public:
+        // Returns true if the cooked file was written successfully
+        static bool cook(const std::string& sourceFileName, const std::string& cookedFileName);
+
+        // True if the cooked file exists, matches the current format version and was cooked from the current source contents
+        [[nodiscard]] static bool isUpToDate(const std::string& sourceFileName, const std::string& cookedFileName);
+
+        [[nodiscard]] static std::optional<uint64_t> hashFile(const std::string& fileName);
+    };
+}
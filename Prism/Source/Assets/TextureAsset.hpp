@@ -13,7 +13,9 @@ namespace Prism::Assets
     public:
         explicit TextureAsset(const std::string& name, deletable_stbi_uc_ptr&& texturePtr, const uint32_t width,
                               const uint32_t height, const uint32_t channels)
-            : Asset(name), texture(std::move(texturePtr)), width(width), height(height), channels(channels)
+            : Asset(name), texture(std::move(texturePtr)), width(width), height(height), channels(channels),
+              // Pixels are always decoded as RGBA
+              pixelDataSize(static_cast<size_t>(width) * height * 4)
         {
         }
 
@@ -22,6 +24,11 @@ namespace Prism::Assets
             return texture;
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override
+        {
+            return pixelDataSize;
+        }
+
         [[nodiscard]] uint32_t getWidth() const
         {
             return width;
@@ -47,5 +54,6 @@ namespace Prism::Assets
         uint32_t width;
         uint32_t height;
         uint32_t channels;
+        size_t pixelDataSize;
     };
 }
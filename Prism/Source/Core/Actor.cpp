@@ -1,6 +1,19 @@
 ﻿#include "Actor.hpp"
+
+#include <atomic>
+
 #include "ActorComponent.hpp"
 
+namespace
+{
+    // Actors are also created on the loader thread of background scene loads
+    std::atomic<uint64_t> nextActorId = 1;
+}
+
+Prism::Core::Actor::Actor() : id(nextActorId.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
 void Prism::Core::Actor::init()
 {
 }
@@ -59,6 +72,15 @@ void Prism::Core::Actor::shutdown()
 {
 }
 
+void Prism::Core::Actor::onOverlapEvents(std::span<const Physics::OverlapEvent> events)
+{
+}
+
+void Prism::Core::Actor::dispatchOverlapEventsInternal(const std::span<const Physics::OverlapEvent> events)
+{
+    onOverlapEvents(events);
+}
+
 void Prism::Core::Actor::shutdownInternal()
 {
     for (const auto& component : components)
@@ -71,19 +93,59 @@ void Prism::Core::Actor::shutdownInternal()
 void Prism::Core::Actor::translateActor(const glm::vec3& translation)
 {
     transform.translate(translation);
+    markTransformChanged();
 }
 
 void Prism::Core::Actor::rotateActor(const glm::vec3& rotationDegrees)
 {
     transform.rotate(rotationDegrees);
+    markTransformChanged();
 }
 
 void Prism::Core::Actor::scaleActorUniform(const float scaleFactor)
 {
     transform.scale(scaleFactor);
+    markTransformChanged();
 }
 
 void Prism::Core::Actor::scaleActor(const glm::vec3& scaleFactor)
 {
     transform.scale(scaleFactor);
+    markTransformChanged();
+}
+
+uint64_t Prism::Core::Actor::recordSceneChangeInternal(const SceneChangeType type,
+                                                       const RawPtr<ActorComponent> component)
+{
+    if (!sceneJournal)
+    {
+        return SceneJournal::noSequence;
+    }
+    const auto sequence = sceneJournal->record(type, this, component);
+    if (!sceneJournal->isUnseenByAny(firstChangeSequence))
+    {
+        firstChangeSequence = sequence;
+    }
+    return sequence;
+}
+
+void Prism::Core::Actor::recordTransformChangeInternal(const RawPtr<ActorComponent> component,
+                                                       uint64_t& lastSequence)
+{
+    // Actors usually move several times per frame, subscribers only need to know that they did
+    if (sceneJournal && !sceneJournal->isUnseenByAll(lastSequence))
+    {
+        lastSequence = recordSceneChangeInternal(SceneChangeType::TransformChanged, component);
+    }
+}
+
+void Prism::Core::Actor::recordDestroyedInternal()
+{
+    if (!sceneJournal)
+    {
+        return;
+    }
+    sceneJournal->forgetActor(this, firstChangeSequence);
+    sceneJournal->record(SceneChangeType::ActorDestroyed, this);
+    sceneJournal = nullptr;
 }
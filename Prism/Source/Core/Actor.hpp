@@ -1,11 +1,14 @@
 ﻿#pragma once
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "ActorComponent.hpp"
 #include "ITickable.hpp"
+#include "SceneJournal.hpp"
 #include "Transform.hpp"
+#include "../Physics/OverlapEvent.hpp"
 #include "../Utilities/Globals.hpp"
 
 namespace Prism::Core
@@ -19,7 +22,7 @@ namespace Prism::Core
     class Actor : public ITickable
     {
     public:
-        Actor() = default;
+        Actor();
         virtual ~Actor() override = default;
         void beginPlayInternal();
         void initInternal();
@@ -27,6 +30,7 @@ namespace Prism::Core
         virtual void tick(float deltaTime) override;
         void tickInternal(float deltaTime);
         void shutdownInternal();
+        void dispatchOverlapEventsInternal(std::span<const Physics::OverlapEvent> events);
         void translateActor(const glm::vec3& translation);
         void rotateActor(const glm::vec3& rotationDegrees);
         void scaleActorUniform(float scaleFactor);
@@ -42,6 +46,12 @@ namespace Prism::Core
             this->name = newName;
         }
 
+        // Unique per process and increasing in creation order, unlike the address it doesn't depend on the allocator
+        [[nodiscard]] uint64_t getId() const
+        {
+            return id;
+        }
+
         [[nodiscard]] std::vector<RawPtr<ActorComponent>> getComponents() const
         {
             std::vector<RawPtr<ActorComponent>> outComponents;
@@ -72,6 +82,7 @@ namespace Prism::Core
         void setActorPosition(const glm::vec3& newPosition)
         {
             transform.setTranslation(newPosition);
+            markTransformChanged();
         }
 
         [[nodiscard]] glm::vec3 getActorRotation() const
@@ -82,6 +93,13 @@ namespace Prism::Core
         void setActorRotation(const glm::vec3& newRotationDegrees)
         {
             transform.setRotation(newRotationDegrees);
+            markTransformChanged();
+        }
+
+        void setActorRotation(const glm::quat& newRotation)
+        {
+            transform.setRotation(newRotation);
+            markTransformChanged();
         }
 
         [[nodiscard]] glm::vec3 getActorScale() const
@@ -92,6 +110,7 @@ namespace Prism::Core
         void setActorScale(const glm::vec3& newScale)
         {
             transform.setScale(newScale);
+            markTransformChanged();
         }
 
         [[nodiscard]] Transform getTransform() const
@@ -99,6 +118,23 @@ namespace Prism::Core
             return transform;
         }
 
+        [[nodiscard]] uint32_t getTransformVersion() const
+        {
+            return transform.getVersion();
+        }
+
+        template <ExtendsActorComponent T, typename Callback>
+        void forEachComponentOfType(Callback&& callback) const
+        {
+            for (const auto& component : components)
+            {
+                if (auto castedComponent = dynamic_cast<T*>(component.get()))
+                {
+                    callback(*castedComponent);
+                }
+            }
+        }
+
         template <ExtendsActorComponent T>
         RawPtr<T> addComponent()
         {
@@ -122,6 +158,19 @@ namespace Prism::Core
             pendingKill = true;
         }
 
+        // Set by the scene the actor is registered to, its changes are recorded there from then on
+        void setSceneJournalInternal(const RawPtr<SceneJournal>& journal)
+        {
+            sceneJournal = journal;
+        }
+
+        // Returns the sequence number of the change, noSequence if nothing was recorded
+        uint64_t recordSceneChangeInternal(SceneChangeType type, RawPtr<ActorComponent> component = nullptr);
+        // Skips the change if the previous one in lastSequence wasn't seen by any subscriber yet
+        void recordTransformChangeInternal(RawPtr<ActorComponent> component, uint64_t& lastSequence);
+        // Called by the scene right before the actor is destroyed
+        void recordDestroyedInternal();
+
     protected:
         Transform transform;
 
@@ -129,12 +178,25 @@ namespace Prism::Core
         virtual void beginPlay();
         virtual void initDeferred();
         virtual void shutdown();
+        // All overlaps of this actor's collidable components that began or ended during the last physics step
+        virtual void onOverlapEvents(std::span<const Physics::OverlapEvent> events);
+
+        // Subclasses modifying transform directly have to call this afterwards
+        void markTransformChanged()
+        {
+            recordTransformChangeInternal(nullptr, transformChangeSequence);
+        }
 
     private:
+        uint64_t id;
         std::string name = "Actor";
         bool initialized = false;
         bool initializedDeferred = false;
         bool pendingKill = false;
         std::vector<std::unique_ptr<ActorComponent>> components;
+        RawPtr<SceneJournal> sceneJournal;
+        // Oldest change of this actor a subscriber may not have seen yet
+        uint64_t firstChangeSequence = SceneJournal::noSequence;
+        uint64_t transformChangeSequence = SceneJournal::noSequence;
     };
 }
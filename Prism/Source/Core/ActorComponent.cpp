@@ -24,21 +24,33 @@ void Prism::Core::ActorComponent::shutdown()
 void Prism::Core::ActorComponent::translateComponent(const glm::vec3& translation)
 {
     transform.translate(translation);
+    markTransformChanged();
 }
 
 void Prism::Core::ActorComponent::rotateComponent(const glm::vec3& rotationDegrees)
 {
     transform.rotate(rotationDegrees);
+    markTransformChanged();
 }
 
 void Prism::Core::ActorComponent::scaleComponentUniform(const float scaleFactor)
 {
     transform.scale(scaleFactor);
+    markTransformChanged();
 }
 
 void Prism::Core::ActorComponent::scaleComponent(const glm::vec3& scaleFactor)
 {
     transform.scale(scaleFactor);
+    markTransformChanged();
+}
+
+void Prism::Core::ActorComponent::markTransformChanged()
+{
+    if (parent)
+    {
+        parent->recordTransformChangeInternal(this, transformChangeSequence);
+    }
 }
 
 [[nodiscard]] Prism::Core::Transform Prism::Core::ActorComponent::getLocalTransform() const
@@ -46,6 +58,12 @@ void Prism::Core::ActorComponent::scaleComponent(const glm::vec3& scaleFactor)
     return transform;
 }
 
+uint64_t Prism::Core::ActorComponent::getAbsoluteTransformVersion() const
+{
+    const uint64_t parentVersion = parent ? parent->getTransformVersion() : 0;
+    return parentVersion << 32 | transform.getVersion();
+}
+
 [[nodiscard]] Prism::Core::Transform Prism::Core::ActorComponent::getAbsoluteTransform()
 {
     if (parent)
@@ -3,6 +3,7 @@
 #include <glm/vec3.hpp>
 
 #include "ITickable.hpp"
+#include "SceneJournal.hpp"
 #include "Transform.hpp"
 #include "../Utilities/Globals.hpp"
 
@@ -47,6 +48,7 @@ namespace Prism::Core
         void setComponentPosition(const glm::vec3& newPosition)
         {
             transform.setTranslation(newPosition);
+            markTransformChanged();
         }
 
         [[nodiscard]] glm::vec3 getComponentRotation() const
@@ -57,6 +59,7 @@ namespace Prism::Core
         void setComponentRotation(const glm::vec3& newRotationDegrees)
         {
             transform.setRotation(newRotationDegrees);
+            markTransformChanged();
         }
 
         [[nodiscard]] glm::vec3 getComponentScale() const
@@ -67,15 +70,27 @@ namespace Prism::Core
         void setComponentScale(const glm::vec3& newScale)
         {
             transform.setScale(newScale);
+            markTransformChanged();
+        }
+
+        [[nodiscard]] RawPtr<Actor> getParent() const
+        {
+            return parent;
         }
 
         [[nodiscard]] Transform getLocalTransform() const;
 
         [[nodiscard]] Transform getAbsoluteTransform();
 
+        // Changes whenever the local transform or the transform of the parent actor changes
+        [[nodiscard]] uint64_t getAbsoluteTransformVersion() const;
+
     private:
+        void markTransformChanged();
+
         std::string name = "ActorComponent";
         Transform transform;
         RawPtr<Actor> parent;
+        uint64_t transformChangeSequence = SceneJournal::noSequence;
     };
 }
@@ -0,0 +1,81 @@
+﻿#pragma once
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "Actor.hpp"
+#include "../Utilities/IService.hpp"
+
+namespace Prism::Core
+{
+    /*
+     * Maps actor classes to stable names and back, so serialized scenes can store an actor's type and recreate it.
+     * Types are registered during bootstrapping, afterward the registry is only read and may be used from any thread.
+     */
+    class ActorTypeRegistry : public Utility::IService
+    {
+    public:
+        using ActorFactory = std::unique_ptr<Actor>(*)();
+
+        ActorTypeRegistry() = default;
+        ~ActorTypeRegistry() override = default;
+
+        void initialize() override
+        {
+        }
+
+        void initializeDeferred() override
+        {
+        }
+
+        void deInitialize() override
+        {
+        }
+
+        // The name ends up in scene files, renaming a registered type breaks existing files
+        template <ExtendsActor T>
+        void registerActorType(const std::string& typeName)
+        {
+            const auto index = actorTypes.size();
+            if (!indicesByName.try_emplace(typeName, index).second ||
+                !indicesByType.try_emplace(std::type_index(typeid(T)), index).second)
+            {
+                throw std::runtime_error("Actor type " + typeName + " is already registered!");
+            }
+            actorTypes.push_back({typeName, []() -> std::unique_ptr<Actor> { return std::make_unique<T>(); }});
+        }
+
+        // Returns nullptr for unknown names
+        [[nodiscard]] ActorFactory findActorFactory(const std::string& typeName) const
+        {
+            const auto it = indicesByName.find(typeName);
+            return it != indicesByName.end() ? actorTypes[it->second].factory : nullptr;
+        }
+
+        // Returns an empty string if the dynamic type of the actor isn't registered
+        [[nodiscard]] std::string findActorTypeName(const Actor& actor) const
+        {
+            const auto it = indicesByType.find(std::type_index(typeid(actor)));
+            return it != indicesByType.end() ? actorTypes[it->second].name : std::string();
+        }
+
+        std::string getFullName() override
+        {
+            return "Prism::Core::ActorTypeRegistry";
+        }
+
+    private:
+        struct ActorType
+        {
+            std::string name;
+            ActorFactory factory;
+        };
+
+        std::vector<ActorType> actorTypes;
+        std::unordered_map<std::string, size_t> indicesByName;
+        std::unordered_map<std::type_index, size_t> indicesByType;
+    };
+}
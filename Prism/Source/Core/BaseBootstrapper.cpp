@@ -1,17 +1,23 @@
 ﻿#include "BaseBootstrapper.hpp"
 
+#include "ActorTypeRegistry.hpp"
+#include "CameraActor.hpp"
 #include "EngineManager.hpp"
 #include "IEngineManager.hpp"
 #include "MeshFactoryRegistry.hpp"
 #include "TimeManager.hpp"
 #include "SceneManager.hpp"
+#include "SpatialIndex.hpp"
+#include "StaticMeshActor.hpp"
 #include "StaticMeshFactory.hpp"
 #include "../Utilities/ServiceLocator.hpp"
 #include "../Rendering/CameraManager.hpp"
 #include "../Rendering/RendererManager.hpp"
 #include "../Rendering/WindowManager.hpp"
 #include "../Rendering/GraphicsDebugBridge.hpp"
+#include "../Rendering/DebugDrawHelper.hpp"
 #include "../Input/GlfwInputManager.hpp"
+#include "../Input/NullInputManager.hpp"
 #include "../Assets/AssetManager.hpp"
 #include "../Assets/ShaderAssetFactory.hpp"
 #include "../Assets/ShaderAsset.hpp"
@@ -19,7 +25,10 @@
 #include "../Assets/TextureAsset.hpp"
 #include "../Assets/StaticMeshAssetFactory.hpp"
 #include "../Assets/StaticMeshAsset.hpp"
+#include "../Physics/CollisionBroadphase.hpp"
 #include "../Utilities/CommandLineArgsManager.hpp"
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/JobSystem.hpp"
 
 void Prism::Core::BaseBootstrapper::bootstrapInternal(const std::vector<Utility::CommandLineArg>& commandLineArgs)
 {
@@ -28,22 +37,45 @@ void Prism::Core::BaseBootstrapper::bootstrapInternal(const std::vector<Utility:
     LOG_DEBUG("Initialized random number generator 'srand' with seed '{}'", seed);
 
     using sl = Utility::ServiceLocator;
-    sl::registerService<Utility::CommandLineArgsManager>(
+    const auto commandLineArgsManager = sl::registerService<Utility::CommandLineArgsManager>(
         std::make_unique<Utility::CommandLineArgsManager>(commandLineArgs));
+    // Before any other service initializes, so startup only variables are already final
+    auto& consoleVariables = Utility::ConsoleVariableRegistry::registryInstance();
+    consoleVariables.loadConfigFile(commandLineArgsManager->getArgValue(
+        "config", Utility::ConsoleVariableRegistry::defaultConfigFileName));
+    consoleVariables.applyCommandLineArgs(commandLineArgs);
+    const bool headless = commandLineArgsManager->getArgValueAsBool("headless", false);
     sl::registerService<IEngineManager, EngineManager>();
+    sl::registerService<Utility::JobSystem, Utility::JobSystem>();
     sl::registerService<Rendering::GraphicsDebugBridge, Rendering::GraphicsDebugBridge>();
+    // Before the SceneManager, components unregister themselves while the scenes are destroyed
+    sl::registerService<SpatialIndex, SpatialIndex>();
     sl::registerService<ISceneManager, SceneManager>(std::make_unique<SceneManager>());
+    sl::registerService<Physics::CollisionBroadphase, Physics::CollisionBroadphase>();
     sl::registerService<ITimeManager, TimeManager>();
     sl::registerService<Rendering::IRendererManager, Rendering::RendererManager>(
         std::make_unique<Rendering::RendererManager>());
     const auto& meshFactorysRegistry = sl::registerService<MeshFactoryRegistry, MeshFactoryRegistry>();
     meshFactorysRegistry->registerMeshFactory<StaticMeshFactory>();
+    const auto& actorTypeRegistry = sl::registerService<ActorTypeRegistry, ActorTypeRegistry>();
+    actorTypeRegistry->registerActorType<Actor>("Prism::Core::Actor");
+    actorTypeRegistry->registerActorType<StaticMeshActor>("Prism::Core::StaticMeshActor");
+    actorTypeRegistry->registerActorType<CameraActor>("Prism::Core::CameraActor");
 
     const auto& windowManager = sl::registerService<
         Rendering::IWindowManager, Rendering::WindowManager>(std::make_unique<Rendering::WindowManager>());
     sl::registerService<Rendering::ICameraManager, Rendering::CameraManager>();
-    sl::registerService<Input::IInputManager, Input::GlfwInputManager>(
-        std::make_unique<Input::GlfwInputManager>(windowManager));
+    sl::registerService<Rendering::DebugDrawHelper, Rendering::DebugDrawHelper>();
+    if (headless)
+    {
+        sl::registerService<Input::IInputManager, Input::NullInputManager>(
+            std::make_unique<Input::NullInputManager>(windowManager));
+    }
+    else
+    {
+        sl::registerService<Input::IInputManager, Input::GlfwInputManager>(
+            std::make_unique<Input::GlfwInputManager>(windowManager));
+    }
     const auto& assetManager = sl::registerService<Assets::AssetManager, Assets::AssetManager>();
     sl::initializeServicesInternal();
     assetManager->registerAssetFactory<Assets::ShaderAssetFactory, Assets::ShaderAsset>();
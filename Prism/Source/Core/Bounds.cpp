@@ -0,0 +1,92 @@
+﻿#include "Bounds.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+Prism::Core::Ray::Ray(const glm::vec3& origin, const glm::vec3& direction)
+    : origin(origin), direction(glm::normalize(direction))
+{
+    inverseDirection = glm::vec3(1.0f / this->direction.x, 1.0f / this->direction.y, 1.0f / this->direction.z);
+}
+
+Prism::Core::Aabb Prism::Core::Aabb::transformed(const glm::mat4& matrix) const
+{
+    const auto center = getCenter();
+    const auto extents = getExtents();
+    auto newCenter = glm::vec3(matrix[3].x, matrix[3].y, matrix[3].z);
+    auto newExtents = glm::vec3(0.0f);
+    for (int column = 0; column < 3; ++column)
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            newCenter[row] += matrix[column][row] * center[column];
+            newExtents[row] += std::abs(matrix[column][row]) * extents[column];
+        }
+    }
+    return {newCenter - newExtents, newCenter + newExtents};
+}
+
+std::optional<float> Prism::Core::Aabb::intersectRay(const Ray& ray, const float maxDistance) const
+{
+    // Slab test, NaNs from rays starting exactly on a slab boundary are ignored by the min/max order
+    float entryDistance = 0.0f;
+    float exitDistance = maxDistance;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float distance1 = (min[axis] - ray.origin[axis]) * ray.inverseDirection[axis];
+        const float distance2 = (max[axis] - ray.origin[axis]) * ray.inverseDirection[axis];
+        entryDistance = std::max(entryDistance, std::min(distance1, distance2));
+        exitDistance = std::min(exitDistance, std::max(distance1, distance2));
+    }
+    if (entryDistance > exitDistance)
+    {
+        return std::nullopt;
+    }
+    return entryDistance;
+}
+
+Prism::Core::Frustum Prism::Core::Frustum::fromViewProjection(const glm::mat4& viewProjection)
+{
+    const auto row = [&viewProjection](const int index)
+    {
+        return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index],
+                         viewProjection[3][index]);
+    };
+    const auto row0 = row(0);
+    const auto row1 = row(1);
+    const auto row2 = row(2);
+    const auto row3 = row(3);
+
+    // The near plane assumes a -1..1 depth range, for 0..1 projections it lies behind the real one, which only
+    // makes the test more conservative
+    Frustum frustum;
+    frustum.planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+    for (auto& plane : frustum.planes)
+    {
+        plane /= glm::length(glm::vec3(plane.x, plane.y, plane.z));
+    }
+    return frustum;
+}
+
+Prism::Core::FrustumContainment Prism::Core::Frustum::test(const Aabb& aabb) const
+{
+    const auto center = aabb.getCenter();
+    const auto extents = aabb.getExtents();
+    auto containment = FrustumContainment::Inside;
+    for (const auto& plane : planes)
+    {
+        const auto normal = glm::vec3(plane.x, plane.y, plane.z);
+        const float distance = glm::dot(normal, center) + plane.w;
+        const float radius = glm::dot(glm::abs(normal), extents);
+        if (distance < -radius)
+        {
+            return FrustumContainment::Outside;
+        }
+        if (distance < radius)
+        {
+            containment = FrustumContainment::Intersects;
+        }
+    }
+    return containment;
+}
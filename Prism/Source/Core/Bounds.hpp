@@ -0,0 +1,104 @@
+﻿#pragma once
+#include <array>
+#include <optional>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace Prism::Core
+{
+    struct Ray
+    {
+        Ray(const glm::vec3& origin, const glm::vec3& direction);
+
+        glm::vec3 origin;
+        // Normalized
+        glm::vec3 direction;
+        // Precomputed for the slab tests, infinite for axis parallel rays
+        glm::vec3 inverseDirection;
+    };
+
+    // Axis aligned bounding box
+    struct Aabb
+    {
+        glm::vec3 min = glm::vec3(0.0f);
+        glm::vec3 max = glm::vec3(0.0f);
+
+        [[nodiscard]] glm::vec3 getCenter() const
+        {
+            return (min + max) * 0.5f;
+        }
+
+        [[nodiscard]] glm::vec3 getExtents() const
+        {
+            return (max - min) * 0.5f;
+        }
+
+        // Half the surface area, used as the insertion cost of the bounding volume hierarchy
+        [[nodiscard]] float getHalfSurfaceArea() const
+        {
+            const auto size = max - min;
+            return size.x * size.y + size.y * size.z + size.z * size.x;
+        }
+
+        [[nodiscard]] bool contains(const Aabb& other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        }
+
+        [[nodiscard]] bool overlaps(const Aabb& other) const
+        {
+            return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+                min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        [[nodiscard]] bool overlapsSphere(const glm::vec3& center, const float radius) const
+        {
+            return getSquaredDistance(center) <= radius * radius;
+        }
+
+        [[nodiscard]] float getSquaredDistance(const glm::vec3& point) const
+        {
+            const auto closestPoint = glm::min(glm::max(point, min), max);
+            const auto delta = point - closestPoint;
+            return glm::dot(delta, delta);
+        }
+
+        [[nodiscard]] Aabb merged(const Aabb& other) const
+        {
+            return {glm::min(min, other.min), glm::max(max, other.max)};
+        }
+
+        [[nodiscard]] Aabb expanded(const float margin) const
+        {
+            return {min - glm::vec3(margin), max + glm::vec3(margin)};
+        }
+
+        // Bounds of this box after transforming it with an affine matrix
+        [[nodiscard]] Aabb transformed(const glm::mat4& matrix) const;
+
+        // Distance along the ray at which it enters the box, 0 if it starts inside, nullopt if it misses
+        [[nodiscard]] std::optional<float> intersectRay(const Ray& ray, float maxDistance) const;
+    };
+
+    enum class FrustumContainment
+    {
+        Outside,
+        Intersects,
+        Inside,
+    };
+
+    class Frustum
+    {
+    public:
+        // Extracts the six planes of a projection * view matrix, the planes face inward
+        [[nodiscard]] static Frustum fromViewProjection(const glm::mat4& viewProjection);
+
+        [[nodiscard]] FrustumContainment test(const Aabb& aabb) const;
+
+    private:
+        // xyz is the normal, w the distance
+        std::array<glm::vec4, 6> planes;
+    };
+}
@@ -17,7 +17,8 @@ void Prism::Core::CameraActor::init()
     const auto cameraManager = Utility::ServiceLocator::getService<Rendering::ICameraManager>();
     cameraManager->setActiveCamera(cameraComponent);
     inputManager = Utility::ServiceLocator::getService<Input::IInputManager>();
-    inputManager->registerMouseMovementInput([this](const double xPos, const double yPos)
+    registerInputBindings();
+    mouseMovementListenerId = inputManager->registerMouseMovementInput([this](const double xPos, const double yPos)
     {
         onMouseMoved(static_cast<float>(xPos), static_cast<float>(yPos));
     });
@@ -25,46 +26,68 @@ void Prism::Core::CameraActor::init()
 
 void Prism::Core::CameraActor::shutdown()
 {
+    // The listener captures this, it must not outlive the actor
+    if (inputManager)
+    {
+        inputManager->unregisterMouseMovementInput(mouseMovementListenerId);
+        mouseMovementListenerId = Input::invalidInputListenerId;
+    }
+    // A scene replaced by a background load is torn down after the new one is active, keep its camera if it has one
+    const auto cameraManager = Utility::ServiceLocator::getService<Rendering::ICameraManager>();
+    if (cameraManager->getActiveCamera() == cameraComponent)
+    {
+        cameraManager->setActiveCamera(nullptr);
+    }
     Actor::shutdown();
 }
 
 void Prism::Core::CameraActor::tick(const float deltaTime)
 {
-    if (inputManager->isKeyDown(Input::InputKey::ESCAPE))
+    const auto& actionMap = inputManager->getActionMap();
+    if (actionMap.isActionActive(quitAction))
     {
         Utility::ServiceLocator::getService<IEngineManager>()->requestShutdown();
         return;
     }
 
-    const float movementSpeed = (inputManager->isKeyDown(Input::InputKey::LEFT_SHIFT) ? 7.0f : 2.5f) * deltaTime;
-
+    const float movementSpeed = (actionMap.isActionActive(sprintAction) ? 7.0f : 2.5f) * deltaTime;
+    const auto translation = this->transform.forward() * actionMap.getAxisValue(moveForwardAxis) +
+        this->transform.right() * actionMap.getAxisValue(moveRightAxis) +
+        this->transform.up() * actionMap.getAxisValue(moveUpAxis);
+    this->transform.translate(movementSpeed * translation);
+    markTransformChanged();
+}
 
-    auto translation = glm::vec3(0.0f);
-    if (inputManager->isKeyDown(Input::InputKey::W))
-    {
-        translation += this->transform.forward();
-    }
-    if (inputManager->isKeyDown(Input::InputKey::S))
-    {
-        translation -= this->transform.forward();
-    }
-    if (inputManager->isKeyDown(Input::InputKey::A))
-    {
-        translation -= this->transform.right();
-    }
-    if (inputManager->isKeyDown(Input::InputKey::D))
-    {
-        translation += this->transform.right();
-    }
-    if (inputManager->isKeyDown(Input::InputKey::Q))
+void Prism::Core::CameraActor::registerInputBindings()
+{
+    auto& actionMap = inputManager->getActionMap();
+    const auto registerAction = [&actionMap](const char* name, const Input::InputKey key)
     {
-        translation -= this->transform.up();
-    }
-    if (inputManager->isKeyDown(Input::InputKey::E))
+        const bool exists = actionMap.findAction(name) != Input::invalidInputMappingId;
+        const auto actionId = actionMap.registerAction(name);
+        if (!exists)
+        {
+            actionMap.bindAction(actionId, Input::InputBinding::fromKey(key));
+        }
+        return actionId;
+    };
+    const auto registerAxis = [&actionMap](const char* name, const Input::InputKey positiveKey,
+                                           const Input::InputKey negativeKey)
     {
-        translation += this->transform.up();
-    }
-    this->transform.translate(movementSpeed * translation);
+        const bool exists = actionMap.findAxis(name) != Input::invalidInputMappingId;
+        const auto axisId = actionMap.registerAxis(name);
+        if (!exists)
+        {
+            actionMap.bindAxis(axisId, Input::InputBinding::fromKey(positiveKey, 1.0f));
+            actionMap.bindAxis(axisId, Input::InputBinding::fromKey(negativeKey, -1.0f));
+        }
+        return axisId;
+    };
+    quitAction = registerAction("Quit", Input::InputKey::ESCAPE);
+    sprintAction = registerAction("Sprint", Input::InputKey::LEFT_SHIFT);
+    moveForwardAxis = registerAxis("MoveForward", Input::InputKey::W, Input::InputKey::S);
+    moveRightAxis = registerAxis("MoveRight", Input::InputKey::D, Input::InputKey::A);
+    moveUpAxis = registerAxis("MoveUp", Input::InputKey::E, Input::InputKey::Q);
 }
 
 // member function mouse movement callback
@@ -86,6 +109,7 @@ void Prism::Core::CameraActor::onMouseMoved(const float xPos, const float yPos)
         constexpr float rotationSpeed = 0.15f;
         this->transform.rotate(rotationSpeed * deltaX, Transform::localUp);
         this->transform.rotate(rotationSpeed * deltaY, this->transform.right());
+        markTransformChanged();
     }
 
     mouseLastXPos = xPos;
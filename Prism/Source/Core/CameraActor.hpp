@@ -20,7 +20,16 @@ namespace Prism::Core
     private:
         RawPtr<CameraComponent> cameraComponent;
         RawPtr<Input::IInputManager> inputManager;
+        Input::InputListenerId mouseMovementListenerId = Input::invalidInputListenerId;
+        Input::InputActionId quitAction = Input::invalidInputMappingId;
+        Input::InputActionId sprintAction = Input::invalidInputMappingId;
+        Input::InputAxisId moveForwardAxis = Input::invalidInputMappingId;
+        Input::InputAxisId moveRightAxis = Input::invalidInputMappingId;
+        Input::InputAxisId moveUpAxis = Input::invalidInputMappingId;
         float mouseLastXPos = -1.0f;
         float mouseLastYPos = -1.0f;
+
+        // Only binds actions that don't exist yet, so bindings changed at runtime survive a new camera
+        void registerInputBindings();
     };
 }
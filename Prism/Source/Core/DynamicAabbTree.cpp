@@ -0,0 +1,251 @@
+﻿#include "DynamicAabbTree.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+int32_t Prism::Core::DynamicAabbTree::createProxy(const Aabb& aabb, const uint32_t userData)
+{
+    const auto proxyId = allocateNode();
+    auto& node = nodes[proxyId];
+    node.aabb = aabb.expanded(margin);
+    node.userData = userData;
+    node.height = 0;
+    insertLeaf(proxyId);
+    ++proxyCount;
+    return proxyId;
+}
+
+void Prism::Core::DynamicAabbTree::destroyProxy(const int32_t proxyId)
+{
+    assert(proxyId >= 0 && static_cast<size_t>(proxyId) < nodes.size() && nodes[proxyId].isLeaf());
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --proxyCount;
+}
+
+bool Prism::Core::DynamicAabbTree::moveProxy(const int32_t proxyId, const Aabb& aabb)
+{
+    assert(proxyId >= 0 && static_cast<size_t>(proxyId) < nodes.size() && nodes[proxyId].isLeaf());
+    if (nodes[proxyId].aabb.contains(aabb))
+    {
+        return false;
+    }
+    removeLeaf(proxyId);
+    nodes[proxyId].aabb = aabb.expanded(margin);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void Prism::Core::DynamicAabbTree::clear()
+{
+    nodes.clear();
+    root = nullNode;
+    freeList = nullNode;
+    proxyCount = 0;
+}
+
+int32_t Prism::Core::DynamicAabbTree::allocateNode()
+{
+    if (freeList == nullNode)
+    {
+        nodes.emplace_back();
+        return static_cast<int32_t>(nodes.size() - 1);
+    }
+    const auto nodeId = freeList;
+    freeList = nodes[nodeId].parent;
+    nodes[nodeId] = Node();
+    return nodeId;
+}
+
+void Prism::Core::DynamicAabbTree::freeNode(const int32_t nodeId)
+{
+    auto& node = nodes[nodeId];
+    node.parent = freeList;
+    node.child1 = nullNode;
+    node.child2 = nullNode;
+    node.height = -1;
+    freeList = nodeId;
+}
+
+void Prism::Core::DynamicAabbTree::insertLeaf(const int32_t leaf)
+{
+    if (root == nullNode)
+    {
+        root = leaf;
+        nodes[root].parent = nullNode;
+        return;
+    }
+
+    // Walk down to the sibling whose box grows the least, preferring to stop early if descending costs more
+    const auto leafAabb = nodes[leaf].aabb;
+    auto sibling = root;
+    while (!nodes[sibling].isLeaf())
+    {
+        const auto& node = nodes[sibling];
+        const float area = node.aabb.getHalfSurfaceArea();
+        const float combinedArea = node.aabb.merged(leafAabb).getHalfSurfaceArea();
+        // Cost of creating a new parent for this node and the leaf
+        const float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down, every ancestor grows by the same amount
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        const auto descendCost = [&](const int32_t child)
+        {
+            const auto& childAabb = nodes[child].aabb;
+            const float mergedArea = childAabb.merged(leafAabb).getHalfSurfaceArea();
+            return nodes[child].isLeaf()
+                       ? mergedArea + inheritanceCost
+                       : mergedArea - childAabb.getHalfSurfaceArea() + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        sibling = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const auto oldParent = nodes[sibling].parent;
+    // May reallocate the nodes, no references are held across it
+    const auto newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = leafAabb.merged(nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == nullNode)
+    {
+        root = newParent;
+    }
+    else if (nodes[oldParent].child1 == sibling)
+    {
+        nodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(nodes[leaf].parent);
+}
+
+void Prism::Core::DynamicAabbTree::removeLeaf(const int32_t leaf)
+{
+    if (leaf == root)
+    {
+        root = nullNode;
+        return;
+    }
+
+    const auto parent = nodes[leaf].parent;
+    const auto grandParent = nodes[parent].parent;
+    const auto sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    // The parent is replaced by the sibling
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    if (grandParent == nullNode)
+    {
+        root = sibling;
+        return;
+    }
+    if (nodes[grandParent].child1 == parent)
+    {
+        nodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        nodes[grandParent].child2 = sibling;
+    }
+    refitAncestors(grandParent);
+}
+
+void Prism::Core::DynamicAabbTree::refitAncestors(int32_t nodeId)
+{
+    while (nodeId != nullNode)
+    {
+        nodeId = balance(nodeId);
+        auto& node = nodes[nodeId];
+        const auto& child1 = nodes[node.child1];
+        const auto& child2 = nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.aabb = child1.aabb.merged(child2.aabb);
+        nodeId = node.parent;
+    }
+}
+
+int32_t Prism::Core::DynamicAabbTree::balance(const int32_t nodeId)
+{
+    auto& a = nodes[nodeId];
+    if (a.isLeaf() || a.height < 2)
+    {
+        return nodeId;
+    }
+
+    const auto bId = a.child1;
+    const auto cId = a.child2;
+    auto& b = nodes[bId];
+    auto& c = nodes[cId];
+    const auto heightDifference = c.height - b.height;
+
+    // Rotates the taller child up, it becomes the parent of a and takes over a's place in the tree
+    const auto rotateUp = [&](const int32_t upId, Node& up, const Node& other, const bool upIsChild2)
+    {
+        const auto grandChild1Id = up.child1;
+        const auto grandChild2Id = up.child2;
+        auto& grandChild1 = nodes[grandChild1Id];
+        auto& grandChild2 = nodes[grandChild2Id];
+
+        up.child1 = nodeId;
+        up.parent = a.parent;
+        a.parent = upId;
+        if (up.parent == nullNode)
+        {
+            root = upId;
+        }
+        else if (nodes[up.parent].child1 == nodeId)
+        {
+            nodes[up.parent].child1 = upId;
+        }
+        else
+        {
+            nodes[up.parent].child2 = upId;
+        }
+
+        // The taller grandchild stays with the rotated node, the other one moves over to a
+        const bool keepFirst = grandChild1.height > grandChild2.height;
+        const auto keptId = keepFirst ? grandChild1Id : grandChild2Id;
+        const auto movedId = keepFirst ? grandChild2Id : grandChild1Id;
+        auto& kept = nodes[keptId];
+        auto& moved = nodes[movedId];
+        up.child2 = keptId;
+        if (upIsChild2)
+        {
+            a.child2 = movedId;
+        }
+        else
+        {
+            a.child1 = movedId;
+        }
+        moved.parent = nodeId;
+        a.aabb = other.aabb.merged(moved.aabb);
+        a.height = 1 + std::max(other.height, moved.height);
+        up.aabb = a.aabb.merged(kept.aabb);
+        up.height = 1 + std::max(a.height, kept.height);
+        return upId;
+    };
+
+    if (heightDifference > 1)
+    {
+        return rotateUp(cId, c, b, true);
+    }
+    if (heightDifference < -1)
+    {
+        return rotateUp(bId, b, c, false);
+    }
+    return nodeId;
+}
@@ -0,0 +1,237 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Bounds.hpp"
+
+namespace Prism::Core
+{
+    /*
+     * Bounding volume hierarchy over moving boxes. Leaves store a box enlarged by a margin, so objects moving
+     * within it don't touch the tree at all. Leaves that leave their box are reinserted and the ancestors refit on
+     * the way up, tree rotations keep it balanced. Insertion picks the sibling with the smallest surface area
+     * increase.
+     */
+    class DynamicAabbTree
+    {
+    public:
+        inline constexpr static int32_t nullNode = -1;
+
+        explicit DynamicAabbTree(const float margin) : margin(margin)
+        {
+        }
+
+        // Returns the proxy id, userData is handed back by the queries
+        int32_t createProxy(const Aabb& aabb, uint32_t userData);
+        void destroyProxy(int32_t proxyId);
+        // Returns true if the proxy had to be reinserted because the box left its enlarged box
+        bool moveProxy(int32_t proxyId, const Aabb& aabb);
+        void clear();
+
+        void setMargin(const float newMargin)
+        {
+            margin = newMargin;
+        }
+
+        [[nodiscard]] uint32_t getUserData(const int32_t proxyId) const
+        {
+            return nodes[proxyId].userData;
+        }
+
+        [[nodiscard]] const Aabb& getEnlargedAabb(const int32_t proxyId) const
+        {
+            return nodes[proxyId].aabb;
+        }
+
+        [[nodiscard]] int32_t getHeight() const
+        {
+            return root == nullNode ? 0 : nodes[root].height;
+        }
+
+        [[nodiscard]] size_t getProxyCount() const
+        {
+            return proxyCount;
+        }
+
+        // callback(userData) returns false to stop the query
+        template <typename Callback>
+        void queryAabb(const Aabb& aabb, Callback&& callback) const
+        {
+            traverse([&aabb](const Aabb& nodeAabb)
+            {
+                return nodeAabb.overlaps(aabb) ? FrustumContainment::Intersects : FrustumContainment::Outside;
+            }, callback);
+        }
+
+        template <typename Callback>
+        void querySphere(const glm::vec3& center, const float radius, Callback&& callback) const
+        {
+            traverse([&center, radius](const Aabb& nodeAabb)
+            {
+                return nodeAabb.overlapsSphere(center, radius)
+                           ? FrustumContainment::Intersects
+                           : FrustumContainment::Outside;
+            }, callback);
+        }
+
+        // Subtrees fully inside the frustum are reported without testing their nodes
+        template <typename Callback>
+        void queryFrustum(const Frustum& frustum, Callback&& callback) const
+        {
+            traverse([&frustum](const Aabb& nodeAabb)
+            {
+                return frustum.test(nodeAabb);
+            }, callback);
+        }
+
+        /*
+         * callback(userData, distance) is invoked for every leaf box the ray enters within maxDistance and returns the
+         * new maximum distance, e.g. the distance of an exact hit to only look for closer ones, or 0 to stop.
+         */
+        template <typename Callback>
+        void raycast(const Ray& ray, float maxDistance, Callback&& callback) const
+        {
+            TraversalStack stack;
+            if (root != nullNode)
+            {
+                stack.push({root, false});
+            }
+            while (!stack.isEmpty())
+            {
+                const auto& node = nodes[stack.pop().node];
+                const auto distance = node.aabb.intersectRay(ray, maxDistance);
+                if (!distance)
+                {
+                    continue;
+                }
+                if (node.isLeaf())
+                {
+                    maxDistance = callback(node.userData, *distance);
+                    if (maxDistance <= 0.0f)
+                    {
+                        return;
+                    }
+                    continue;
+                }
+                stack.push({node.child1, false});
+                stack.push({node.child2, false});
+            }
+        }
+
+    private:
+        struct Node
+        {
+            Aabb aabb;
+            // Next free node while the node is on the free list
+            int32_t parent = nullNode;
+            int32_t child1 = nullNode;
+            int32_t child2 = nullNode;
+            // Leaves have height 0, free nodes -1
+            int32_t height = 0;
+            uint32_t userData = 0;
+
+            [[nodiscard]] bool isLeaf() const
+            {
+                return child1 == nullNode;
+            }
+        };
+
+        struct StackEntry
+        {
+            int32_t node;
+            // Set once an ancestor was found to be fully contained, its descendants are not tested anymore
+            bool inside;
+        };
+
+        // Fixed size for the common case, only trees degenerated far beyond their usual depth allocate
+        class TraversalStack
+        {
+        public:
+            void push(const StackEntry entry)
+            {
+                if (size < fixedEntries.size())
+                {
+                    fixedEntries[size] = entry;
+                }
+                else
+                {
+                    overflowEntries.push_back(entry);
+                }
+                ++size;
+            }
+
+            StackEntry pop()
+            {
+                --size;
+                if (size < fixedEntries.size())
+                {
+                    return fixedEntries[size];
+                }
+                const auto entry = overflowEntries.back();
+                overflowEntries.pop_back();
+                return entry;
+            }
+
+            [[nodiscard]] bool isEmpty() const
+            {
+                return size == 0;
+            }
+
+        private:
+            std::array<StackEntry, 128> fixedEntries;
+            std::vector<StackEntry> overflowEntries;
+            size_t size = 0;
+        };
+
+        std::vector<Node> nodes;
+        int32_t root = nullNode;
+        int32_t freeList = nullNode;
+        size_t proxyCount = 0;
+        float margin;
+
+        template <typename NodeTest, typename Callback>
+        void traverse(NodeTest&& nodeTest, Callback& callback) const
+        {
+            TraversalStack stack;
+            if (root != nullNode)
+            {
+                stack.push({root, false});
+            }
+            while (!stack.isEmpty())
+            {
+                const auto entry = stack.pop();
+                const auto& node = nodes[entry.node];
+                auto inside = entry.inside;
+                if (!inside)
+                {
+                    const auto containment = nodeTest(node.aabb);
+                    if (containment == FrustumContainment::Outside)
+                    {
+                        continue;
+                    }
+                    inside = containment == FrustumContainment::Inside;
+                }
+                if (node.isLeaf())
+                {
+                    if (!callback(node.userData))
+                    {
+                        return;
+                    }
+                    continue;
+                }
+                stack.push({node.child1, inside});
+                stack.push({node.child2, inside});
+            }
+        }
+
+        int32_t allocateNode();
+        void freeNode(int32_t nodeId);
+        void insertLeaf(int32_t leaf);
+        void removeLeaf(int32_t leaf);
+        // Refits the boxes and heights from the given node up to the root
+        void refitAncestors(int32_t nodeId);
+        // Performs a rotation if the subtree is unbalanced, returns the new root of the subtree
+        int32_t balance(int32_t nodeId);
+    };
+}
@@ -1,11 +1,19 @@
 #include "Engine.hpp"
 
 #include "IEngineManager.hpp"
+#include "ITimeManager.hpp"
 #include "../Utilities/Logging/Log.hpp"
 #include "../Utilities/ServiceLocator.hpp"
 #include "../Rendering/IWindowManager.hpp"
 #include "../Input/IInputManager.hpp"
 #include "../Rendering/GlfwWindow.hpp"
+#include "../Rendering/HeadlessWindow.hpp"
+#include "../Rendering/IRendererManager.hpp"
+#include "../Assets/AssetManager.hpp"
+#include "../Physics/CollisionBroadphase.hpp"
+#include "../Utilities/CommandLineArgsManager.hpp"
+#include "../Utilities/Profiling/AllocationTracker.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
 #include <format>
 
 
@@ -23,43 +31,116 @@ void Prism::Core::Engine::start()
 {
     sceneManager = Utility::ServiceLocator::getService<ISceneManager>();
     const auto windowManager = Utility::ServiceLocator::getService<Rendering::IWindowManager>();
-    windowManager->setWindow(std::make_unique<Rendering::GlfwWindow>());
+    if (Utility::ServiceLocator::getService<Utility::CommandLineArgsManager>()->getArgValueAsBool("headless", false))
+    {
+        windowManager->setWindow(std::make_unique<Rendering::HeadlessWindow>());
+    }
+    else
+    {
+        windowManager->setWindow(std::make_unique<Rendering::GlfwWindow>());
+    }
+#ifdef Prism_ALLOCATION_TRACKING
+    Utility::Profiling::AllocationTracker::allocationTrackerInstance().setFailOnSteadyStateAllocation(
+        Utility::ServiceLocator::getService<Utility::CommandLineArgsManager>()->getArgValueAsBool(
+            "fail-on-frame-allocation", false));
+#endif
     const auto window = windowManager->getWindow();
     window->init();
     Utility::ServiceLocator::deferredInitializeServicesInternal();
-    // Take ownership of scene
-    sceneManager->loadScene(std::unique_ptr<Scene>(bootstrapper->getDefaultScene().get()));
+    // Takes ownership of the scene, the empty default scene keeps the window responsive until it is loaded
+    sceneManager->loadSceneAsync([scene = bootstrapper->getDefaultScene().get()]
+    {
+        return std::unique_ptr<Scene>(scene);
+    });
     const auto inputManager = Utility::ServiceLocator::getService<Input::IInputManager>();
     const auto engineManager = Utility::ServiceLocator::getService<IEngineManager>();
+    const auto assetManager = Utility::ServiceLocator::getService<Assets::AssetManager>();
+    const auto collisionBroadphase = Utility::ServiceLocator::getService<Physics::CollisionBroadphase>();
+    const auto renderer = Utility::ServiceLocator::getService<Rendering::IRendererManager>()->getRenderer();
+    auto& frameStatistics = Utility::ServiceLocator::getService<ITimeManager>()->getFrameStatistics();
+    bool hasPreviousFrame = false;
+    renderThread.start(renderer);
+    PRISM_PROFILE_THREAD("Main");
     while (!window->isShutdownRequested() && !engineManager->isShutdownRequested())
     {
+        PRISM_PROFILE_FRAME();
+        PRISM_ALLOCATION_FRAME();
         // Update frame delta first, then fetch it
         engineClock.updateFrameDelta();
         frameDeltaSeconds = engineClock.getFrameDelta();
         const float frameDeltaMs = engineClock.getFrameDeltaMilliseconds();
+        // The delta spans the previous iteration, whose update and render timings are still held by the clock
+        if (hasPreviousFrame)
+        {
+            frameStatistics.addSample({
+                frameDeltaMs, engineClock.getUpdateDeltaMilliseconds(), engineClock.getRenderDeltaMilliseconds(),
+                engineClock.getPhysicsDeltaMilliseconds()
+            });
+        }
+        hasPreviousFrame = true;
         frameAccumulatorSeconds += frameDeltaSeconds;
         if (frameAccumulatorSeconds >= 1.0f)
         {
+            // Once per second is fine, the title string is rebuilt from scratch
+            PRISM_ALLOCATION_ALLOW();
             framesPerSecond = static_cast<float>(engineClock.getFrameCount()) / frameAccumulatorSeconds;
-            const auto info = std::format("FPS: {} | Frame: {}ms | Render: {}ms | Update: {}ms | Physics: {}ms",
-                                          framesPerSecond, frameDeltaMs, engineClock.getRenderDeltaMilliseconds(),
-                                          engineClock.getUpdateDeltaMilliseconds(),
-                                          engineClock.getPhysicsDeltaMilliseconds());
+            auto info = std::format("FPS: {} | Frame: {}ms | Render: {}ms | Update: {}ms | Physics: {}ms",
+                                    framesPerSecond, frameDeltaMs, engineClock.getRenderDeltaMilliseconds(),
+                                    engineClock.getUpdateDeltaMilliseconds(),
+                                    engineClock.getPhysicsDeltaMilliseconds());
+            for (const auto& [passName, passMilliseconds] : renderer->getGpuPassTimings())
+            {
+                info += std::format(" | GPU {}: {:.3f}ms", passName, passMilliseconds);
+            }
+            const auto frameSummary = frameStatistics.computeSummary(Utility::FrameMetric::Frame);
+            info += std::format(" | Frame p50/p99/max: {:.2f}/{:.2f}/{:.2f}ms", frameSummary.p50, frameSummary.p99,
+                                frameSummary.max);
             //LOG_DEBUG(info);
             window->setWindowTitle(info);
             frameAccumulatorSeconds = 0.0f;
             engineClock.reset();
         }
-        window->pollWindowEvents();
-        engineClock.startUpdateTimer();
-        sceneManager->tick(frameDeltaSeconds);
-        engineClock.stopUpdateTimer();
-
-        engineClock.startRenderTimer();
+        {
+            PRISM_PROFILE_SCOPE("Renderer::waitBeforeInputSampling");
+            renderThread.waitBeforeInputSampling();
+        }
+        {
+            PRISM_PROFILE_SCOPE("Engine::pollWindowEvents");
+            PRISM_ALLOCATION_SCOPE("Window");
+            window->pollWindowEvents();
+            inputManager->processInputEvents();
+        }
+        // Hand finished background loads to the game code before it ticks
+        {
+            PRISM_PROFILE_SCOPE("AssetManager::dispatchCompletedRequests");
+            PRISM_ALLOCATION_SCOPE("Assets");
+            assetManager->dispatchCompletedRequests();
+        }
+        {
+            PRISM_ALLOCATION_SCOPE("Scene");
+            engineClock.startUpdateTimer();
+            sceneManager->tick(frameDeltaSeconds);
+            engineClock.stopUpdateTimer();
+        }
+        // Overlap events of this frame's movement reach the actors before the frame is rendered
+        {
+            PRISM_ALLOCATION_SCOPE("Physics");
+            engineClock.startPhysicsTimer();
+            collisionBroadphase->step();
+            engineClock.stopPhysicsTimer();
+        }
         window->tick(frameDeltaSeconds);
-        engineClock.stopRenderTimer();
+        // The render thread draws this frame from the packet while the loop already updates the next one
+        {
+            PRISM_PROFILE_SCOPE("Renderer::extract");
+            PRISM_ALLOCATION_SCOPE("Renderer");
+            renderer->extract(renderThread.getExtractionPacket());
+        }
+        renderThread.submit();
+        engineClock.setRenderTime(renderThread.getLastRenderTime());
     }
     LOG_DEBUG("Shutdown requested...");
+    renderThread.stop();
     //TODO: Move to shutdown or manage otherwise like in WindowManager?
     window->shutdown();
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "BaseBootstrapper.hpp"
 #include "ISceneManager.hpp"
+#include "../Rendering/RenderThread.hpp"
 #include "../Utilities/EngineClock.hpp"
 #include "../Utilities/Globals.hpp"
 
@@ -18,6 +19,7 @@ namespace Prism::Core
         std::unique_ptr<BaseBootstrapper> bootstrapper;
         RawPtr<ISceneManager> sceneManager;
         Utility::EngineClock engineClock;
+        Rendering::RenderThread renderThread;
 
         float frameDeltaSeconds = 0;
         float framesPerSecond = 0;
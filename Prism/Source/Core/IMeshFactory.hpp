@@ -22,6 +22,7 @@ namespace Prism::Core
     {
     public:
         virtual ~IMeshFactory() = default;
-        [[nodiscard]] virtual std::unique_ptr<TMeshType> createMesh(RawPtr<TMeshAssetType> meshAsset) = 0;
+        [[nodiscard]] virtual std::unique_ptr<TMeshType> createMesh(
+            const Assets::AssetHandle<TMeshAssetType>& meshAsset) = 0;
     };
 }
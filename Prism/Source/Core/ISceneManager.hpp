@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <any>
+#include <functional>
 #include "Scene.hpp"
 #include "../Utilities/IService.hpp"
 #include "../Utilities/Globals.hpp"
@@ -15,6 +16,13 @@ namespace Prism::Core
         virtual void deInitialize() override = 0;
         virtual std::string getFullName() override = 0;
         virtual void loadScene(std::unique_ptr<Scene>&& scene) = 0;
+        /*
+         * Constructs and preloads the scene on a loader thread while the current scene keeps ticking and rendering.
+         * The switch happens at the start of the first tick after the load finished, the old scene is then torn down
+         * a few actors per frame. A load that is still running is replaced by the new one.
+         */
+        virtual void loadSceneAsync(std::function<std::unique_ptr<Scene>()> sceneFactory) = 0;
+        [[nodiscard]] virtual bool isLoadingScene() const = 0;
         virtual void tick(float deltaTime) = 0;
 
         template <ExtendsActor T>
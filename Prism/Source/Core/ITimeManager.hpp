@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "../Utilities/IService.hpp"
+#include "../Utilities/FrameStatistics.hpp"
 
 namespace Prism::Core
 {
@@ -12,5 +13,7 @@ namespace Prism::Core
         virtual void deInitialize() override = 0;
 
         virtual std::string getFullName() override = 0;
+
+        [[nodiscard]] virtual Utility::FrameStatistics& getFrameStatistics() = 0;
     };
 }
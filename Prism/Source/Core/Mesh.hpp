@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "../Assets/AssetHandle.hpp"
 #include "../Assets/StaticMeshAsset.hpp"
 #include "../Utilities/Globals.hpp"
 
@@ -7,14 +8,15 @@ namespace Prism::Core
     class Mesh
     {
     public:
-        explicit Mesh(const RawPtr<Assets::MeshAsset> meshAsset, const uint64_t meshId) :
+        // Holds a reference so the asset stays loaded as long as the mesh exists
+        explicit Mesh(Assets::AssetHandle<Assets::MeshAsset> meshAsset, const uint64_t meshId) :
             meshAsset(std::move(meshAsset)), meshId(meshId)
         {
         }
 
         virtual ~Mesh() = default;
 
-        [[nodiscard]] RawPtr<Assets::MeshAsset> getMeshAsset() const
+        [[nodiscard]] const Assets::AssetHandle<Assets::MeshAsset>& getMeshAsset() const
         {
             return meshAsset;
         }
@@ -25,7 +27,7 @@ namespace Prism::Core
         }
 
     protected:
-        RawPtr<Assets::MeshAsset> meshAsset;
+        Assets::AssetHandle<Assets::MeshAsset> meshAsset;
 
     private:
         uint64_t meshId;
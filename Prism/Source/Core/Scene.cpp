@@ -1,4 +1,9 @@
 ﻿#include "Scene.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+void Prism::Core::Scene::preload()
+{
+}
 
 void Prism::Core::Scene::init()
 {
@@ -8,6 +13,12 @@ void Prism::Core::Scene::initGuiComponents()
 {
 }
 
+void Prism::Core::Scene::preloadInternal()
+{
+    PRISM_PROFILE_SCOPE("Scene::preloadInternal");
+    preload();
+}
+
 void Prism::Core::Scene::initInternal()
 {
     init();
@@ -39,6 +50,7 @@ void Prism::Core::Scene::tick(const float deltaTime)
 
 void Prism::Core::Scene::tickInternal(const float deltaTime)
 {
+    PRISM_PROFILE_SCOPE("Scene::tickInternal");
     for (const auto& deferredActor : deferredActors)
     {
         deferredActor->initDeferredInternal();
@@ -68,9 +80,27 @@ void Prism::Core::Scene::shutdownInternal()
     shutdown();
 }
 
+bool Prism::Core::Scene::shutdownIncrementalInternal(const size_t maxActors)
+{
+    // A retired scene doesn't tick anymore, actors still waiting for their deferred init never get it
+    deferredActors.clear();
+    for (size_t i = 0; i < maxActors && !actors.empty(); ++i)
+    {
+        actors.back()->shutdownInternal();
+        actors.pop_back();
+    }
+    if (!actors.empty())
+    {
+        return false;
+    }
+    shutdown();
+    return true;
+}
+
 void Prism::Core::Scene::unregisterActor(RawPtr<Actor> actor)
 {
     actor->shutdownInternal();
+    actor->recordDestroyedInternal();
     std::erase_if(deferredActors, [actor](const auto& a)
     {
         return a.get() == actor.get();
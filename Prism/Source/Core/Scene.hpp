@@ -1,18 +1,22 @@
 ﻿#pragma once
 #include "Actor.hpp"
 #include "ITickable.hpp"
+#include "SceneJournal.hpp"
 
 namespace Prism::Core
 {
     class Scene : public ITickable
     {
     public:
+        void preloadInternal();
         void beginPlayInternal();
         void initInternal();
         void tick(float deltaTime) override;
         void tickInternal(float deltaTime);
 
         void shutdownInternal();
+        // Shuts down and destroys up to maxActors actors, newest first, returns true once the scene is fully shut down
+        bool shutdownIncrementalInternal(size_t maxActors);
 
 
         //TODO: Move this out of scene, SceneManager shall handle everything
@@ -20,6 +24,8 @@ namespace Prism::Core
         RawPtr<T> registerActor(std::unique_ptr<T>&& actor)
         {
             const auto& emplacedActor = actors.emplace_back(std::move(actor));
+            emplacedActor->setSceneJournalInternal(&journal);
+            emplacedActor->recordSceneChangeInternal(SceneChangeType::ActorSpawned);
             if (initialized)
             {
                 emplacedActor->initInternal();
@@ -28,10 +34,22 @@ namespace Prism::Core
             return RawPtr<T>(dynamic_cast<T*>(emplacedActor.get()));
         }
 
+        // Avoids regrowing the actor lists when registering many actors at once, e.g. from a scene file
+        void reserveActors(const size_t additionalActors)
+        {
+            actors.reserve(actors.size() + additionalActors);
+            deferredActors.reserve(deferredActors.size() + additionalActors);
+        }
+
         void unregisterActor(RawPtr<Actor> actor);
 
         [[nodiscard]] std::vector<RawPtr<Actor>> getActors() const;
 
+        [[nodiscard]] SceneJournal& getJournal()
+        {
+            return journal;
+        }
+
         template <ExtendsActor T>
         RawPtr<T> getActor() const
         {
@@ -117,6 +135,9 @@ namespace Prism::Core
         }
 
     protected:
+        // Runs before init, on a loader thread when loaded with SceneManager::loadSceneAsync. Meant for loading
+        // assets and building CPU side data, registering actors and anything touching the renderer belongs into init.
+        virtual void preload();
         virtual void init();
         virtual void beginPlay();
         virtual void shutdown();
@@ -125,6 +146,7 @@ namespace Prism::Core
     private:
         std::vector<std::unique_ptr<Actor>> actors;
         std::vector<RawPtr<Actor>> deferredActors;
+        SceneJournal journal;
         bool initialized = false;
     };
 }
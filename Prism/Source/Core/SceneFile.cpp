@@ -0,0 +1,360 @@
+﻿#include "SceneFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#include "StaticMeshComponent.hpp"
+#include "../Assets/AssetManager.hpp"
+#include "../Utilities/ServiceLocator.hpp"
+#include "../Utilities/StopWatch.hpp"
+#include "../Utilities/Logging/Log.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+namespace
+{
+    using Prism::Core::SceneFileActorFlags;
+    using Prism::Core::SceneFileString;
+
+    [[nodiscard]] bool hasFlag(const uint32_t flags, const SceneFileActorFlags flag)
+    {
+        return (flags & static_cast<uint32_t>(flag)) != 0;
+    }
+
+    [[nodiscard]] uint32_t toFlags(const SceneFileActorFlags flag, const bool enabled)
+    {
+        return enabled ? static_cast<uint32_t>(flag) : 0;
+    }
+
+    // Checks that count elements starting at offset are inside the file and suitably aligned for direct access
+    [[nodiscard]] bool isArrayInFile(const uint64_t offset, const uint64_t count, const uint64_t elementSize,
+                                     const uint64_t alignment, const uint64_t fileSize)
+    {
+        return offset <= fileSize && offset % alignment == 0 && count <= (fileSize - offset) / elementSize;
+    }
+
+    // Deduplicates strings, most actors share their name and all of them share a handful of type and asset names
+    class StringTableBuilder
+    {
+    public:
+        SceneFileString add(const std::string& string)
+        {
+            const auto [it, inserted] = strings.try_emplace(string, SceneFileString{});
+            if (inserted)
+            {
+                it->second = {static_cast<uint32_t>(data.size()), static_cast<uint32_t>(string.size())};
+                data.append(string);
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] const std::string& getData() const
+        {
+            return data;
+        }
+
+    private:
+        std::unordered_map<std::string, SceneFileString> strings;
+        std::string data;
+    };
+
+    void writePadding(std::ofstream& stream, const uint64_t targetOffset)
+    {
+        static constexpr std::array<char, Prism::Core::SceneFile::recordAlignment> zeros = {};
+        const auto currentOffset = static_cast<uint64_t>(stream.tellp());
+        stream.write(zeros.data(), static_cast<std::streamsize>(targetOffset - currentOffset));
+    }
+}
+
+std::unique_ptr<Prism::Core::SceneFile> Prism::Core::SceneFile::open(const std::string& fileName)
+{
+    PRISM_PROFILE_SCOPE("SceneFile::open");
+    auto sceneFile = std::unique_ptr<SceneFile>(new SceneFile());
+    sceneFile->mappedFile = Utility::MappedFile::open(fileName);
+    if (!sceneFile->mappedFile)
+    {
+        LOG_ERROR("Failed to open scene file: {}", fileName);
+        return nullptr;
+    }
+    if (!sceneFile->validate())
+    {
+        return nullptr;
+    }
+
+    const auto data = sceneFile->mappedFile->getData();
+    const auto& header = sceneFile->header;
+    const auto actorTypeNames = reinterpret_cast<const SceneFileString*>(data + header.actorTypesOffset);
+    const auto assetNames = reinterpret_cast<const SceneFileString*>(data + header.assetsOffset);
+    sceneFile->actors = reinterpret_cast<const SceneFileActor*>(data + header.actorsOffset);
+
+    // Resolved once per type and asset instead of once per actor
+    const auto actorTypeRegistry = Utility::ServiceLocator::getService<ActorTypeRegistry>();
+    sceneFile->actorFactories.reserve(header.actorTypeCount);
+    for (uint32_t i = 0; i < header.actorTypeCount; ++i)
+    {
+        const auto typeName = std::string(sceneFile->getString(actorTypeNames[i]));
+        const auto factory = actorTypeRegistry->findActorFactory(typeName);
+        if (!factory)
+        {
+            LOG_WARN("Scene file {} contains actors of the unknown type {}, they are skipped", fileName, typeName);
+        }
+        sceneFile->actorFactories.push_back(factory);
+    }
+
+    const auto assetManager = Utility::ServiceLocator::getService<Assets::AssetManager>();
+    sceneFile->staticMeshAssets.reserve(header.assetCount);
+    for (uint32_t i = 0; i < header.assetCount; ++i)
+    {
+        const auto assetName = std::string(sceneFile->getString(assetNames[i]));
+        auto asset = assetManager->getAsset<Assets::StaticMeshAsset>(assetName);
+        if (!asset)
+        {
+            LOG_WARN("Scene file {} references the static mesh {} which failed to load", fileName, assetName);
+        }
+        sceneFile->staticMeshAssets.emplace_back(std::move(asset));
+    }
+
+    LOG_INFO("Opened scene file: {}, actors: {}, actor types: {}, assets: {}", fileName, header.actorCount,
+             header.actorTypeCount, header.assetCount);
+    return sceneFile;
+}
+
+bool Prism::Core::SceneFile::validate()
+{
+    const auto fileName = mappedFile->getFileName();
+    const auto fileSize = static_cast<uint64_t>(mappedFile->getSize());
+    if (fileSize < sizeof(SceneFileHeader))
+    {
+        LOG_ERROR("Scene file {} is too small to be a scene file", fileName);
+        return false;
+    }
+    std::memcpy(&header, mappedFile->getData(), sizeof(SceneFileHeader));
+    if (header.magic != magic || header.version != version)
+    {
+        LOG_ERROR("Scene file {} has an unknown format or version {}, expected version {}", fileName, header.version,
+                  version);
+        return false;
+    }
+
+    if (!isArrayInFile(header.actorTypesOffset, header.actorTypeCount, sizeof(SceneFileString),
+                       alignof(SceneFileString), fileSize) ||
+        !isArrayInFile(header.assetsOffset, header.assetCount, sizeof(SceneFileString), alignof(SceneFileString),
+                       fileSize) ||
+        !isArrayInFile(header.actorsOffset, header.actorCount, sizeof(SceneFileActor), alignof(SceneFileActor),
+                       fileSize) ||
+        !isArrayInFile(header.stringsOffset, header.stringsSize, 1, 1, fileSize))
+    {
+        LOG_ERROR("Scene file {} is truncated or corrupt", fileName);
+        return false;
+    }
+
+    // Checked once up front, so instantiating can trust every index and string range
+    const auto data = mappedFile->getData();
+    const auto isStringValid = [this](const SceneFileString& string)
+    {
+        return string.offset <= header.stringsSize && string.length <= header.stringsSize - string.offset;
+    };
+    const auto actorTypeNames = reinterpret_cast<const SceneFileString*>(data + header.actorTypesOffset);
+    const auto assetNames = reinterpret_cast<const SceneFileString*>(data + header.assetsOffset);
+    const auto actorRecords = reinterpret_cast<const SceneFileActor*>(data + header.actorsOffset);
+    bool valid = std::all_of(actorTypeNames, actorTypeNames + header.actorTypeCount, isStringValid) &&
+        std::all_of(assetNames, assetNames + header.assetCount, isStringValid);
+    for (uint64_t i = 0; valid && i < header.actorCount; ++i)
+    {
+        const auto& record = actorRecords[i];
+        valid = record.typeIndex < header.actorTypeCount && isStringValid(record.name) &&
+            (!hasFlag(record.flags, SceneFileActorFlags::HasStaticMesh) || record.staticMeshAssetIndex == noAsset ||
+                record.staticMeshAssetIndex < header.assetCount);
+    }
+    if (!valid)
+    {
+        LOG_ERROR("Scene file {} contains out of range references", fileName);
+    }
+    return valid;
+}
+
+std::string_view Prism::Core::SceneFile::getString(const SceneFileString& string) const
+{
+    const auto strings = reinterpret_cast<const char*>(mappedFile->getData() + header.stringsOffset);
+    return {strings + string.offset, string.length};
+}
+
+void Prism::Core::SceneFile::instantiate(Scene& scene) const
+{
+    PRISM_PROFILE_SCOPE("SceneFile::instantiate");
+    Utility::StopWatch stopWatch;
+    stopWatch.start();
+
+    scene.reserveActors(header.actorCount);
+    uint64_t instantiatedActors = 0;
+    for (uint64_t i = 0; i < header.actorCount; ++i)
+    {
+        const auto& record = actors[i];
+        const auto factory = actorFactories[record.typeIndex];
+        if (!factory)
+        {
+            continue;
+        }
+
+        auto actor = factory();
+        actor->setName(std::string(getString(record.name)));
+        actor->setActorPosition(glm::vec3(record.position[0], record.position[1], record.position[2]));
+        actor->setActorRotation(glm::quat(record.rotation[3], record.rotation[0], record.rotation[1],
+                                          record.rotation[2]));
+        actor->setActorScale(glm::vec3(record.scale[0], record.scale[1], record.scale[2]));
+
+        if (hasFlag(record.flags, SceneFileActorFlags::HasStaticMesh))
+        {
+            if (const auto staticMeshComponent = actor->getFirstComponentOfType<StaticMeshComponent>())
+            {
+                if (record.staticMeshAssetIndex != noAsset)
+                {
+                    staticMeshComponent->setStaticMeshAsset(staticMeshAssets[record.staticMeshAssetIndex]);
+                }
+                staticMeshComponent->setMeshColor(glm::vec3(record.meshColor[0], record.meshColor[1],
+                                                            record.meshColor[2]));
+                staticMeshComponent->setVisible(hasFlag(record.flags, SceneFileActorFlags::Visible));
+                staticMeshComponent->setCollidable(hasFlag(record.flags, SceneFileActorFlags::Collidable));
+            }
+        }
+        scene.registerActor(std::move(actor));
+        ++instantiatedActors;
+    }
+
+    stopWatch.stop();
+    LOG_INFO("Instantiated {} actors from scene file {} in {:.2f} ms", instantiatedActors, getFileName(),
+             stopWatch.getTimeInMilliseconds());
+}
+
+bool Prism::Core::SceneFile::save(const Scene& scene, const std::string& fileName)
+{
+    PRISM_PROFILE_SCOPE("SceneFile::save");
+    const auto actorTypeRegistry = Utility::ServiceLocator::getService<ActorTypeRegistry>();
+    const auto sceneActors = scene.getActors();
+
+    StringTableBuilder strings;
+    std::vector<SceneFileString> actorTypeNames;
+    std::unordered_map<std::string, uint32_t> actorTypeIndices;
+    std::vector<SceneFileString> assetNames;
+    std::unordered_map<std::string, uint32_t> assetIndices;
+    std::vector<SceneFileActor> records;
+    records.reserve(sceneActors.size());
+    size_t skippedActors = 0;
+
+    for (const auto& actor : sceneActors)
+    {
+        if (!actor->isValid())
+        {
+            continue;
+        }
+        const auto typeName = actorTypeRegistry->findActorTypeName(*actor);
+        if (typeName.empty())
+        {
+            ++skippedActors;
+            continue;
+        }
+        const auto [typeIt, newType] = actorTypeIndices.try_emplace(
+            typeName, static_cast<uint32_t>(actorTypeNames.size()));
+        if (newType)
+        {
+            actorTypeNames.push_back(strings.add(typeName));
+        }
+
+        SceneFileActor record = {};
+        record.typeIndex = typeIt->second;
+        record.name = strings.add(actor->getName());
+        const auto transform = actor->getTransform();
+        const auto& position = transform.getTranslation();
+        const auto& rotation = transform.getRotationQuaternion();
+        const auto& scale = transform.getScale();
+        record.position = {position.x, position.y, position.z};
+        record.rotation = {rotation.x, rotation.y, rotation.z, rotation.w};
+        record.scale = {scale.x, scale.y, scale.z};
+        record.staticMeshAssetIndex = noAsset;
+
+        if (const auto staticMeshComponent = actor->getFirstComponentOfType<StaticMeshComponent>())
+        {
+            record.flags = toFlags(SceneFileActorFlags::HasStaticMesh, true) |
+                toFlags(SceneFileActorFlags::Visible, staticMeshComponent->isVisible()) |
+                toFlags(SceneFileActorFlags::Collidable, staticMeshComponent->isCollidable());
+            const auto meshColor = staticMeshComponent->getMeshColor();
+            record.meshColor = {meshColor.x, meshColor.y, meshColor.z};
+            if (const auto& asset = staticMeshComponent->getStaticMeshAsset())
+            {
+                const auto assetName = asset->getName();
+                const auto [assetIt, newAsset] = assetIndices.try_emplace(
+                    assetName, static_cast<uint32_t>(assetNames.size()));
+                if (newAsset)
+                {
+                    assetNames.push_back(strings.add(assetName));
+                }
+                record.staticMeshAssetIndex = assetIt->second;
+            }
+        }
+        records.push_back(record);
+    }
+
+    if (strings.getData().size() > UINT32_MAX)
+    {
+        LOG_ERROR("Failed to save scene file {}, the string table exceeds 4 GiB", fileName);
+        return false;
+    }
+
+    SceneFileHeader header = {};
+    header.magic = magic;
+    header.version = version;
+    header.actorTypeCount = static_cast<uint32_t>(actorTypeNames.size());
+    header.assetCount = static_cast<uint32_t>(assetNames.size());
+    header.actorCount = records.size();
+    header.actorTypesOffset = sizeof(SceneFileHeader);
+    header.assetsOffset = header.actorTypesOffset + actorTypeNames.size() * sizeof(SceneFileString);
+    header.actorsOffset = alignOffset(header.assetsOffset + assetNames.size() * sizeof(SceneFileString));
+    header.stringsOffset = header.actorsOffset + records.size() * sizeof(SceneFileActor);
+    header.stringsSize = strings.getData().size();
+
+    // Write to a temporary file first so a failed save never leaves a half written scene behind
+    const auto temporaryFileName = fileName + ".tmp";
+    {
+        std::ofstream stream(temporaryFileName, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            LOG_ERROR("Failed to open scene file for writing: {}", temporaryFileName);
+            return false;
+        }
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(actorTypeNames.data()),
+                     static_cast<std::streamsize>(actorTypeNames.size() * sizeof(SceneFileString)));
+        stream.write(reinterpret_cast<const char*>(assetNames.data()),
+                     static_cast<std::streamsize>(assetNames.size() * sizeof(SceneFileString)));
+        writePadding(stream, header.actorsOffset);
+        stream.write(reinterpret_cast<const char*>(records.data()),
+                     static_cast<std::streamsize>(records.size() * sizeof(SceneFileActor)));
+        stream.write(strings.getData().data(), static_cast<std::streamsize>(strings.getData().size()));
+
+        if (!stream)
+        {
+            LOG_ERROR("Failed to write scene file: {}", temporaryFileName);
+            return false;
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryFileName, fileName, errorCode);
+    if (errorCode)
+    {
+        LOG_ERROR("Failed to move scene file to: {}, error: {}", fileName, errorCode.message());
+        std::filesystem::remove(temporaryFileName, errorCode);
+        return false;
+    }
+
+    if (skippedActors > 0)
+    {
+        LOG_WARN("Skipped {} actors of unregistered types while saving scene file {}", skippedActors, fileName);
+    }
+    LOG_INFO("Saved scene file: {}, actors: {}, actor types: {}, assets: {}", fileName, header.actorCount,
+             header.actorTypeCount, header.assetCount);
+    return true;
+}
@@ -0,0 +1,129 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ActorTypeRegistry.hpp"
+#include "Scene.hpp"
+#include "../Assets/AssetHandle.hpp"
+#include "../Assets/StaticMeshAsset.hpp"
+#include "../Utilities/MappedFile.hpp"
+
+namespace Prism::Core
+{
+    // Range inside the string table of a scene file, strings are not null terminated
+    struct SceneFileString
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    /*
+     * Binary layout of a serialized scene (.pscene), memory mapped when loading:
+     * [SceneFileHeader][actor type names][asset names][padding][SceneFileActor records][string table]
+     * Type and asset names are stored once and referenced by index, so the records are fixed size and can be walked
+     * without any parsing.
+     */
+    struct SceneFileHeader
+    {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t actorTypeCount;
+        uint32_t assetCount;
+        uint64_t actorCount;
+        uint64_t actorTypesOffset;
+        uint64_t assetsOffset;
+        uint64_t actorsOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    enum class SceneFileActorFlags : uint32_t
+    {
+        None = 0,
+        HasStaticMesh = 1 << 0,
+        Visible = 1 << 1,
+        Collidable = 1 << 2,
+    };
+
+    struct SceneFileActor
+    {
+        uint32_t typeIndex;
+        SceneFileString name;
+        // Combination of SceneFileActorFlags
+        uint32_t flags;
+        std::array<float, 3> position;
+        // Quaternion as x, y, z, w, avoids the euler angle round trip
+        std::array<float, 4> rotation;
+        std::array<float, 3> scale;
+        // Properties of the first StaticMeshComponent, only valid with SceneFileActorFlags::HasStaticMesh
+        uint32_t staticMeshAssetIndex;
+        std::array<float, 3> meshColor;
+    };
+
+    class SceneFile
+    {
+    public:
+        inline constexpr static std::array<char, 4> magic = {'P', 'S', 'C', 'N'};
+        // Bump whenever the header or the record layout changes
+        inline constexpr static uint32_t version = 1;
+        inline constexpr static uint64_t recordAlignment = 64;
+        inline constexpr static uint32_t noAsset = UINT32_MAX;
+        inline constexpr static std::string_view fileExtension = ".pscene";
+
+        SceneFile(const SceneFile& other) = delete;
+        SceneFile(SceneFile&& other) noexcept = delete;
+        SceneFile& operator=(const SceneFile& other) = delete;
+        SceneFile& operator=(SceneFile&& other) noexcept = delete;
+        ~SceneFile() = default;
+
+        /*
+         * Maps and validates the file, resolves the actor types and loads all referenced assets, each of them once.
+         * Doesn't touch any scene, so it is meant to be called from Scene::preload. Returns nullptr on failure.
+         */
+        [[nodiscard]] static std::unique_ptr<SceneFile> open(const std::string& fileName);
+
+        // Writes all actors of the scene whose type is registered with the ActorTypeRegistry
+        static bool save(const Scene& scene, const std::string& fileName);
+
+        // Creates and registers all actors of the file with the scene, has to run on the main thread
+        void instantiate(Scene& scene) const;
+
+        [[nodiscard]] uint64_t getActorCount() const
+        {
+            return header.actorCount;
+        }
+
+        [[nodiscard]] std::string getFileName() const
+        {
+            return mappedFile->getFileName();
+        }
+
+        [[nodiscard]] static constexpr uint64_t alignOffset(const uint64_t offset)
+        {
+            return (offset + recordAlignment - 1) & ~(recordAlignment - 1);
+        }
+
+    private:
+        SceneFile() = default;
+
+        [[nodiscard]] bool validate();
+        [[nodiscard]] std::string_view getString(const SceneFileString& string) const;
+
+        std::unique_ptr<Utility::MappedFile> mappedFile;
+        SceneFileHeader header = {};
+        const SceneFileActor* actors = nullptr;
+        // Indexed by SceneFileActor::typeIndex, nullptr for types that aren't registered in this build
+        std::vector<ActorTypeRegistry::ActorFactory> actorFactories;
+        // Indexed by SceneFileActor::staticMeshAssetIndex, empty for assets that failed to load
+        std::vector<Assets::AssetHandle<Assets::StaticMeshAsset>> staticMeshAssets;
+    };
+
+    static_assert(sizeof(SceneFileHeader) == 64, "SceneFileHeader layout changed, bump the version!");
+    static_assert(sizeof(SceneFileActor) == 72, "SceneFileActor layout changed, bump the version!");
+    static_assert(std::is_trivially_copyable_v<SceneFileHeader>);
+    static_assert(std::is_trivially_copyable_v<SceneFileActor>);
+}
@@ -0,0 +1,122 @@
+﻿#include "SceneJournal.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // Journals are also created on the loader thread of background scene loads
+    std::atomic<uint64_t> nextJournalId = 1;
+}
+
+Prism::Core::SceneJournal::SceneJournal() : id(nextJournalId.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+uint32_t Prism::Core::SceneJournal::subscribe()
+{
+    ++subscriberCount;
+    const auto freeSlot = std::ranges::find(subscriberCursors, noSequence);
+    if (freeSlot != subscriberCursors.end())
+    {
+        *freeSlot = getNextSequence();
+        return static_cast<uint32_t>(freeSlot - subscriberCursors.begin());
+    }
+    subscriberCursors.push_back(getNextSequence());
+    return static_cast<uint32_t>(subscriberCursors.size() - 1);
+}
+
+void Prism::Core::SceneJournal::unsubscribe(const uint32_t subscriber)
+{
+    if (subscriber >= subscriberCursors.size() || subscriberCursors[subscriber] == noSequence)
+    {
+        return;
+    }
+    subscriberCursors[subscriber] = noSequence;
+    --subscriberCount;
+}
+
+void Prism::Core::SceneJournal::unsubscribeAll()
+{
+    subscriberCursors.clear();
+    subscriberCount = 0;
+    trim();
+}
+
+std::span<const Prism::Core::SceneChange> Prism::Core::SceneJournal::consumeChanges(const uint32_t subscriber)
+{
+    auto& cursor = subscriberCursors[subscriber];
+    const auto firstUnseen = static_cast<size_t>(cursor - firstSequence);
+    cursor = getNextSequence();
+    return std::span(changes).subspan(firstUnseen);
+}
+
+uint64_t Prism::Core::SceneJournal::record(const SceneChangeType type, const RawPtr<Actor> actor,
+                                           const RawPtr<ActorComponent> component)
+{
+    // A scene nobody mirrors costs nothing to change
+    if (subscriberCount == 0)
+    {
+        return noSequence;
+    }
+    changes.push_back({type, actor, component});
+    return getNextSequence() - 1;
+}
+
+bool Prism::Core::SceneJournal::isUnseenByAll(const uint64_t sequence) const
+{
+    return subscriberCount > 0 && sequence < getNextSequence() && sequence >= getNewestCursor();
+}
+
+bool Prism::Core::SceneJournal::isUnseenByAny(const uint64_t sequence) const
+{
+    return subscriberCount > 0 && sequence < getNextSequence() && sequence >= getOldestCursor();
+}
+
+void Prism::Core::SceneJournal::forgetActor(const RawPtr<Actor> actor, const uint64_t fromSequence)
+{
+    if (!isUnseenByAny(fromSequence))
+    {
+        return;
+    }
+    for (auto i = static_cast<size_t>(std::max(fromSequence, getOldestCursor()) - firstSequence);
+         i < changes.size(); ++i)
+    {
+        auto& change = changes[i];
+        if (change.actor == actor)
+        {
+            change.actor = nullptr;
+            change.component = nullptr;
+        }
+    }
+}
+
+void Prism::Core::SceneJournal::trim()
+{
+    const auto seenByAll = subscriberCount > 0 ? getOldestCursor() : getNextSequence();
+    changes.erase(changes.begin(), changes.begin() + static_cast<std::ptrdiff_t>(seenByAll - firstSequence));
+    firstSequence = seenByAll;
+}
+
+uint64_t Prism::Core::SceneJournal::getOldestCursor() const
+{
+    auto oldestCursor = noSequence;
+    for (const auto cursor : subscriberCursors)
+    {
+        oldestCursor = std::min(oldestCursor, cursor);
+    }
+    return oldestCursor;
+}
+
+uint64_t Prism::Core::SceneJournal::getNewestCursor() const
+{
+    uint64_t newestCursor = 0;
+    for (const auto cursor : subscriberCursors)
+    {
+        if (cursor != noSequence)
+        {
+            newestCursor = std::max(newestCursor, cursor);
+        }
+    }
+    return newestCursor;
+}
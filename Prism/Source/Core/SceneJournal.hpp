@@ -0,0 +1,94 @@
+﻿#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../Utilities/Globals.hpp"
+
+namespace Prism::Core
+{
+    class Actor;
+    class ActorComponent;
+
+    enum class SceneChangeType : uint8_t
+    {
+        ActorSpawned,
+        ActorDestroyed,
+        TransformChanged,
+        VisibilityChanged,
+        AssetChanged,
+    };
+
+    struct SceneChange
+    {
+        SceneChangeType type;
+        // nullptr if the actor was destroyed afterwards, ActorDestroyed keeps it but only to identify the actor
+        RawPtr<Actor> actor;
+        // The changed component, nullptr for changes of the actor itself
+        RawPtr<ActorComponent> component;
+    };
+
+    /*
+     * Changes made to a scene, so systems mirroring it only apply what changed instead of walking all actors each
+     * frame. Every subscriber sees each change once, in the order they were made. Nothing is recorded while nobody
+     * subscribed, a subscriber therefore reads the whole scene once when subscribing and the deltas afterwards.
+     * Only to be used from the main thread.
+     */
+    class SceneJournal
+    {
+    public:
+        inline constexpr static uint64_t noSequence = UINT64_MAX;
+
+        SceneJournal();
+
+        // Unique across all journals, tells subscribers when the active scene was replaced
+        [[nodiscard]] uint64_t getId() const
+        {
+            return id;
+        }
+
+        [[nodiscard]] uint32_t subscribe();
+        void unsubscribe(uint32_t subscriber);
+        // Drops all subscribers, e.g. once the scene is replaced and only torn down anymore
+        void unsubscribeAll();
+
+        // Changes the subscriber didn't see yet, the span is valid until the next change is recorded
+        [[nodiscard]] std::span<const SceneChange> consumeChanges(uint32_t subscriber);
+
+        // Returns the sequence number of the change, noSequence if nobody is subscribed
+        uint64_t record(SceneChangeType type, RawPtr<Actor> actor, RawPtr<ActorComponent> component = nullptr);
+
+        // True if no subscriber saw the change yet, recording it again would be redundant
+        [[nodiscard]] bool isUnseenByAll(uint64_t sequence) const;
+        // True if a subscriber is still going to see the change
+        [[nodiscard]] bool isUnseenByAny(uint64_t sequence) const;
+
+        // Clears the actor from its changes starting at fromSequence, subscribers must not touch destroyed actors
+        void forgetActor(RawPtr<Actor> actor, uint64_t fromSequence);
+
+        // Drops the changes every subscriber saw, called once per frame
+        void trim();
+
+        [[nodiscard]] size_t getPendingChangeCount() const
+        {
+            return changes.size();
+        }
+
+    private:
+        [[nodiscard]] uint64_t getNextSequence() const
+        {
+            return firstSequence + changes.size();
+        }
+
+        [[nodiscard]] uint64_t getOldestCursor() const;
+        [[nodiscard]] uint64_t getNewestCursor() const;
+
+        uint64_t id;
+        std::vector<SceneChange> changes;
+        // Sequence number of changes[0]
+        uint64_t firstSequence = 0;
+        // Sequence number of the first change each subscriber didn't see yet, noSequence for free slots
+        std::vector<uint64_t> subscriberCursors;
+        uint32_t subscriberCount = 0;
+    };
+}
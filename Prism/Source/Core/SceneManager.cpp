@@ -2,18 +2,64 @@
 
 #include <stdexcept>
 
+#include "ITimeManager.hpp"
+#include "MeshFactoryRegistry.hpp"
+#include "SpatialIndex.hpp"
+#include "../Assets/AssetManager.hpp"
+#include "../Input/IInputManager.hpp"
+#include "../Rendering/DebugDrawHelper.hpp"
+#include "../Rendering/ICameraManager.hpp"
+#include "../Rendering/IRendererManager.hpp"
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/ServiceLocator.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<uint32_t> cvarTeardownActorsPerFrame(
+        "scene.teardownActorsPerFrame", 128, 1, std::numeric_limits<uint32_t>::max(),
+        "Actors of a replaced scene that are shut down and destroyed per frame after a background scene load");
+}
+
 void Prism::Core::SceneManager::initialize()
 {
 }
 
+void Prism::Core::SceneManager::declareDependencies(Utility::ServiceDependencies& dependencies)
+{
+    // The deferred initialization runs Scene::init, which may use any of these and creates GPU resources
+    dependencies.add<Rendering::IWindowManager>();
+    dependencies.add<Rendering::IRendererManager>();
+    dependencies.add<Rendering::ICameraManager>();
+    dependencies.add<Rendering::DebugDrawHelper>();
+    dependencies.add<Input::IInputManager>();
+    dependencies.add<Assets::AssetManager>();
+    dependencies.add<MeshFactoryRegistry>();
+    dependencies.add<SpatialIndex>();
+    dependencies.add<ITimeManager>();
+    dependencies.requireMainThread();
+}
+
 void Prism::Core::SceneManager::initializeDeferred()
 {
+    activeScene->preloadInternal();
     activeScene->initInternal();
 }
 
 void Prism::Core::SceneManager::deInitialize()
 {
+    // The load uses services that are deinitialized after this one, so it has to finish first
+    if (pendingScene.valid())
+    {
+        pendingScene.wait();
+        pendingScene = {};
+    }
     unloadScene();
+    while (!retiringScenes.empty())
+    {
+        retiringScenes.front()->shutdownInternal();
+        retiringScenes.pop_front();
+    }
 }
 
 void Prism::Core::SceneManager::loadScene(std::unique_ptr<Scene>&& scene)
@@ -24,15 +70,51 @@ void Prism::Core::SceneManager::loadScene(std::unique_ptr<Scene>&& scene)
     }
     unloadScene();
     activeScene = std::move(scene);
+    activeScene->preloadInternal();
     activeScene->initInternal();
     activeScene->beginPlayInternal();
 }
 
+void Prism::Core::SceneManager::loadSceneAsync(std::function<std::unique_ptr<Scene>()> sceneFactory)
+{
+    if (!sceneFactory)
+    {
+        throw std::runtime_error("SceneManager::loadSceneAsync: scene factory is empty");
+    }
+    if (pendingScene.valid())
+    {
+        LOG_WARN("SceneManager::loadSceneAsync: replacing a scene load that is still running");
+        // Discarded on the main thread, scene destructors may release GPU resources
+        pendingScene.wait();
+        pendingScene = {};
+    }
+    // A thread of its own instead of a job system worker: preload blocks on asset loads which may be queued on the
+    // job system themselves, with every worker busy preloading nothing would be left to run them
+    pendingScene = std::async(std::launch::async, [sceneFactory = std::move(sceneFactory)]
+    {
+        PRISM_PROFILE_THREAD("SceneLoader");
+        auto scene = sceneFactory();
+        if (!scene)
+        {
+            throw std::runtime_error("SceneManager::loadSceneAsync: scene factory returned nullptr");
+        }
+        scene->preloadInternal();
+        return scene;
+    });
+}
+
 void Prism::Core::SceneManager::tick(const float deltaTime)
 {
+    // Frame boundary, nothing of the current frame refers to the old scene yet
+    switchToLoadedScene();
     activeScene->tickInternal(deltaTime);
     processPendingSpawnActors();
     processPendingKillActors();
+    auto& journal = activeScene->getJournal();
+    // After everything moved this frame, so queries until the next tick see final bounds
+    Utility::ServiceLocator::getService<SpatialIndex>()->update(journal);
+    journal.trim();
+    retireScenes();
 }
 
 RawPtr<Prism::Core::Actor> Prism::Core::SceneManager::registerActorInternal(std::unique_ptr<Actor>&& actor)
@@ -58,6 +140,54 @@ void Prism::Core::SceneManager::unloadScene()
     }
 }
 
+void Prism::Core::SceneManager::switchToLoadedScene()
+{
+    if (!pendingScene.valid() || pendingScene.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+    std::unique_ptr<Scene> loadedScene;
+    try
+    {
+        loadedScene = pendingScene.get();
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Background scene load failed, keeping the current scene: {}", e.what());
+        return;
+    }
+
+    PRISM_PROFILE_SCOPE("SceneManager::switchToLoadedScene");
+    // Spawns and kills requested for the old scene die with it
+    pendingSpawnActors.clear();
+    pendingKillActors.clear();
+    if (activeScene)
+    {
+        // Subscribers follow the active scene, the teardown is of no interest to them
+        activeScene->getJournal().unsubscribeAll();
+        retiringScenes.push_back(std::move(activeScene));
+        // The retiring actors are destroyed over the next frames, they must not show up in queries until then
+        Utility::ServiceLocator::getService<SpatialIndex>()->clear();
+    }
+    activeScene = std::move(loadedScene);
+    // Assets are already in memory from the preload, what is left here are mostly the GPU uploads
+    activeScene->initInternal();
+    activeScene->beginPlayInternal();
+}
+
+void Prism::Core::SceneManager::retireScenes()
+{
+    if (retiringScenes.empty())
+    {
+        return;
+    }
+    PRISM_PROFILE_SCOPE("SceneManager::retireScenes");
+    if (retiringScenes.front()->shutdownIncrementalInternal(cvarTeardownActorsPerFrame.get()))
+    {
+        retiringScenes.pop_front();
+    }
+}
+
 void Prism::Core::SceneManager::processPendingSpawnActors()
 {
     for (auto& actor : pendingSpawnActors)
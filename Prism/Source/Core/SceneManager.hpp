@@ -1,4 +1,7 @@
 ﻿#pragma once
+#include <deque>
+#include <future>
+
 #include "Actor.hpp"
 #include "ISceneManager.hpp"
 #include "Scene.hpp"
@@ -12,7 +15,15 @@ namespace Prism::Core
         void initialize() override;
         void initializeDeferred() override;
         void deInitialize() override;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override;
         void loadScene(std::unique_ptr<Scene>&& scene) override;
+        void loadSceneAsync(std::function<std::unique_ptr<Scene>()> sceneFactory) override;
+
+        [[nodiscard]] bool isLoadingScene() const override
+        {
+            return pendingScene.valid();
+        }
+
         void tick(float deltaTime) override;
 
         RawPtr<Actor> registerActorInternal(std::unique_ptr<Actor>&& actor) override;
@@ -33,8 +44,13 @@ namespace Prism::Core
         std::unique_ptr<Scene> activeScene = std::make_unique<Scene>();
         std::vector<std::unique_ptr<Actor>> pendingSpawnActors;
         std::vector<RawPtr<Actor>> pendingKillActors;
+        std::future<std::unique_ptr<Scene>> pendingScene;
+        // Previous scenes that are shut down over multiple frames, oldest first
+        std::deque<std::unique_ptr<Scene>> retiringScenes;
 
         void unloadScene();
+        void switchToLoadedScene();
+        void retireScenes();
         void processPendingSpawnActors();
         void processPendingKillActors();
     };
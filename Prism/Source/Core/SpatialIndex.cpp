@@ -0,0 +1,224 @@
+﻿#include "SpatialIndex.hpp"
+
+#include <algorithm>
+
+#include "Actor.hpp"
+#include "StaticMeshComponent.hpp"
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<float> cvarBoundsMargin(
+        "spatial.boundsMargin", 0.1f, 0.0f, 100.0f,
+        "Distance by which bounds in the spatial index are enlarged, components moving less don't touch the tree");
+}
+
+Prism::Core::SpatialIndex::SpatialIndex() : tree(cvarBoundsMargin.get())
+{
+}
+
+void Prism::Core::SpatialIndex::deInitialize()
+{
+    clear();
+}
+
+Prism::Core::SpatialIndexHandle Prism::Core::SpatialIndex::registerComponent(
+    const RawPtr<StaticMeshComponent> component)
+{
+    uint32_t entryIndex;
+    if (freeEntries.empty())
+    {
+        entryIndex = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+    }
+    else
+    {
+        entryIndex = freeEntries.back();
+        freeEntries.pop_back();
+    }
+
+    auto& entry = entries[entryIndex];
+    entry.component = component;
+    entry.bounds = computeBounds(*component);
+    entry.transformVersion = component->getAbsoluteTransformVersion();
+    entry.proxyId = tree.createProxy(entry.bounds, entryIndex);
+    return {entryIndex, entry.generation};
+}
+
+void Prism::Core::SpatialIndex::unregisterComponent(const SpatialIndexHandle& handle)
+{
+    if (!findEntry(handle))
+    {
+        return;
+    }
+    auto& entry = entries[handle.entry];
+    tree.destroyProxy(entry.proxyId);
+    entry = {RawPtr<StaticMeshComponent>(), Aabb(), 0, DynamicAabbTree::nullNode, entry.generation + 1};
+    freeEntries.push_back(handle.entry);
+}
+
+void Prism::Core::SpatialIndex::update(SceneJournal& journal)
+{
+    PRISM_PROFILE_SCOPE("SpatialIndex::update");
+    tree.setMargin(cvarBoundsMargin.get());
+    if (journal.getId() != journalId)
+    {
+        // Components may have moved between registering and now, before anybody was listening
+        journalId = journal.getId();
+        journalSubscriber = journal.subscribe();
+        for (auto& entry : entries)
+        {
+            if (entry.proxyId != DynamicAabbTree::nullNode)
+            {
+                refitEntry(entry);
+            }
+        }
+        return;
+    }
+    // A static scene has no changes, which makes this free no matter how many components there are
+    for (const auto& change : journal.consumeChanges(journalSubscriber))
+    {
+        if (change.type != SceneChangeType::TransformChanged || !change.actor)
+        {
+            continue;
+        }
+        if (change.component)
+        {
+            if (const auto staticMeshComponent = dynamic_cast<const StaticMeshComponent*>(change.component.get()))
+            {
+                refitComponent(*staticMeshComponent);
+            }
+            continue;
+        }
+        change.actor->forEachComponentOfType<StaticMeshComponent>([this](const StaticMeshComponent& component)
+        {
+            refitComponent(component);
+        });
+    }
+}
+
+void Prism::Core::SpatialIndex::clear()
+{
+    // The journal belongs to the replaced scene, it drops its subscribers itself
+    journalId = 0;
+    tree.clear();
+    freeEntries.clear();
+    for (uint32_t i = 0; i < entries.size(); ++i)
+    {
+        auto& entry = entries[i];
+        entry = {RawPtr<StaticMeshComponent>(), Aabb(), 0, DynamicAabbTree::nullNode, entry.generation + 1};
+        freeEntries.push_back(i);
+    }
+}
+
+void Prism::Core::SpatialIndex::queryOverlap(const Aabb& aabb,
+                                             std::vector<RawPtr<StaticMeshComponent>>& outComponents) const
+{
+    tree.queryAabb(aabb, [&](const uint32_t entryIndex)
+    {
+        const auto& entry = entries[entryIndex];
+        if (entry.bounds.overlaps(aabb))
+        {
+            outComponents.push_back(entry.component);
+        }
+        return true;
+    });
+}
+
+void Prism::Core::SpatialIndex::querySphere(const glm::vec3& center, const float radius,
+                                            std::vector<RawPtr<StaticMeshComponent>>& outComponents) const
+{
+    tree.querySphere(center, radius, [&](const uint32_t entryIndex)
+    {
+        const auto& entry = entries[entryIndex];
+        if (entry.bounds.overlapsSphere(center, radius))
+        {
+            outComponents.push_back(entry.component);
+        }
+        return true;
+    });
+}
+
+void Prism::Core::SpatialIndex::queryFrustum(const Frustum& frustum,
+                                             std::vector<RawPtr<StaticMeshComponent>>& outComponents) const
+{
+    PRISM_PROFILE_SCOPE("SpatialIndex::queryFrustum");
+    tree.queryFrustum(frustum, [&](const uint32_t entryIndex)
+    {
+        const auto& entry = entries[entryIndex];
+        if (frustum.test(entry.bounds) != FrustumContainment::Outside)
+        {
+            outComponents.push_back(entry.component);
+        }
+        return true;
+    });
+}
+
+void Prism::Core::SpatialIndex::raycast(const Ray& ray, const float maxDistance,
+                                        std::vector<SpatialRaycastHit>& outHits) const
+{
+    const auto firstHit = outHits.size();
+    tree.raycast(ray, maxDistance, [&](const uint32_t entryIndex, float)
+    {
+        const auto& entry = entries[entryIndex];
+        if (const auto distance = entry.bounds.intersectRay(ray, maxDistance))
+        {
+            outHits.push_back({entry.component, *distance});
+        }
+        return maxDistance;
+    });
+    std::sort(outHits.begin() + static_cast<std::ptrdiff_t>(firstHit), outHits.end(),
+              [](const SpatialRaycastHit& a, const SpatialRaycastHit& b)
+              {
+                  return a.distance < b.distance;
+              });
+}
+
+std::optional<Prism::Core::SpatialRaycastHit> Prism::Core::SpatialIndex::raycastClosest(
+    const Ray& ray, const float maxDistance) const
+{
+    std::optional<SpatialRaycastHit> closestHit;
+    tree.raycast(ray, maxDistance, [&](const uint32_t entryIndex, float)
+    {
+        const auto& entry = entries[entryIndex];
+        const auto closestDistance = closestHit ? closestHit->distance : maxDistance;
+        if (const auto distance = entry.bounds.intersectRay(ray, closestDistance))
+        {
+            closestHit = SpatialRaycastHit{entry.component, *distance};
+            // Only boxes in front of this hit are of interest from now on
+            return *distance;
+        }
+        return closestDistance;
+    });
+    return closestHit;
+}
+
+Prism::Core::Aabb Prism::Core::SpatialIndex::computeBounds(StaticMeshComponent& component)
+{
+    const auto& meshAsset = component.getStaticMeshAsset();
+    const Aabb localBounds = {meshAsset->getBoundsMin(), meshAsset->getBoundsMax()};
+    return localBounds.transformed(component.getAbsoluteTransform().toMatrix());
+}
+
+void Prism::Core::SpatialIndex::refitEntry(Entry& entry)
+{
+    // Changes are recorded per actor and component, both may report the same move
+    const auto transformVersion = entry.component->getAbsoluteTransformVersion();
+    if (transformVersion == entry.transformVersion)
+    {
+        return;
+    }
+    entry.transformVersion = transformVersion;
+    entry.bounds = computeBounds(*entry.component);
+    tree.moveProxy(entry.proxyId, entry.bounds);
+}
+
+void Prism::Core::SpatialIndex::refitComponent(const StaticMeshComponent& component)
+{
+    const auto& handle = component.getSpatialIndexHandle();
+    if (findEntry(handle))
+    {
+        refitEntry(entries[handle.entry]);
+    }
+}
@@ -0,0 +1,154 @@
+﻿#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Bounds.hpp"
+#include "DynamicAabbTree.hpp"
+#include "SceneJournal.hpp"
+#include "../Utilities/Globals.hpp"
+#include "../Utilities/IService.hpp"
+
+namespace Prism::Core
+{
+    class StaticMeshComponent;
+
+    // Registration of a component, handles from before SpatialIndex::clear are ignored
+    struct SpatialIndexHandle
+    {
+        uint32_t entry = UINT32_MAX;
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool isValid() const
+        {
+            return entry != UINT32_MAX;
+        }
+    };
+
+    struct SpatialRaycastHit
+    {
+        RawPtr<StaticMeshComponent> component;
+        // Distance along the ray at which it enters the component's bounds
+        float distance = 0.0f;
+    };
+
+    /*
+     * Bounding volume hierarchy over the world bounds of all static mesh components of the active scene.
+     * Bounds are in the space the renderer draws in, i.e. of the component's absolute transform matrix, so frustum
+     * queries can use the camera's projection * view matrix directly. Only to be used from the main thread.
+     */
+    class SpatialIndex : public Utility::IService
+    {
+    public:
+        SpatialIndex();
+        ~SpatialIndex() override = default;
+
+        void initialize() override
+        {
+        }
+
+        void initializeDeferred() override
+        {
+        }
+
+        void deInitialize() override;
+
+        // Called by StaticMeshComponent once it has a mesh, the bounds come from its mesh asset
+        [[nodiscard]] SpatialIndexHandle registerComponent(RawPtr<StaticMeshComponent> component);
+        void unregisterComponent(const SpatialIndexHandle& handle);
+
+        // Refits the bounds of the components the journal reports as moved, called once per frame after the scene ticked
+        void update(SceneJournal& journal);
+
+        // Drops all components at once, e.g. when the active scene is replaced
+        void clear();
+
+        // The query functions append to the output vectors, so callers can reuse them across frames
+        void queryOverlap(const Aabb& aabb, std::vector<RawPtr<StaticMeshComponent>>& outComponents) const;
+        void querySphere(const glm::vec3& center, float radius,
+                         std::vector<RawPtr<StaticMeshComponent>>& outComponents) const;
+        void queryFrustum(const Frustum& frustum, std::vector<RawPtr<StaticMeshComponent>>& outComponents) const;
+        // All hits sorted by distance
+        void raycast(const Ray& ray, float maxDistance, std::vector<SpatialRaycastHit>& outHits) const;
+        [[nodiscard]] std::optional<SpatialRaycastHit> raycastClosest(const Ray& ray, float maxDistance) const;
+
+        // Returns nullptr for handles that were unregistered or cleared
+        [[nodiscard]] RawPtr<StaticMeshComponent> getComponent(const SpatialIndexHandle& handle) const
+        {
+            const auto entry = findEntry(handle);
+            return entry ? entry->component : RawPtr<StaticMeshComponent>();
+        }
+
+        // Exact world bounds as of the last update, nullptr for stale handles
+        [[nodiscard]] const Aabb* getBounds(const SpatialIndexHandle& handle) const
+        {
+            const auto entry = findEntry(handle);
+            return entry ? &entry->bounds : nullptr;
+        }
+
+        // callback(handle, component, bounds) for every registered component
+        template <typename Callback>
+        void forEachComponent(Callback&& callback) const
+        {
+            for (uint32_t i = 0; i < entries.size(); ++i)
+            {
+                const auto& entry = entries[i];
+                if (entry.proxyId != DynamicAabbTree::nullNode)
+                {
+                    callback(SpatialIndexHandle{i, entry.generation}, entry.component, entry.bounds);
+                }
+            }
+        }
+
+        [[nodiscard]] size_t getComponentCount() const
+        {
+            return tree.getProxyCount();
+        }
+
+        [[nodiscard]] int32_t getTreeHeight() const
+        {
+            return tree.getHeight();
+        }
+
+        std::string getFullName() override
+        {
+            return "Prism::Core::SpatialIndex";
+        }
+
+    private:
+        struct Entry
+        {
+            RawPtr<StaticMeshComponent> component;
+            // Exact bounds, the tree only stores enlarged ones
+            Aabb bounds;
+            uint64_t transformVersion = 0;
+            int32_t proxyId = DynamicAabbTree::nullNode;
+            uint32_t generation = 0;
+        };
+
+        [[nodiscard]] static Aabb computeBounds(StaticMeshComponent& component);
+        void refitEntry(Entry& entry);
+        void refitComponent(const StaticMeshComponent& component);
+
+        [[nodiscard]] const Entry* findEntry(const SpatialIndexHandle& handle) const
+        {
+            if (!handle.isValid() || handle.entry >= entries.size())
+            {
+                return nullptr;
+            }
+            const auto& entry = entries[handle.entry];
+            if (entry.generation != handle.generation || entry.proxyId == DynamicAabbTree::nullNode)
+            {
+                return nullptr;
+            }
+            return &entry;
+        }
+
+        DynamicAabbTree tree;
+        std::vector<Entry> entries;
+        std::vector<uint32_t> freeEntries;
+        // Journal of the scene the components belong to, 0 until the first update after a clear
+        uint64_t journalId = 0;
+        uint32_t journalSubscriber = 0;
+    };
+}
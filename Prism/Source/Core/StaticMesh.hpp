@@ -6,7 +6,7 @@ namespace Prism::Core
     class StaticMesh : public Mesh
     {
     public:
-        explicit StaticMesh(const RawPtr<Assets::StaticMeshAsset> staticMeshAsset, const uint64_t meshId)
+        explicit StaticMesh(const Assets::AssetHandle<Assets::StaticMeshAsset>& staticMeshAsset, const uint64_t meshId)
             : Mesh(staticMeshAsset, meshId)
         {
         }
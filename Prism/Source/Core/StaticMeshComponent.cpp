@@ -1,4 +1,5 @@
 ﻿#include "StaticMeshComponent.hpp"
+#include "Actor.hpp"
 #include "../Utilities/ServiceLocator.hpp"
 #include "MeshFactoryRegistry.hpp"
 #include "StaticMeshFactory.hpp"
@@ -6,20 +7,14 @@
 
 Prism::Core::StaticMeshComponent::~StaticMeshComponent()
 {
-    if (staticMesh)
-    {
-        Utility::ServiceLocator::getService<Rendering::IRendererManager>()->getRenderer()->
-                                                                            unregisterStaticMesh(
-                                                                                staticMesh->getMeshId());
-    }
+    releaseStaticMesh();
 }
 
 void Prism::Core::StaticMeshComponent::init()
 {
     ActorComponent::init();
-    const auto staticMeshFactory = Utility::ServiceLocator::getService<MeshFactoryRegistry>()->
-        getMeshFactory<StaticMeshFactory>();
-    staticMesh = staticMeshFactory->createMesh(staticMeshAsset);
+    initialized = true;
+    createStaticMesh();
 }
 
 void Prism::Core::StaticMeshComponent::initDeferred()
@@ -31,3 +26,63 @@ void Prism::Core::StaticMeshComponent::shutdown()
 {
     ActorComponent::shutdown();
 }
+
+void Prism::Core::StaticMeshComponent::setVisible(const bool visible)
+{
+    if (this->visible == visible)
+    {
+        return;
+    }
+    this->visible = visible;
+    if (const auto parent = getParent())
+    {
+        parent->recordSceneChangeInternal(SceneChangeType::VisibilityChanged, this);
+    }
+}
+
+void Prism::Core::StaticMeshComponent::setStaticMeshAsset(
+    const Assets::AssetHandle<Assets::StaticMeshAsset>& meshAsset)
+{
+    if (staticMeshAsset == meshAsset)
+    {
+        return;
+    }
+    staticMeshAsset = meshAsset;
+    // Before init the mesh is created by init itself
+    if (initialized)
+    {
+        releaseStaticMesh();
+        createStaticMesh();
+    }
+    if (const auto parent = getParent())
+    {
+        parent->recordSceneChangeInternal(SceneChangeType::AssetChanged, this);
+    }
+}
+
+void Prism::Core::StaticMeshComponent::createStaticMesh()
+{
+    const auto staticMeshFactory = Utility::ServiceLocator::getService<MeshFactoryRegistry>()->
+        getMeshFactory<StaticMeshFactory>();
+    staticMesh = staticMeshFactory->createMesh(staticMeshAsset);
+    if (staticMesh)
+    {
+        spatialIndexHandle = Utility::ServiceLocator::getService<SpatialIndex>()->registerComponent(this);
+    }
+}
+
+void Prism::Core::StaticMeshComponent::releaseStaticMesh()
+{
+    if (spatialIndexHandle.isValid())
+    {
+        Utility::ServiceLocator::getService<SpatialIndex>()->unregisterComponent(spatialIndexHandle);
+        spatialIndexHandle = {};
+    }
+    if (staticMesh)
+    {
+        Utility::ServiceLocator::getService<Rendering::IRendererManager>()->getRenderer()->
+                                                                            unregisterStaticMesh(
+                                                                                staticMesh->getMeshId());
+        staticMesh.reset();
+    }
+}
@@ -1,7 +1,9 @@
 ﻿#pragma once
 
 #include "ActorComponent.hpp"
+#include "SpatialIndex.hpp"
 #include "../Core/StaticMesh.hpp"
+#include "../Assets/AssetHandle.hpp"
 #include "../Assets/StaticMeshAsset.hpp"
 
 namespace Prism::Core
@@ -26,10 +28,7 @@ namespace Prism::Core
             return visible;
         }
 
-        void setVisible(const bool visible)
-        {
-            this->visible = visible;
-        }
+        void setVisible(bool visible);
 
         [[nodiscard]] bool isCollidable() const
         {
@@ -41,14 +40,17 @@ namespace Prism::Core
             this->collidable = collidable;
         }
 
-        [[nodiscard]] RawPtr<Assets::StaticMeshAsset> getStaticMeshAsset() const
+        [[nodiscard]] const Assets::AssetHandle<Assets::StaticMeshAsset>& getStaticMeshAsset() const
         {
             return staticMeshAsset;
         }
 
-        void setStaticMeshAsset(const RawPtr<Assets::StaticMeshAsset> meshAsset)
+        // Can be called after init, e.g. once an asynchronously requested asset finished loading
+        void setStaticMeshAsset(const Assets::AssetHandle<Assets::StaticMeshAsset>& meshAsset);
+
+        [[nodiscard]] const SpatialIndexHandle& getSpatialIndexHandle() const
         {
-            this->staticMeshAsset = meshAsset;
+            return spatialIndexHandle;
         }
 
         [[nodiscard]] RawPtr<StaticMesh> getStaticMesh() const
@@ -67,10 +69,15 @@ namespace Prism::Core
         }
 
     private:
+        void createStaticMesh();
+        void releaseStaticMesh();
+
+        bool initialized = false;
         bool visible = true;
         bool collidable = true;
-        RawPtr<Assets::StaticMeshAsset> staticMeshAsset;
+        Assets::AssetHandle<Assets::StaticMeshAsset> staticMeshAsset;
         std::unique_ptr<StaticMesh> staticMesh;
+        SpatialIndexHandle spatialIndexHandle;
         glm::vec3 meshColor;
     };
 }
@@ -1,17 +1,15 @@
 ﻿#include "StaticMeshFactory.hpp"
-#include "../Rendering/IRendererManager.hpp"
-#include "../Utilities/ServiceLocator.hpp"
 
 namespace Prism::Core
 {
     std::unique_ptr<StaticMesh> StaticMeshFactory::createMesh(
-        const RawPtr<Assets::StaticMeshAsset> staticMeshAsset)
+        const Assets::AssetHandle<Assets::StaticMeshAsset>& staticMeshAsset)
     {
         if (!staticMeshAsset)
         {
             return nullptr;
         }
-        const auto renderer = Utility::ServiceLocator::getService<Rendering::IRendererManager>()->getRenderer();
+        const auto renderer = rendererManager->getRenderer();
         // assign current meshId, then increment it
         auto staticMesh = std::make_unique<StaticMesh>(staticMeshAsset, meshIdCounter);
         ++meshIdCounter;
@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "IMeshFactory.hpp"
 #include "StaticMesh.hpp"
+#include "../Rendering/IRendererManager.hpp"
+#include "../Utilities/ServiceLocator.hpp"
 
 namespace Prism::Core
 {
@@ -10,9 +12,11 @@ namespace Prism::Core
         StaticMeshFactory() = default;
         ~StaticMeshFactory() override = default;
 
-        [[nodiscard]] std::unique_ptr<StaticMesh> createMesh(RawPtr<Assets::StaticMeshAsset> staticMeshAsset) override;
+        [[nodiscard]] std::unique_ptr<StaticMesh> createMesh(
+            const Assets::AssetHandle<Assets::StaticMeshAsset>& staticMeshAsset) override;
 
     private:
         uint64_t meshIdCounter = 0;
+        Utility::ServiceRef<Rendering::IRendererManager> rendererManager;
     };
 }
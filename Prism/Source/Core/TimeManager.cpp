@@ -1,7 +1,21 @@
 ﻿#include "TimeManager.hpp"
+#include "../Utilities/CommandLineArgsManager.hpp"
+#include "../Utilities/ServiceLocator.hpp"
 
 void Prism::Core::TimeManager::initialize()
 {
+    const auto commandLineArgsManager = Utility::ServiceLocator::getService<Utility::CommandLineArgsManager>();
+    frameStatistics.setWindowSize(commandLineArgsManager->getArgValueAsUInt32(
+        "frame-stats-window", static_cast<uint32_t>(Utility::FrameStatistics::defaultWindowSize)));
+    if (commandLineArgsManager->hasArg("frame-stats-csv"))
+    {
+        frameStatistics.startCsvStream(commandLineArgsManager->getArgValue("frame-stats-csv"));
+    }
+}
+
+void Prism::Core::TimeManager::declareDependencies(Utility::ServiceDependencies& dependencies)
+{
+    dependencies.add<Utility::CommandLineArgsManager>();
 }
 
 void Prism::Core::TimeManager::initializeDeferred()
@@ -10,4 +24,5 @@ void Prism::Core::TimeManager::initializeDeferred()
 
 void Prism::Core::TimeManager::deInitialize()
 {
+    frameStatistics.stopCsvStream();
 }
@@ -12,14 +12,21 @@ namespace Prism::Core
         void initialize() override;
         void initializeDeferred() override;
         void deInitialize() override;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override;
 
         std::string getFullName() override
         {
             return "Prism::Core::TimeManager";
         }
 
+        [[nodiscard]] Utility::FrameStatistics& getFrameStatistics() override
+        {
+            return frameStatistics;
+        }
+
 
     private:
         Utility::EngineClock clock;
+        Utility::FrameStatistics frameStatistics;
     };
 }
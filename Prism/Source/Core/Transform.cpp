@@ -17,6 +17,7 @@ namespace Prism::Core
 void Prism::Core::Transform::translate(const glm::vec3& deltaTranslation)
 {
     needsUpdate = true;
+    ++version;
     position += deltaTranslation;
 }
 
@@ -28,6 +29,7 @@ void Prism::Core::Transform::translate(const float deltaX, const float deltaY, c
 void Prism::Core::Transform::rotate(const glm::quat& deltaRotation)
 {
     needsUpdate = true;
+    ++version;
     rotation = deltaRotation * rotation;
 }
 
@@ -56,6 +58,7 @@ void Prism::Core::Transform::rotate(const glm::vec3& deltaRotationDegrees)
 void Prism::Core::Transform::scale(const glm::vec3& deltaScale)
 {
     needsUpdate = true;
+    ++version;
     scaleVec *= deltaScale;
 }
 
@@ -72,6 +75,7 @@ void Prism::Core::Transform::scale(const float factor)
 void Prism::Core::Transform::grow(const glm::vec3& deltaScale)
 {
     needsUpdate = true;
+    ++version;
     scaleVec += deltaScale;
 }
 
@@ -88,6 +92,7 @@ void Prism::Core::Transform::grow(const float factor)
 void Prism::Core::Transform::setTranslation(const glm::vec3& translation)
 {
     needsUpdate = true;
+    ++version;
     position = translation;
 }
 
@@ -114,6 +119,7 @@ void Prism::Core::Transform::setTranslationZ(const float z)
 void Prism::Core::Transform::setRotation(const glm::quat& rot)
 {
     needsUpdate = true;
+    ++version;
     rotation = rot;
 }
 
@@ -140,6 +146,7 @@ void Prism::Core::Transform::setRotation(const glm::vec3& rotationDegrees)
 void Prism::Core::Transform::setScale(const glm::vec3& scale)
 {
     needsUpdate = true;
+    ++version;
     scaleVec = scale;
 }
 
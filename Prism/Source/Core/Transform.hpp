@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <cstdint>
 #include <glm/vec3.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -44,6 +45,12 @@ namespace Prism::Core
         glm::mat4x4 toMatrix(bool isCamera = false);
         Transform combineWithParent(Transform& parent);
 
+        // Incremented by every change, lets caches of derived data like world bounds skip unchanged transforms
+        [[nodiscard]] uint32_t getVersion() const
+        {
+            return version;
+        }
+
         [[nodiscard]] glm::vec3 forward() const;
         [[nodiscard]] glm::vec3 up() const;
         [[nodiscard]] glm::vec3 right() const;
@@ -57,6 +64,7 @@ namespace Prism::Core
 
     private:
         bool needsUpdate = true;
+        uint32_t version = 0;
         // 1.0f = Identity Matrix
         glm::mat4x4 worldMatrix = glm::mat4x4(1.0f);
 
@@ -18,6 +18,12 @@ void Prism::Input::GlfwInputManager::initialize()
 {
 }
 
+void Prism::Input::GlfwInputManager::declareDependencies(Utility::ServiceDependencies& dependencies)
+{
+    IInputManager::declareDependencies(dependencies);
+    dependencies.requireMainThread();
+}
+
 void Prism::Input::GlfwInputManager::initializeDeferred()
 {
     // We are safe here to cast this to GlfwWindow as this InputManager is only used with GLFW. Nevertheless, still do a sanity check!
@@ -29,7 +35,7 @@ void Prism::Input::GlfwInputManager::initializeDeferred()
     glfwWindow = window->getGLFWWindow();
 }
 
-void Prism::Input::GlfwInputManager::initCursorCallback()
+void Prism::Input::GlfwInputManager::initInputCallbacks()
 {
     // We are safe here to cast this to GlfwWindow as this InputManager is only used with GLFW. Nevertheless, still do a sanity check!
     const auto window = dynamic_cast<Rendering::GlfwWindow*>(windowManager->getWindow().get());
@@ -37,89 +43,63 @@ void Prism::Input::GlfwInputManager::initCursorCallback()
     {
         throw std::runtime_error("Expected the current window to be of type GLFWwindow*!");
     }
-    glfwSetCursorPosCallback(
-        window->getGLFWWindow(), [](GLFWwindow* window, const double xPos, const double yPos)
-        {
-            if (ImGui::GetIO().WantCaptureMouse)
-            {
-                return;
-            }
-            size_t dead = 0;
-            const auto inputManager = Utility::ServiceLocator::getService<IInputManager>();
-            for (auto& callback : inputManager->getMouseMovementCallbacksInternal())
-            {
-                if (callback)
-                {
-                    callback(xPos, yPos);
-                }
-                else
-                {
-                    ++dead;
-                }
-            }
-            inputManager->setDeadMouseCallbacksInternal(dead);
-        });
+    callbackInstance = this;
+    // The callbacks only record the events, they are applied in processInputEvents
+    glfwSetKeyCallback(window->getGLFWWindow(), onKey);
+    glfwSetMouseButtonCallback(window->getGLFWWindow(), onMouseButton);
+    glfwSetCursorPosCallback(window->getGLFWWindow(), onCursorPosition);
 }
 
 void Prism::Input::GlfwInputManager::deInitialize()
 {
+    if (callbackInstance == this)
+    {
+        callbackInstance = nullptr;
+    }
 }
 
-void Prism::Input::GlfwInputManager::registerMouseMovementInput(
-    const std::function<void(double xPos, double yPos)>& callback)
-{
-    mouseMovementCallbacks.emplace_back(callback);
-}
-
-bool Prism::Input::GlfwInputManager::isKeyDown(const InputKey key) const
+void Prism::Input::GlfwInputManager::processInputEvents()
 {
-    return isKeyPressed(key);
+    // Sampled once per frame instead of on every query
+    const auto& io = ImGui::GetIO();
+    inputState.setCaptured(io.WantCaptureKeyboard, io.WantCaptureMouse);
+    IInputManager::processInputEvents();
 }
 
-bool Prism::Input::GlfwInputManager::isKeyPressed(const InputKey key) const
+void Prism::Input::GlfwInputManager::onKey(GLFWwindow* window, const int key, int scanCode, const int action,
+                                           int mods)
 {
-    if (ImGui::GetIO().WantCaptureKeyboard)
+    // Repeats don't change the key state
+    if (!callbackInstance || action == GLFW_REPEAT)
     {
-        return false;
+        return;
     }
-    return glfwGetKey(glfwWindow, mapInputKeyToGlfwKey(key)) == GLFW_PRESS;
-}
-
-bool Prism::Input::GlfwInputManager::isKeyReleased(const InputKey key) const
-{
-    if (ImGui::GetIO().WantCaptureKeyboard)
+    const InputKey inputKey = callbackInstance->mapGlfwKeyToInputKey(key);
+    if (inputKey == InputKey::UNKNOWN)
     {
-        return false;
+        return;
     }
-    return glfwGetKey(glfwWindow, mapInputKeyToGlfwKey(key)) == GLFW_RELEASE;
+    callbackInstance->inputState.queueEvent(InputEvent::keyEvent(inputKey, action == GLFW_PRESS));
 }
 
-bool Prism::Input::GlfwInputManager::isMouseButtonDown(const MouseButton button) const
+void Prism::Input::GlfwInputManager::onMouseButton(GLFWwindow* window, const int button, const int action, int mods)
 {
-    if (ImGui::GetIO().WantCaptureMouse)
+    // GLFW numbers its buttons in the same order as MouseButton
+    if (!callbackInstance || button < 0 || button >= static_cast<int>(mouseButtonCount))
     {
-        return false;
+        return;
     }
-    return glfwGetMouseButton(glfwWindow, mapMouseButtonToGlfwButton(button)) == GLFW_PRESS;
+    callbackInstance->inputState.queueEvent(
+        InputEvent::mouseButtonEvent(static_cast<MouseButton>(button), action == GLFW_PRESS));
 }
 
-bool Prism::Input::GlfwInputManager::isMouseButtonReleased(const MouseButton button) const
+void Prism::Input::GlfwInputManager::onCursorPosition(GLFWwindow* window, const double xPos, const double yPos)
 {
-    if (ImGui::GetIO().WantCaptureMouse)
+    if (!callbackInstance)
     {
-        return false;
+        return;
     }
-    return glfwGetMouseButton(glfwWindow, mapMouseButtonToGlfwButton(button)) == GLFW_RELEASE;
-}
-
-void Prism::Input::GlfwInputManager::cleanupDeadCallbacks()
-{
-    const size_t erasedMouseMovementCallbacks = std::erase_if(mouseMovementCallbacks,
-                                                              [](const std::function<void(double, double)>& callback)
-                                                              {
-                                                                  return callback == nullptr;
-                                                              });
-    LOG_DEBUG("Removed " + std::to_string(erasedMouseMovementCallbacks) + " dead mouseMovementCallbacks!");
+    callbackInstance->inputState.queueEvent(InputEvent::mouseMovedEvent(xPos, yPos));
 }
 
 Prism::Input::InputKey Prism::Input::GlfwInputManager::mapGlfwKeyToInputKey(int glfwKey) const
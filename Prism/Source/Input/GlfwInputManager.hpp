@@ -15,17 +15,10 @@ namespace Prism::Input
         ~GlfwInputManager() override = default;
         void initialize() override;
         void initializeDeferred() override;
-        void initCursorCallback() override;
+        void initInputCallbacks() override;
         void deInitialize() override;
-        void registerMouseMovementInput(const std::function<void(double xPos, double yPos)>& callback) override;
-
-        [[nodiscard]] bool isKeyDown(InputKey key) const override;
-        [[nodiscard]] bool isKeyPressed(InputKey key) const override;
-        [[nodiscard]] bool isKeyReleased(InputKey key) const override;
-        [[nodiscard]] bool isMouseButtonDown(MouseButton button) const override;
-        [[nodiscard]] bool isMouseButtonReleased(MouseButton button) const override;
-
-        void cleanupDeadCallbacks() override;
+        void processInputEvents() override;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override;
 
         std::string getFullName() override
         {
@@ -33,6 +26,9 @@ namespace Prism::Input
         }
 
     private:
+        // GLFW callbacks are plain functions and the window user pointer belongs to GlfwWindow
+        inline static GlfwInputManager* callbackInstance = nullptr;
+
         GLFWwindow* glfwWindow;
         std::array<int, 16> mouseButtonStates;
         std::array<bool, 512> activeMouseButtons;
@@ -42,5 +38,9 @@ namespace Prism::Input
         InputKey mapGlfwKeyToInputKey(int glfwKey) const;
         int mapInputKeyToGlfwKey(InputKey inputKey) const;
         int mapMouseButtonToGlfwButton(MouseButton button) const;
+
+        static void onKey(GLFWwindow* window, int key, int scanCode, int action, int mods);
+        static void onMouseButton(GLFWwindow* window, int button, int action, int mods);
+        static void onCursorPosition(GLFWwindow* window, double xPos, double yPos);
     };
 }
@@ -1,7 +1,9 @@
 ﻿#pragma once
 #include "../Utilities/IService.hpp"
 #include "../Rendering/WindowManager.hpp"
+#include "InputActionMap.hpp"
 #include "InputKey.hpp"
+#include "InputState.hpp"
 #include "MouseButton.hpp"
 
 namespace Prism::Input
@@ -16,60 +18,100 @@ namespace Prism::Input
         ~IInputManager() override = default;
         virtual void initialize() override = 0;
         virtual void initializeDeferred() override = 0;
-        virtual void initCursorCallback() = 0;
+        // Installs the device callbacks, must happen before the GUI chains its own callbacks onto them
+        virtual void initInputCallbacks() = 0;
         virtual void deInitialize() override = 0;
-        virtual void registerMouseMovementInput(const std::function<void(double xPos, double yPos)>& callback) = 0;
 
-        [[nodiscard]] virtual bool isKeyDown(InputKey key) const = 0;
-        [[nodiscard]] virtual bool isKeyPressed(InputKey key) const = 0;
-        [[nodiscard]] virtual bool isKeyReleased(InputKey key) const = 0;
-        [[nodiscard]] virtual bool isMouseButtonDown(MouseButton) const = 0;
-        [[nodiscard]] virtual bool isMouseButtonReleased(MouseButton) const = 0;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override
+        {
+            dependencies.add<Rendering::IWindowManager>();
+        }
 
-        virtual void cleanupDeadCallbacks() = 0;
+        // Applies the events recorded since the last call, once per frame right after the window polled its events
+        virtual void processInputEvents()
+        {
+            inputState.processEvents();
+            actionMap.evaluate(inputState);
+        }
 
-        [[nodiscard]] bool isCleanupDesired() const
+        // Actions and axes are up to date for the whole frame, prefer them over raw key queries in gameplay code
+        [[nodiscard]] InputActionMap& getActionMap()
         {
-            return deadMouseCallbacks >= deadCallbacksThreshold;
+            return actionMap;
         }
 
-        [[nodiscard]] size_t getDeadCallbacksThreshold() const
+        [[nodiscard]] const InputActionMap& getActionMap() const
         {
-            return deadCallbacksThreshold;
+            return actionMap;
         }
 
-        void setDeadCallbacksThreshold(const size_t newValue)
+        // Listeners are called by reference in registration order, the id unregisters them again
+        InputListenerId registerMouseMovementInput(const std::function<void(double xPos, double yPos)>& callback)
         {
-            deadCallbacksThreshold = newValue;
+            return inputState.addMouseMovementListener(callback);
         }
 
-        virtual std::string getFullName() override = 0;
+        void unregisterMouseMovementInput(const InputListenerId listenerId)
+        {
+            inputState.removeMouseMovementListener(listenerId);
+        }
+
+        // Down is the level of the current frame, pressed and released are only true in the frame the level changed
+        [[nodiscard]] bool isKeyDown(const InputKey key) const
+        {
+            return inputState.isKeyDown(key);
+        }
 
-        [[nodiscard]] std::vector<std::function<void(double, double)>> getMouseMovementCallbacksInternal() const
+        [[nodiscard]] bool isKeyPressed(const InputKey key) const
         {
-            return mouseMovementCallbacks;
+            return inputState.isKeyPressed(key);
         }
 
-        void setMouseMovementCallbacksInternal(
-            const std::vector<std::function<void(double, double)>>& newMouseMovementCallbacks)
+        [[nodiscard]] bool isKeyReleased(const InputKey key) const
         {
-            this->mouseMovementCallbacks = newMouseMovementCallbacks;
+            return inputState.isKeyReleased(key);
         }
 
-        [[nodiscard]] size_t getDeadMouseCallbacksInternal() const
+        [[nodiscard]] bool isMouseButtonDown(const MouseButton button) const
         {
-            return deadMouseCallbacks;
+            return inputState.isMouseButtonDown(button);
         }
 
-        void setDeadMouseCallbacksInternal(const size_t newDeadMouseCallbacks)
+        [[nodiscard]] bool isMouseButtonPressed(const MouseButton button) const
         {
-            this->deadMouseCallbacks = newDeadMouseCallbacks;
+            return inputState.isMouseButtonPressed(button);
         }
 
+        [[nodiscard]] bool isMouseButtonReleased(const MouseButton button) const
+        {
+            return inputState.isMouseButtonReleased(button);
+        }
+
+        void cleanupDeadCallbacks()
+        {
+            inputState.cleanupDeadListeners();
+        }
+
+        [[nodiscard]] bool isCleanupDesired() const
+        {
+            return inputState.isCleanupDesired();
+        }
+
+        [[nodiscard]] size_t getDeadCallbacksThreshold() const
+        {
+            return inputState.getDeadListenersThreshold();
+        }
+
+        void setDeadCallbacksThreshold(const size_t newValue)
+        {
+            inputState.setDeadListenersThreshold(newValue);
+        }
+
+        virtual std::string getFullName() override = 0;
+
     protected:
         RawPtr<Rendering::IWindowManager> windowManager;
-        std::vector<std::function<void(double, double)>> mouseMovementCallbacks;
-        size_t deadMouseCallbacks;
-        size_t deadCallbacksThreshold;
+        InputState inputState;
+        InputActionMap actionMap;
     };
 }
@@ -0,0 +1,160 @@
+﻿#include "InputActionMap.hpp"
+
+#include <algorithm>
+
+#include "InputState.hpp"
+
+Prism::Input::InputActionId Prism::Input::InputActionMap::registerAction(const std::string& name)
+{
+    const auto actionId = registerMapping(actions, name);
+    actionValues.resize(actions.size(), 0);
+    previousActionValues.resize(actions.size(), 0);
+    actionTriggered.resize(actions.size(), 0);
+    actionReleased.resize(actions.size(), 0);
+    return actionId;
+}
+
+Prism::Input::InputAxisId Prism::Input::InputActionMap::registerAxis(const std::string& name)
+{
+    const auto axisId = registerMapping(axes, name);
+    axisValues.resize(axes.size(), 0.0f);
+    return axisId;
+}
+
+Prism::Input::InputActionId Prism::Input::InputActionMap::findAction(const std::string& name) const
+{
+    return findMapping(actions, name);
+}
+
+Prism::Input::InputAxisId Prism::Input::InputActionMap::findAxis(const std::string& name) const
+{
+    return findMapping(axes, name);
+}
+
+void Prism::Input::InputActionMap::bindAction(const InputActionId actionId, const InputBinding& binding)
+{
+    actions.at(actionId).bindings.push_back(binding);
+    compiledBindingsDirty = true;
+}
+
+void Prism::Input::InputActionMap::bindAxis(const InputAxisId axisId, const InputBinding& binding)
+{
+    axes.at(axisId).bindings.push_back(binding);
+    compiledBindingsDirty = true;
+}
+
+void Prism::Input::InputActionMap::clearActionBindings(const InputActionId actionId)
+{
+    actions.at(actionId).bindings.clear();
+    compiledBindingsDirty = true;
+}
+
+void Prism::Input::InputActionMap::clearAxisBindings(const InputAxisId axisId)
+{
+    axes.at(axisId).bindings.clear();
+    compiledBindingsDirty = true;
+}
+
+const std::vector<Prism::Input::InputBinding>& Prism::Input::InputActionMap::getActionBindings(
+    const InputActionId actionId) const
+{
+    return actions.at(actionId).bindings;
+}
+
+const std::vector<Prism::Input::InputBinding>& Prism::Input::InputActionMap::getAxisBindings(
+    const InputAxisId axisId) const
+{
+    return axes.at(axisId).bindings;
+}
+
+void Prism::Input::InputActionMap::evaluate(const InputState& inputState)
+{
+    if (compiledBindingsDirty)
+    {
+        compileBindings();
+    }
+    std::swap(actionValues, previousActionValues);
+    std::ranges::fill(actionValues, 0);
+    std::ranges::fill(actionTriggered, 0);
+    std::ranges::fill(actionReleased, 0);
+    std::ranges::fill(axisValues, 0.0f);
+    for (const auto& binding : compiledBindings)
+    {
+        if (binding.isAxis)
+        {
+            // Axes only have a level, edges don't matter to them
+            const bool down = binding.isMouseButton
+                                  ? inputState.isMouseButtonDown(static_cast<MouseButton>(binding.sourceIndex))
+                                  : inputState.isKeyDown(static_cast<InputKey>(binding.sourceIndex));
+            axisValues[binding.targetIndex] += down ? binding.scale : 0.0f;
+        }
+        else if (binding.isMouseButton)
+        {
+            const auto button = static_cast<MouseButton>(binding.sourceIndex);
+            actionValues[binding.targetIndex] |= static_cast<uint8_t>(inputState.isMouseButtonDown(button));
+            actionTriggered[binding.targetIndex] |= static_cast<uint8_t>(inputState.isMouseButtonPressed(button));
+            actionReleased[binding.targetIndex] |= static_cast<uint8_t>(inputState.isMouseButtonReleased(button));
+        }
+        else
+        {
+            const auto key = static_cast<InputKey>(binding.sourceIndex);
+            actionValues[binding.targetIndex] |= static_cast<uint8_t>(inputState.isKeyDown(key));
+            actionTriggered[binding.targetIndex] |= static_cast<uint8_t>(inputState.isKeyPressed(key));
+            actionReleased[binding.targetIndex] |= static_cast<uint8_t>(inputState.isKeyReleased(key));
+        }
+    }
+    /*
+     * A press only triggers an action that was inactive, so a second binding doesn't trigger it again while the first
+     * is held, and a release only counts once no binding is down anymore. The level change is kept as a trigger too,
+     * capturing or releasing a device changes the level without an edge.
+     */
+    for (size_t i = 0; i < actionValues.size(); ++i)
+    {
+        const bool wasActive = previousActionValues[i] != 0;
+        const bool isActive = actionValues[i] != 0;
+        actionTriggered[i] = static_cast<uint8_t>(!wasActive && (isActive || actionTriggered[i] != 0));
+        actionReleased[i] = static_cast<uint8_t>(!isActive && (wasActive || actionReleased[i] != 0));
+    }
+    // Opposing keys cancel out, the same direction bound twice doesn't go faster
+    for (auto& axisValue : axisValues)
+    {
+        axisValue = std::clamp(axisValue, -1.0f, 1.0f);
+    }
+}
+
+uint32_t Prism::Input::InputActionMap::registerMapping(std::vector<Mapping>& mappings, const std::string& name)
+{
+    if (const auto mappingId = findMapping(mappings, name); mappingId != invalidInputMappingId)
+    {
+        return mappingId;
+    }
+    mappings.push_back({name, {}});
+    return static_cast<uint32_t>(mappings.size() - 1);
+}
+
+uint32_t Prism::Input::InputActionMap::findMapping(const std::vector<Mapping>& mappings, const std::string& name)
+{
+    const auto it = std::ranges::find(mappings, name, &Mapping::name);
+    return it != mappings.end() ? static_cast<uint32_t>(it - mappings.begin()) : invalidInputMappingId;
+}
+
+void Prism::Input::InputActionMap::compileBindings()
+{
+    compiledBindings.clear();
+    const auto appendBindings = [this](const std::vector<Mapping>& mappings, const bool isAxis)
+    {
+        for (uint32_t i = 0; i < mappings.size(); ++i)
+        {
+            for (const auto& binding : mappings[i].bindings)
+            {
+                const auto sourceIndex = binding.isMouseButton
+                                             ? static_cast<uint16_t>(binding.mouseButton)
+                                             : static_cast<uint16_t>(binding.key);
+                compiledBindings.push_back({i, sourceIndex, binding.isMouseButton, isAxis, binding.scale});
+            }
+        }
+    };
+    appendBindings(actions, false);
+    appendBindings(axes, true);
+    compiledBindingsDirty = false;
+}
@@ -0,0 +1,113 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "InputKey.hpp"
+#include "MouseButton.hpp"
+
+namespace Prism::Input
+{
+    class InputState;
+
+    using InputActionId = uint32_t;
+    using InputAxisId = uint32_t;
+    inline constexpr uint32_t invalidInputMappingId = UINT32_MAX;
+
+    // A key or a mouse button, scale is only used by axis bindings
+    struct InputBinding
+    {
+        bool isMouseButton = false;
+        InputKey key = InputKey::UNKNOWN;
+        MouseButton mouseButton = MouseButton::LEFT;
+        float scale = 1.0f;
+
+        [[nodiscard]] static InputBinding fromKey(const InputKey key, const float scale = 1.0f)
+        {
+            return {false, key, MouseButton::LEFT, scale};
+        }
+
+        [[nodiscard]] static InputBinding fromMouseButton(const MouseButton mouseButton, const float scale = 1.0f)
+        {
+            return {true, InputKey::UNKNOWN, mouseButton, scale};
+        }
+    };
+
+    /*
+     * Named actions (on/off) and axes (-1..1) bound to keys and mouse buttons. The bindings are compiled into one flat
+     * table whenever they change and evaluated once per frame into dense arrays, so gameplay code reads a precomputed
+     * value by id instead of querying the devices itself. Ids are stable, rebinding only recompiles the table.
+     */
+    class InputActionMap
+    {
+    public:
+        // Returns the id of an existing action or axis with that name
+        InputActionId registerAction(const std::string& name);
+        InputAxisId registerAxis(const std::string& name);
+        [[nodiscard]] InputActionId findAction(const std::string& name) const;
+        [[nodiscard]] InputAxisId findAxis(const std::string& name) const;
+
+        void bindAction(InputActionId actionId, const InputBinding& binding);
+        void bindAxis(InputAxisId axisId, const InputBinding& binding);
+        void clearActionBindings(InputActionId actionId);
+        void clearAxisBindings(InputAxisId axisId);
+        [[nodiscard]] const std::vector<InputBinding>& getActionBindings(InputActionId actionId) const;
+        [[nodiscard]] const std::vector<InputBinding>& getAxisBindings(InputAxisId axisId) const;
+
+        void evaluate(const InputState& inputState);
+
+        [[nodiscard]] bool isActionActive(const InputActionId actionId) const
+        {
+            return actionValues[actionId] != 0;
+        }
+
+        // Only true in the frame the action became active or inactive, a tap within one frame reports both
+        [[nodiscard]] bool isActionTriggered(const InputActionId actionId) const
+        {
+            return actionTriggered[actionId] != 0;
+        }
+
+        [[nodiscard]] bool isActionReleased(const InputActionId actionId) const
+        {
+            return actionReleased[actionId] != 0;
+        }
+
+        [[nodiscard]] float getAxisValue(const InputAxisId axisId) const
+        {
+            return axisValues[axisId];
+        }
+
+    private:
+        struct Mapping
+        {
+            std::string name;
+            std::vector<InputBinding> bindings;
+        };
+
+        // One row per binding, evaluated front to back
+        struct CompiledBinding
+        {
+            uint32_t targetIndex;
+            uint16_t sourceIndex;
+            bool isMouseButton;
+            bool isAxis;
+            float scale;
+        };
+
+        std::vector<Mapping> actions;
+        std::vector<Mapping> axes;
+        std::vector<CompiledBinding> compiledBindings;
+        bool compiledBindingsDirty = false;
+        // uint8_t instead of bool, std::vector<bool> packs bits behind proxy references
+        std::vector<uint8_t> actionValues;
+        std::vector<uint8_t> previousActionValues;
+        // Press and release edges of any binding this frame, then resolved into the triggered and released flags
+        std::vector<uint8_t> actionTriggered;
+        std::vector<uint8_t> actionReleased;
+        std::vector<float> axisValues;
+
+        static uint32_t registerMapping(std::vector<Mapping>& mappings, const std::string& name);
+        static uint32_t findMapping(const std::vector<Mapping>& mappings, const std::string& name);
+        void compileBindings();
+    };
+}
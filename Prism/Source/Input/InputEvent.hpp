@@ -0,0 +1,52 @@
+﻿#pragma once
+#include <cstdint>
+
+#include "InputKey.hpp"
+#include "MouseButton.hpp"
+
+namespace Prism::Input
+{
+    enum class InputEventType : uint8_t
+    {
+        KeyPressed,
+        KeyReleased,
+        MouseButtonPressed,
+        MouseButtonReleased,
+        MouseMoved
+    };
+
+    // Raw device event as recorded by the window callbacks, only the fields of its type are meaningful
+    struct InputEvent
+    {
+        InputEventType type = InputEventType::KeyPressed;
+        InputKey key = InputKey::UNKNOWN;
+        MouseButton mouseButton = MouseButton::LEFT;
+        double xPos = 0.0;
+        double yPos = 0.0;
+
+        [[nodiscard]] static InputEvent keyEvent(const InputKey key, const bool pressed)
+        {
+            InputEvent event;
+            event.type = pressed ? InputEventType::KeyPressed : InputEventType::KeyReleased;
+            event.key = key;
+            return event;
+        }
+
+        [[nodiscard]] static InputEvent mouseButtonEvent(const MouseButton mouseButton, const bool pressed)
+        {
+            InputEvent event;
+            event.type = pressed ? InputEventType::MouseButtonPressed : InputEventType::MouseButtonReleased;
+            event.mouseButton = mouseButton;
+            return event;
+        }
+
+        [[nodiscard]] static InputEvent mouseMovedEvent(const double xPos, const double yPos)
+        {
+            InputEvent event;
+            event.type = InputEventType::MouseMoved;
+            event.xPos = xPos;
+            event.yPos = yPos;
+            return event;
+        }
+    };
+}
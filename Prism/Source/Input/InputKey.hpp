@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <cstddef>
 
 namespace Prism::Input
 {
@@ -126,4 +127,6 @@ namespace Prism::Input
         RIGHT_SUPER,
         MENU
     };
+
+    inline constexpr size_t inputKeyCount = static_cast<size_t>(InputKey::MENU) + 1;
 }
@@ -0,0 +1,121 @@
+﻿#include "InputState.hpp"
+
+#include <algorithm>
+
+#include "../Utilities/Logging/Log.hpp"
+
+namespace
+{
+    template <size_t N>
+    void applyPress(std::bitset<N>& down, std::bitset<N>& pressed, const size_t index)
+    {
+        // Repeated press events of a held key are not a new press
+        if (!down.test(index))
+        {
+            pressed.set(index);
+            down.set(index);
+        }
+    }
+
+    template <size_t N>
+    void applyRelease(std::bitset<N>& down, std::bitset<N>& released, const size_t index)
+    {
+        if (down.test(index))
+        {
+            released.set(index);
+            down.reset(index);
+        }
+    }
+}
+
+void Prism::Input::InputState::processEvents()
+{
+    pressedKeys.reset();
+    releasedKeys.reset();
+    pressedMouseButtons.reset();
+    releasedMouseButtons.reset();
+    std::swap(queuedEvents, processedEvents);
+    // Applied in order, so a listener sees the button state at the time of its movement event
+    for (const auto& event : processedEvents)
+    {
+        switch (event.type)
+        {
+        // Edges are recorded per event, a press and release within the same frame reports both
+        case InputEventType::KeyPressed:
+            applyPress(currentKeys, pressedKeys, static_cast<size_t>(event.key));
+            break;
+        case InputEventType::KeyReleased:
+            applyRelease(currentKeys, releasedKeys, static_cast<size_t>(event.key));
+            break;
+        case InputEventType::MouseButtonPressed:
+            applyPress(currentMouseButtons, pressedMouseButtons, static_cast<size_t>(event.mouseButton));
+            break;
+        case InputEventType::MouseButtonReleased:
+            applyRelease(currentMouseButtons, releasedMouseButtons, static_cast<size_t>(event.mouseButton));
+            break;
+        case InputEventType::MouseMoved:
+            cursorXPos = event.xPos;
+            cursorYPos = event.yPos;
+            if (!mouseCaptured)
+            {
+                dispatchMouseMovement(event.xPos, event.yPos);
+            }
+            break;
+        }
+    }
+    processedEvents.clear();
+
+    if (isCleanupDesired())
+    {
+        cleanupDeadListeners();
+    }
+}
+
+Prism::Input::InputListenerId Prism::Input::InputState::addMouseMovementListener(
+    const std::function<void(double xPos, double yPos)>& callback)
+{
+    const InputListenerId listenerId = nextListenerId++;
+    mouseMovementListeners.push_back({listenerId, callback, true});
+    return listenerId;
+}
+
+void Prism::Input::InputState::removeMouseMovementListener(const InputListenerId listenerId)
+{
+    const auto it = std::ranges::find(mouseMovementListeners, listenerId, &MouseMovementListener::listenerId);
+    if (it == mouseMovementListeners.end() || !it->alive)
+    {
+        return;
+    }
+    it->alive = false;
+    ++deadListeners;
+}
+
+void Prism::Input::InputState::cleanupDeadListeners()
+{
+    if (dispatching)
+    {
+        return;
+    }
+    const size_t erasedListeners = std::erase_if(mouseMovementListeners, [](const MouseMovementListener& listener)
+    {
+        return !listener.alive;
+    });
+    deadListeners = 0;
+    LOG_DEBUG("Removed {} dead mouse movement listeners!", erasedListeners);
+}
+
+void Prism::Input::InputState::dispatchMouseMovement(const double xPos, const double yPos)
+{
+    dispatching = true;
+    // Listeners added during the dispatch get the next event
+    const size_t listenerCount = mouseMovementListeners.size();
+    for (size_t i = 0; i < listenerCount; ++i)
+    {
+        const auto& listener = mouseMovementListeners[i];
+        if (listener.alive && listener.callback)
+        {
+            listener.callback(xPos, yPos);
+        }
+    }
+    dispatching = false;
+}
@@ -0,0 +1,131 @@
+﻿#pragma once
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "InputEvent.hpp"
+
+namespace Prism::Input
+{
+    using InputListenerId = uint32_t;
+    inline constexpr InputListenerId invalidInputListenerId = 0;
+
+    /*
+     * Device independent input state. Window callbacks only append to the event queue, processEvents then applies the
+     * queue once per frame in order: keys and buttons end up in the current bitsets, presses and releases of the frame
+     * are collected separately so a tap within one frame reports both edges, and mouse movement is dispatched to the
+     * listeners. All queries are bit tests.
+     */
+    class InputState
+    {
+    public:
+        inline constexpr static size_t defaultDeadListenersThreshold = 16;
+
+        void queueEvent(const InputEvent& event)
+        {
+            queuedEvents.push_back(event);
+        }
+
+        // Captured devices report nothing, e.g. while the GUI has focus. Applies to the next processEvents call.
+        void setCaptured(const bool keyboard, const bool mouse)
+        {
+            keyboardCaptured = keyboard;
+            mouseCaptured = mouse;
+        }
+
+        void processEvents();
+
+        InputListenerId addMouseMovementListener(const std::function<void(double xPos, double yPos)>& callback);
+        void removeMouseMovementListener(InputListenerId listenerId);
+        void cleanupDeadListeners();
+
+        [[nodiscard]] bool isCleanupDesired() const
+        {
+            return deadListeners >= deadListenersThreshold;
+        }
+
+        [[nodiscard]] size_t getDeadListenersThreshold() const
+        {
+            return deadListenersThreshold;
+        }
+
+        void setDeadListenersThreshold(const size_t newValue)
+        {
+            deadListenersThreshold = newValue;
+        }
+
+        [[nodiscard]] bool isKeyDown(const InputKey key) const
+        {
+            return !keyboardCaptured && currentKeys.test(static_cast<size_t>(key));
+        }
+
+        [[nodiscard]] bool isKeyPressed(const InputKey key) const
+        {
+            return !keyboardCaptured && pressedKeys.test(static_cast<size_t>(key));
+        }
+
+        [[nodiscard]] bool isKeyReleased(const InputKey key) const
+        {
+            return !keyboardCaptured && releasedKeys.test(static_cast<size_t>(key));
+        }
+
+        [[nodiscard]] bool isMouseButtonDown(const MouseButton button) const
+        {
+            return !mouseCaptured && currentMouseButtons.test(static_cast<size_t>(button));
+        }
+
+        [[nodiscard]] bool isMouseButtonPressed(const MouseButton button) const
+        {
+            return !mouseCaptured && pressedMouseButtons.test(static_cast<size_t>(button));
+        }
+
+        [[nodiscard]] bool isMouseButtonReleased(const MouseButton button) const
+        {
+            return !mouseCaptured && releasedMouseButtons.test(static_cast<size_t>(button));
+        }
+
+        [[nodiscard]] double getCursorXPos() const
+        {
+            return cursorXPos;
+        }
+
+        [[nodiscard]] double getCursorYPos() const
+        {
+            return cursorYPos;
+        }
+
+    private:
+        struct MouseMovementListener
+        {
+            InputListenerId listenerId;
+            std::function<void(double, double)> callback;
+            // Removed listeners keep their callback until the cleanup, it may be the one currently executing
+            bool alive = true;
+        };
+
+        std::bitset<inputKeyCount> currentKeys;
+        // Edges of the last processEvents call
+        std::bitset<inputKeyCount> pressedKeys;
+        std::bitset<inputKeyCount> releasedKeys;
+        std::bitset<mouseButtonCount> currentMouseButtons;
+        std::bitset<mouseButtonCount> pressedMouseButtons;
+        std::bitset<mouseButtonCount> releasedMouseButtons;
+        // Swapped every frame, so neither reallocates once warmed up and callbacks may queue new events safely
+        std::vector<InputEvent> queuedEvents;
+        std::vector<InputEvent> processedEvents;
+        // References stay valid when a listener registers another one while being dispatched
+        std::deque<MouseMovementListener> mouseMovementListeners;
+        InputListenerId nextListenerId = invalidInputListenerId + 1;
+        size_t deadListeners = 0;
+        size_t deadListenersThreshold = defaultDeadListenersThreshold;
+        bool dispatching = false;
+        bool keyboardCaptured = false;
+        bool mouseCaptured = false;
+        double cursorXPos = 0.0;
+        double cursorYPos = 0.0;
+
+        void dispatchMouseMovement(double xPos, double yPos);
+    };
+}
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <cstddef>
 
 namespace Prism::Input
 {
@@ -13,4 +14,6 @@ namespace Prism::Input
         BUTTON_7,
         BUTTON_8,
     };
+
+    inline constexpr size_t mouseButtonCount = static_cast<size_t>(MouseButton::BUTTON_8) + 1;
 }
@@ -0,0 +1,6 @@
+﻿#include "NullInputManager.hpp"
+
+Prism::Input::NullInputManager::NullInputManager(const RawPtr<Rendering::IWindowManager> windowManager)
+    : IInputManager(windowManager)
+{
+}
@@ -0,0 +1,35 @@
+﻿#pragma once
+
+#include "IInputManager.hpp"
+
+namespace Prism::Input
+{
+    // Input manager for headless runs, there is no device that queues events so nothing is ever pressed
+    class NullInputManager : public IInputManager
+    {
+    public:
+        explicit NullInputManager(RawPtr<Rendering::IWindowManager> windowManager);
+        ~NullInputManager() override = default;
+
+        void initialize() override
+        {
+        }
+
+        void initializeDeferred() override
+        {
+        }
+
+        void initInputCallbacks() override
+        {
+        }
+
+        void deInitialize() override
+        {
+        }
+
+        std::string getFullName() override
+        {
+            return "Prism::Input::NullInputManager";
+        }
+    };
+}
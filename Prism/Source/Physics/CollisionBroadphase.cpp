@@ -0,0 +1,388 @@
+﻿#include "CollisionBroadphase.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <future>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "../Core/Actor.hpp"
+#include "../Core/StaticMeshComponent.hpp"
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/JobSystem.hpp"
+#include "../Utilities/ServiceLocator.hpp"
+#include "../Utilities/Profiling/AllocationTracker.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<bool> cvarBroadphase(
+        "physics.broadphase", true, "Find overlapping collidable components and send overlap events to their actors");
+    Prism::Utility::ConsoleVariable<uint32_t> cvarBodiesPerJob(
+        "physics.broadphaseBodiesPerJob", 4096, 256, std::numeric_limits<uint32_t>::max(),
+        "Bodies swept per job, smaller values spread the broadphase over more workers");
+
+    // Beyond this many moves per body the order changed too much for the insertion sort to pay off
+    constexpr size_t maxInsertionSortShiftsPerBody = 8;
+    // The sweep loads four candidates at once past the last body
+    constexpr size_t sweepPadding = 4;
+
+    [[nodiscard]] uint64_t packHandle(const Prism::Core::SpatialIndexHandle& handle)
+    {
+        return static_cast<uint64_t>(handle.entry) << 32 | handle.generation;
+    }
+
+    [[nodiscard]] Prism::Core::SpatialIndexHandle unpackHandle(const uint64_t packedHandle)
+    {
+        return {static_cast<uint32_t>(packedHandle >> 32), static_cast<uint32_t>(packedHandle)};
+    }
+}
+
+void Prism::Physics::CollisionBroadphase::initialize()
+{
+    spatialIndex = Utility::ServiceLocator::getService<Core::SpatialIndex>();
+    jobSystem = Utility::ServiceLocator::getService<Utility::JobSystem>();
+}
+
+void Prism::Physics::CollisionBroadphase::deInitialize()
+{
+    bodies.clear();
+    trackedGenerations.clear();
+    currentPairs.clear();
+    previousPairs.clear();
+    pendingEvents.clear();
+}
+
+void Prism::Physics::CollisionBroadphase::declareDependencies(Utility::ServiceDependencies& dependencies)
+{
+    dependencies.add<Core::SpatialIndex>();
+    dependencies.add<Utility::JobSystem>();
+}
+
+void Prism::Physics::CollisionBroadphase::step()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::step");
+    if (!cvarBroadphase.get())
+    {
+        // Overlaps found after re-enabling it begin anew
+        deInitialize();
+        return;
+    }
+    refreshBodies();
+    sortBodies();
+    buildSweepArrays();
+    findPairs();
+    updatePairs();
+    dispatchEvents();
+}
+
+void Prism::Physics::CollisionBroadphase::refreshBodies()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::refreshBodies");
+    // Keeps the order of the previous step, the bodies only moved a little since then
+    size_t keptBodyCount = 0;
+    for (const auto& body : bodies)
+    {
+        const auto component = spatialIndex->getComponent(body.handle);
+        if (!component || !component->isCollidable())
+        {
+            trackedGenerations[body.handle.entry] = 0;
+            continue;
+        }
+        auto& keptBody = bodies[keptBodyCount++];
+        keptBody = body;
+        keptBody.bounds = *spatialIndex->getBounds(body.handle);
+    }
+    bodies.resize(keptBodyCount);
+
+    spatialIndex->forEachComponent(
+        [this](const Core::SpatialIndexHandle& handle, const RawPtr<Core::StaticMeshComponent>& component,
+               const Core::Aabb& bounds)
+        {
+            if (!component->isCollidable())
+            {
+                return;
+            }
+            if (handle.entry >= trackedGenerations.size())
+            {
+                trackedGenerations.resize(handle.entry + 1, 0);
+            }
+            if (trackedGenerations[handle.entry] == handle.generation + 1)
+            {
+                return;
+            }
+            trackedGenerations[handle.entry] = handle.generation + 1;
+            bodies.push_back({handle, component, bounds});
+        });
+}
+
+void Prism::Physics::CollisionBroadphase::sortBodies()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::sortBodies");
+    const auto isBefore = [](const Body& a, const Body& b)
+    {
+        return a.bounds.min.x < b.bounds.min.x;
+    };
+
+    // Nearly sorted from the previous step, new bodies are appended and move to their place the same way
+    const auto maxShifts = bodies.size() * maxInsertionSortShiftsPerBody;
+    size_t shifts = 0;
+    for (size_t i = 1; i < bodies.size(); ++i)
+    {
+        if (!isBefore(bodies[i], bodies[i - 1]))
+        {
+            continue;
+        }
+        auto body = bodies[i];
+        size_t j = i;
+        for (; j > 0 && isBefore(body, bodies[j - 1]); --j)
+        {
+            bodies[j] = bodies[j - 1];
+        }
+        bodies[j] = body;
+        shifts += i - j;
+        if (shifts > maxShifts)
+        {
+            // E.g. the first step of a scene or a mass teleport
+            std::sort(bodies.begin(), bodies.end(), isBefore);
+            return;
+        }
+    }
+}
+
+void Prism::Physics::CollisionBroadphase::buildSweepArrays()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::buildSweepArrays");
+    const auto paddedCount = bodies.size() + sweepPadding;
+    for (auto* values : {&minX, &maxX, &minY, &maxY, &minZ, &maxZ})
+    {
+        values->resize(paddedCount);
+    }
+    for (size_t i = 0; i < bodies.size(); ++i)
+    {
+        const auto& bounds = bodies[i].bounds;
+        minX[i] = bounds.min.x;
+        maxX[i] = bounds.max.x;
+        minY[i] = bounds.min.y;
+        maxY[i] = bounds.max.y;
+        minZ[i] = bounds.min.z;
+        maxZ[i] = bounds.max.z;
+    }
+    // Starts after every real body ends, which ends every sweep
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+    for (auto i = bodies.size(); i < paddedCount; ++i)
+    {
+        minX[i] = minY[i] = minZ[i] = infinity;
+        maxX[i] = maxY[i] = maxZ[i] = -infinity;
+    }
+}
+
+void Prism::Physics::CollisionBroadphase::findPairs()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::findPairs");
+    const size_t bodyCount = bodies.size();
+    const size_t bodiesPerJob = cvarBodiesPerJob.get();
+    const size_t jobCount = std::clamp<size_t>((bodyCount + bodiesPerJob - 1) / bodiesPerJob, 1,
+                                               jobSystem->getWorkerCount() + 1);
+    if (jobPairs.size() < jobCount)
+    {
+        jobPairs.resize(jobCount);
+    }
+    for (auto& pairs : jobPairs)
+    {
+        pairs.clear();
+    }
+
+    if (jobCount == 1)
+    {
+        sweep(0, bodyCount, jobPairs[0]);
+        return;
+    }
+
+    // Bodies at the start of a range sweep as far as those at its end, so equally sized ranges are balanced
+    const size_t bodiesPerRange = (bodyCount + jobCount - 1) / jobCount;
+    // The tasks behind the futures are a few small allocations per step
+    PRISM_ALLOCATION_ALLOW();
+    std::vector<std::future<void>> jobs;
+    jobs.reserve(jobCount - 1);
+    for (size_t job = 1; job < jobCount; ++job)
+    {
+        const auto begin = std::min(job * bodiesPerRange, bodyCount);
+        const auto end = std::min(begin + bodiesPerRange, bodyCount);
+        jobs.push_back(jobSystem->submit([this, begin, end, job]
+        {
+            sweep(begin, end, jobPairs[job]);
+        }));
+    }
+    sweep(0, std::min(bodiesPerRange, bodyCount), jobPairs[0]);
+    for (auto& job : jobs)
+    {
+        job.get();
+    }
+}
+
+void Prism::Physics::CollisionBroadphase::sweep(const size_t begin, const size_t end,
+                                                std::vector<BodyPair>& outPairs) const
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        // Candidates start at or after this body on x, they overlap on x as long as they start before it ends
+        size_t j = i + 1;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128 bodyMaxX = _mm_set1_ps(maxX[i]);
+        const __m128 bodyMinY = _mm_set1_ps(minY[i]);
+        const __m128 bodyMaxY = _mm_set1_ps(maxY[i]);
+        const __m128 bodyMinZ = _mm_set1_ps(minZ[i]);
+        const __m128 bodyMaxZ = _mm_set1_ps(maxZ[i]);
+        while (true)
+        {
+            const int inRangeMask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&minX[j]), bodyMaxX));
+            if (inRangeMask == 0)
+            {
+                break;
+            }
+            const __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minY[j]), bodyMaxY),
+                                               _mm_cmpge_ps(_mm_loadu_ps(&maxY[j]), bodyMinY));
+            const __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minZ[j]), bodyMaxZ),
+                                               _mm_cmpge_ps(_mm_loadu_ps(&maxZ[j]), bodyMinZ));
+            auto overlapMask = static_cast<uint32_t>(inRangeMask & _mm_movemask_ps(_mm_and_ps(overlapY, overlapZ)));
+            while (overlapMask != 0)
+            {
+                const auto lane = static_cast<size_t>(std::countr_zero(overlapMask));
+                outPairs.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(j + lane)});
+                overlapMask &= overlapMask - 1;
+            }
+            // Sorted by min x, once a candidate is out of range all following ones are as well
+            if (inRangeMask != 0b1111)
+            {
+                break;
+            }
+            j += 4;
+        }
+#else
+        for (; minX[j] <= maxX[i]; ++j)
+        {
+            if (minY[j] <= maxY[i] && maxY[j] >= minY[i] && minZ[j] <= maxZ[i] && maxZ[j] >= minZ[i])
+            {
+                outPairs.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+            }
+        }
+#endif
+    }
+}
+
+void Prism::Physics::CollisionBroadphase::updatePairs()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::updatePairs");
+    currentPairs.clear();
+    for (const auto& pairs : jobPairs)
+    {
+        for (const auto& [first, second] : pairs)
+        {
+            const auto bodyA = packHandle(bodies[first].handle);
+            const auto bodyB = packHandle(bodies[second].handle);
+            currentPairs.push_back({std::min(bodyA, bodyB), std::max(bodyA, bodyB)});
+        }
+    }
+    std::sort(currentPairs.begin(), currentPairs.end());
+
+    const auto beginOverlap = [this](const OverlapPair& pair)
+    {
+        const auto componentA = spatialIndex->getComponent(unpackHandle(pair.bodyA));
+        const auto componentB = spatialIndex->getComponent(unpackHandle(pair.bodyB));
+        addEvent(OverlapEventType::Begin, componentA, componentB);
+        addEvent(OverlapEventType::Begin, componentB, componentA);
+    };
+    const auto endOverlap = [this](const OverlapPair& pair)
+    {
+        // Either component may be gone already, only the remaining one is told
+        const auto componentA = spatialIndex->getComponent(unpackHandle(pair.bodyA));
+        const auto componentB = spatialIndex->getComponent(unpackHandle(pair.bodyB));
+        addEvent(OverlapEventType::End, componentA, componentB);
+        addEvent(OverlapEventType::End, componentB, componentA);
+    };
+
+    // Both lists are sorted, pairs only in the current one began overlapping, those only in the previous one ended
+    auto current = currentPairs.begin();
+    auto previous = previousPairs.begin();
+    while (current != currentPairs.end() || previous != previousPairs.end())
+    {
+        if (previous == previousPairs.end() || (current != currentPairs.end() && *current < *previous))
+        {
+            beginOverlap(*current++);
+        }
+        else if (current == currentPairs.end() || *previous < *current)
+        {
+            endOverlap(*previous++);
+        }
+        else
+        {
+            ++current;
+            ++previous;
+        }
+    }
+    std::swap(currentPairs, previousPairs);
+}
+
+void Prism::Physics::CollisionBroadphase::addEvent(const OverlapEventType type,
+                                                   const RawPtr<Core::StaticMeshComponent> component,
+                                                   const RawPtr<Core::StaticMeshComponent> otherComponent)
+{
+    if (!component)
+    {
+        return;
+    }
+    const auto actor = component->getParent();
+    if (!actor || !actor->isValid())
+    {
+        return;
+    }
+    // The other component is gone when its removal ended the overlap
+    const auto otherBody = otherComponent ? packHandle(otherComponent->getSpatialIndexHandle())
+                                          : std::numeric_limits<uint64_t>::max();
+    pendingEvents.push_back({actor, actor->getId(), packHandle(component->getSpatialIndexHandle()), otherBody,
+                             {type, component, otherComponent}});
+}
+
+void Prism::Physics::CollisionBroadphase::dispatchEvents()
+{
+    PRISM_PROFILE_SCOPE("CollisionBroadphase::dispatchEvents");
+    // Grouped by actor, each actor gets a single call with ended overlaps before begun ones
+    std::sort(pendingEvents.begin(), pendingEvents.end(), [](const PendingEvent& a, const PendingEvent& b)
+    {
+        if (a.actorId != b.actorId)
+        {
+            return a.actorId < b.actorId;
+        }
+        if (a.event.type != b.event.type)
+        {
+            return a.event.type == OverlapEventType::End;
+        }
+        if (a.body != b.body)
+        {
+            return a.body < b.body;
+        }
+        return a.otherBody < b.otherBody;
+    });
+
+    for (size_t first = 0; first < pendingEvents.size();)
+    {
+        const auto actor = pendingEvents[first].actor;
+        actorEvents.clear();
+        size_t last = first;
+        for (; last < pendingEvents.size() && pendingEvents[last].actor == actor; ++last)
+        {
+            actorEvents.push_back(pendingEvents[last].event);
+        }
+        // An earlier handler may have destroyed the actor
+        if (actor->isValid())
+        {
+            actor->dispatchOverlapEventsInternal(actorEvents);
+        }
+        first = last;
+    }
+    pendingEvents.clear();
+}
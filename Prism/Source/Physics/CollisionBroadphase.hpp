@@ -0,0 +1,134 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "OverlapEvent.hpp"
+#include "../Core/SpatialIndex.hpp"
+#include "../Utilities/Globals.hpp"
+#include "../Utilities/IService.hpp"
+
+namespace Prism::Core
+{
+    class Actor;
+}
+
+namespace Prism::Utility
+{
+    class JobSystem;
+}
+
+namespace Prism::Physics
+{
+    /*
+     * Finds the overlapping pairs among the world bounds of all collidable static mesh components with sweep and
+     * prune along x. The bodies stay sorted across frames, so the per frame sort only moves the few that changed
+     * order. Pairs are diffed against the previous step and the resulting begin and end events are delivered once
+     * per actor. Only to be used from the main thread, the sweep itself is spread over the job system.
+     */
+    class CollisionBroadphase : public Utility::IService
+    {
+    public:
+        ~CollisionBroadphase() override = default;
+
+        void initialize() override;
+
+        void initializeDeferred() override
+        {
+        }
+
+        void deInitialize() override;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override;
+
+        // Physics phase of the frame, runs after the scene ticked and the spatial index refit its bounds
+        void step();
+
+        [[nodiscard]] size_t getBodyCount() const
+        {
+            return bodies.size();
+        }
+
+        [[nodiscard]] size_t getPairCount() const
+        {
+            return previousPairs.size();
+        }
+
+        std::string getFullName() override
+        {
+            return "Prism::Physics::CollisionBroadphase";
+        }
+
+    private:
+        struct Body
+        {
+            Core::SpatialIndexHandle handle;
+            RawPtr<Core::StaticMeshComponent> component;
+            Core::Aabb bounds;
+        };
+
+        // Handles packed into a single integer each, bodyA < bodyB
+        struct OverlapPair
+        {
+            uint64_t bodyA;
+            uint64_t bodyB;
+
+            [[nodiscard]] bool operator<(const OverlapPair& other) const
+            {
+                return bodyA < other.bodyA || (bodyA == other.bodyA && bodyB < other.bodyB);
+            }
+
+            [[nodiscard]] bool operator==(const OverlapPair& other) const = default;
+        };
+
+        // Indices into bodies of an overlapping pair found by the sweep
+        struct BodyPair
+        {
+            uint32_t first;
+            uint32_t second;
+        };
+
+        // Sorted by the actor id and the packed handles, so the dispatch order doesn't depend on heap addresses
+        struct PendingEvent
+        {
+            RawPtr<Core::Actor> actor;
+            uint64_t actorId;
+            uint64_t body;
+            uint64_t otherBody;
+            OverlapEvent event;
+        };
+
+        void refreshBodies();
+        void sortBodies();
+        void buildSweepArrays();
+        void findPairs();
+        // Tests the bodies in [begin, end) against all bodies after them
+        void sweep(size_t begin, size_t end, std::vector<BodyPair>& outPairs) const;
+        void updatePairs();
+        void addEvent(OverlapEventType type, RawPtr<Core::StaticMeshComponent> component,
+                      RawPtr<Core::StaticMeshComponent> otherComponent);
+        void dispatchEvents();
+
+        RawPtr<Core::SpatialIndex> spatialIndex;
+        RawPtr<Utility::JobSystem> jobSystem;
+
+        // Sorted by bounds.min.x
+        std::vector<Body> bodies;
+        // Per spatial index entry, generation + 1 of the handle that is in bodies, 0 if none
+        std::vector<uint32_t> trackedGenerations;
+
+        // Bounds of the sorted bodies as separate arrays, so the sweep compares four candidates at once. Padded with
+        // bodies that never overlap anything, so the sweep needs no bounds checks
+        std::vector<float> minX;
+        std::vector<float> maxX;
+        std::vector<float> minY;
+        std::vector<float> maxY;
+        std::vector<float> minZ;
+        std::vector<float> maxZ;
+
+        // One per job, reused across steps
+        std::vector<std::vector<BodyPair>> jobPairs;
+        std::vector<OverlapPair> currentPairs;
+        std::vector<OverlapPair> previousPairs;
+        std::vector<PendingEvent> pendingEvents;
+        std::vector<OverlapEvent> actorEvents;
+    };
+}
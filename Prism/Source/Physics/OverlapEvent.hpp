@@ -0,0 +1,25 @@
+﻿#pragma once
+#include "../Utilities/Globals.hpp"
+
+namespace Prism::Core
+{
+    class StaticMeshComponent;
+}
+
+namespace Prism::Physics
+{
+    enum class OverlapEventType
+    {
+        Begin,
+        End,
+    };
+
+    struct OverlapEvent
+    {
+        OverlapEventType type = OverlapEventType::Begin;
+        // Component of the actor receiving the event
+        RawPtr<Core::StaticMeshComponent> component;
+        // nullptr for end events of components that were destroyed while overlapping
+        RawPtr<Core::StaticMeshComponent> otherComponent;
+    };
+}
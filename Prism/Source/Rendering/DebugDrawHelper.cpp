@@ -1,174 +1,216 @@
 ﻿#include "DebugDrawHelper.hpp"
-#include "../Utilities/ServiceLocator.hpp"
-#include "../Assets/AssetManager.hpp"
+#include <algorithm>
+#include <glm/gtc/constants.hpp>
 
-Prism::Rendering::DebugDrawHelper::DebugDrawHelper()
+void Prism::Rendering::DebugDrawHelper::initialize()
 {
-    setName("DebugDrawHelper");
 }
 
-void Prism::Rendering::DebugDrawHelper::init()
+void Prism::Rendering::DebugDrawHelper::initializeDeferred()
 {
-    Actor::init();
-    const auto assetManager = Utility::ServiceLocator::getService<Assets::AssetManager>();
-    sceneManager = Utility::ServiceLocator::getService<Core::ISceneManager>();
-    lineMeshAsset = assetManager->getAsset<Assets::StaticMeshAsset>("Assets/StaticMeshes/Debug_Draw_Helper_Cube.obj");
 }
 
-void Prism::Rendering::DebugDrawHelper::shutdown()
+void Prism::Rendering::DebugDrawHelper::deInitialize()
 {
     clearAll();
-    Actor::shutdown();
 }
 
-void Prism::Rendering::DebugDrawHelper::tick(float deltaTime)
+void Prism::Rendering::DebugDrawHelper::drawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
+                                                   const float lifetimeSeconds, const bool depthTest)
 {
-    Actor::tick(deltaTime);
-    // Check all line and arrow meshes and destroy them if they are expired
-    const auto currentTimeMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).
-        count();
-    std::vector<RawPtr<Core::DebugLineActor>> lineActorsToRemove;
-    for (const auto& lineActor : debugActors)
+    const auto expiryTime = getExpiryTime(lifetimeSeconds);
+    std::scoped_lock lock(mutex);
+    addLine(depthTest ? depthTestedLines : overlayLines, from, to, color, expiryTime);
+}
+
+void Prism::Rendering::DebugDrawHelper::drawLine(const glm::vec3& origin, const glm::vec3& direction,
+                                                   const float length, const glm::vec3& color,
+                                                   const float lifetimeSeconds, const bool depthTest)
+{
+    drawLine(origin, origin + glm::normalize(direction) * length, color, lifetimeSeconds, depthTest);
+}
+
+void Prism::Rendering::DebugDrawHelper::drawArrow(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
+                                                    const float lifetimeSeconds, const bool depthTest)
+{
+    const auto delta = to - from;
+    const float length = glm::length(delta);
+    if (length <= 0.0f)
     {
-        if (lineActor->getLifetime() > 0 && lineActor->getDeathTimeMilliseconds() >= 0 && currentTimeMilliseconds >=
-            lineActor->getDeathTimeMilliseconds())
+        return;
+    }
+
+    const auto direction = delta / length;
+    const auto [right, up] = getOrthonormalBasis(direction);
+    const float headLength = length * arrowHeadLength;
+    const float angle = glm::radians(arrowHeadAngleDegrees);
+    const auto back = -direction * (headLength * std::cos(angle));
+    const float spread = headLength * std::sin(angle);
+
+    const auto expiryTime = getExpiryTime(lifetimeSeconds);
+    std::scoped_lock lock(mutex);
+    auto& lineList = depthTest ? depthTestedLines : overlayLines;
+    addLine(lineList, from, to, color, expiryTime);
+    addLine(lineList, to, to + back + up * spread, color, expiryTime);
+    addLine(lineList, to, to + back - up * spread, color, expiryTime);
+    addLine(lineList, to, to + back + right * spread, color, expiryTime);
+    addLine(lineList, to, to + back - right * spread, color, expiryTime);
+}
+
+void Prism::Rendering::DebugDrawHelper::drawArrow(const glm::vec3& origin, const glm::vec3& direction,
+                                                    const float length, const glm::vec3& color,
+                                                    const float lifetimeSeconds, const bool depthTest)
+{
+    drawArrow(origin, origin + glm::normalize(direction) * length, color, lifetimeSeconds, depthTest);
+}
+
+void Prism::Rendering::DebugDrawHelper::drawBox(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color,
+                                                  const float lifetimeSeconds, const bool depthTest)
+{
+    drawBox((min + max) * 0.5f, (max - min) * 0.5f, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), color, lifetimeSeconds,
+            depthTest);
+}
+
+void Prism::Rendering::DebugDrawHelper::drawBox(const glm::vec3& center, const glm::vec3& halfExtents,
+                                                  const glm::quat& rotation, const glm::vec3& color,
+                                                  const float lifetimeSeconds, const bool depthTest)
+{
+    // Corner i uses the sign bits of i for x, y and z
+    std::array<glm::vec3, 8> corners;
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+        const glm::vec3 sign((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+        corners[i] = center + rotation * (halfExtents * sign);
+    }
+
+    // Edges connect corners that differ in exactly one sign bit
+    constexpr std::array<std::pair<uint32_t, uint32_t>, 12> edges = {
         {
-            lineActorsToRemove.emplace_back(lineActor);
+            {0, 1}, {2, 3}, {4, 5}, {6, 7},
+            {0, 2}, {1, 3}, {4, 6}, {5, 7},
+            {0, 4}, {1, 5}, {2, 6}, {3, 7}
         }
+    };
+
+    const auto expiryTime = getExpiryTime(lifetimeSeconds);
+    std::scoped_lock lock(mutex);
+    auto& lineList = depthTest ? depthTestedLines : overlayLines;
+    for (const auto& [from, to] : edges)
+    {
+        addLine(lineList, corners[from], corners[to], color, expiryTime);
     }
+}
 
-    for (const auto& toRemove : lineActorsToRemove)
+void Prism::Rendering::DebugDrawHelper::drawSphere(const glm::vec3& center, const float radius, const glm::vec3& color,
+                                                     const float lifetimeSeconds, const bool depthTest,
+                                                     const uint32_t segments)
+{
+    if (segments < 3)
     {
-        std::erase_if(debugActors, [toRemove](const auto& a)
-        {
-            return a.get() == toRemove.get();
-        });
+        return;
     }
 
-    for (const auto& lineActor : lineActorsToRemove)
+    const auto expiryTime = getExpiryTime(lifetimeSeconds);
+    const float step = glm::two_pi<float>() / static_cast<float>(segments);
+    std::scoped_lock lock(mutex);
+    auto& lineList = depthTest ? depthTestedLines : overlayLines;
+    // One circle per axis plane
+    for (uint32_t i = 0; i < segments; ++i)
     {
-        sceneManager->unregisterActor(lineActor);
+        const float angle0 = step * static_cast<float>(i);
+        const float angle1 = step * static_cast<float>(i + 1);
+        const float cos0 = std::cos(angle0) * radius;
+        const float sin0 = std::sin(angle0) * radius;
+        const float cos1 = std::cos(angle1) * radius;
+        const float sin1 = std::sin(angle1) * radius;
+        addLine(lineList, center + glm::vec3(cos0, sin0, 0.0f), center + glm::vec3(cos1, sin1, 0.0f), color,
+                expiryTime);
+        addLine(lineList, center + glm::vec3(cos0, 0.0f, sin0), center + glm::vec3(cos1, 0.0f, sin1), color,
+                expiryTime);
+        addLine(lineList, center + glm::vec3(0.0f, cos0, sin0), center + glm::vec3(0.0f, cos1, sin1), color,
+                expiryTime);
     }
 }
 
-void Prism::Rendering::DebugDrawHelper::drawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
-                                                   const float thickness, const uint32_t lifetimeSec)
+void Prism::Rendering::DebugDrawHelper::clearAll()
 {
-    const glm::vec3 midPoint = (from + to) / 2.0f;
-    const auto direction = glm::normalize(midPoint);
-    drawLine(from, direction, to.z, color, thickness, lifetimeSec);
+    std::scoped_lock lock(mutex);
+    depthTestedLines.vertices.clear();
+    depthTestedLines.expiryTimes.clear();
+    overlayLines.vertices.clear();
+    overlayLines.expiryTimes.clear();
 }
 
-void Prism::Rendering::DebugDrawHelper::drawLine(const glm::vec3& origin, const glm::vec3& direction,
-                                                   const float length,
-                                                   const glm::vec3& color, const float thickness,
-                                                   const uint32_t lifetimeSec)
-{
-    const auto rotation = Core::Transform::lookAt(direction, Core::Transform::localUp);
-    const auto lineActor = sceneManager->registerActor(std::make_unique<Core::DebugLineActor>());
-    const auto staticMeshComp = lineActor->getFirstComponentOfType<Core::StaticMeshComponent>();
-    lineActor->setName("DebugLine");
-    staticMeshComp->setStaticMeshAsset(lineMeshAsset);
-    staticMeshComp->setMeshColor(color);
-    staticMeshComp->setCollidable(false);
-    lineActor->setActorPosition(origin);
-    lineActor->setActorScale(glm::vec3(thickness, thickness, length));
-    lineActor->setActorRotation(rotation);
-    lineActor->setLifetime(lifetimeSec * 1000);
-    debugActors.emplace_back(lineActor);
+size_t Prism::Rendering::DebugDrawHelper::getVertexCount() const
+{
+    std::scoped_lock lock(mutex);
+    return depthTestedLines.vertices.size() + overlayLines.vertices.size();
 }
 
-void Prism::Rendering::DebugDrawHelper::drawArrow(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
-                                                    const float thickness, const uint32_t lifetimeSec)
+Prism::Rendering::DebugDrawVertexCounts Prism::Rendering::DebugDrawHelper::copyVerticesAndRemoveExpired(
+    std::vector<DebugLineVertex>& destination)
 {
-    const glm::vec3 midPoint = (from + to) / 2.0f;
-    const auto direction = glm::normalize(midPoint);
-    drawArrow(from, direction, to.z, color, thickness, lifetimeSec);
+    const auto now = Clock::now();
+    std::scoped_lock lock(mutex);
+    DebugDrawVertexCounts counts;
+    counts.depthTested = static_cast<uint32_t>(depthTestedLines.vertices.size());
+    counts.overlay = static_cast<uint32_t>(overlayLines.vertices.size());
+    // Resizing keeps the capacity of earlier frames
+    destination.resize(depthTestedLines.vertices.size() + overlayLines.vertices.size());
+    const auto overlayBegin = std::ranges::copy(depthTestedLines.vertices, destination.begin()).out;
+    std::ranges::copy(overlayLines.vertices, overlayBegin);
+
+    removeExpired(depthTestedLines, now);
+    removeExpired(overlayLines, now);
+    return counts;
 }
 
-void Prism::Rendering::DebugDrawHelper::drawArrow(const glm::vec3& origin, const glm::vec3& direction,
-                                                    const float length,
-                                                    const glm::vec3& color, const float thickness,
-                                                    const uint32_t lifetimeSec)
-{
-    // Main line
-    const auto rotation = Core::Transform::lookAt(direction, Core::Transform::localUp);
-    const auto mainLineActor = sceneManager->registerActor(std::make_unique<Core::DebugLineActor>());
-    const auto mainLineStaticMeshComp = mainLineActor->getFirstComponentOfType<Core::StaticMeshComponent>();
-    mainLineStaticMeshComp->setStaticMeshAsset(lineMeshAsset);
-    mainLineStaticMeshComp->setMeshColor(color);
-    mainLineStaticMeshComp->setCollidable(false);
-    mainLineActor->setName("DebugArrow");
-    mainLineActor->setActorPosition(origin);
-    mainLineActor->setActorScale(glm::vec3(thickness, thickness, length));
-    mainLineActor->setActorRotation(rotation);
-    mainLineActor->setLifetime(lifetimeSec * 1000);
-    debugActors.emplace_back(mainLineActor);
-
-    const auto endPosition = origin + direction * length;
-
-    const auto topLineActor = sceneManager->registerActor(std::make_unique<Core::DebugLineActor>());
-    const auto bottomLineActor = sceneManager->registerActor(std::make_unique<Core::DebugLineActor>());
-    const auto leftLineActor = sceneManager->registerActor(std::make_unique<Core::DebugLineActor>());
-    const auto rightLineActor = sceneManager->registerActor(std::make_unique<Core::DebugLineActor>());
-
-    topLineActor->setName("DebugArrowTop");
-    bottomLineActor->setName("DebugArrowBottom");
-    leftLineActor->setName("DebugArrowLeft");
-    rightLineActor->setName("DebugArrowRight");
-
-    const auto topLineStaticMeshComp = topLineActor->getFirstComponentOfType<Core::StaticMeshComponent>();
-    topLineStaticMeshComp->setMeshColor(color);
-    topLineStaticMeshComp->setCollidable(false);
-    topLineStaticMeshComp->setStaticMeshAsset(lineMeshAsset);
-    const auto bottomLineStaticMeshComp = bottomLineActor->getFirstComponentOfType<Core::StaticMeshComponent>();
-    bottomLineStaticMeshComp->setMeshColor(color);
-    bottomLineStaticMeshComp->setCollidable(false);
-    bottomLineStaticMeshComp->setStaticMeshAsset(lineMeshAsset);
-    const auto leftLineStaticMeshComp = leftLineActor->getFirstComponentOfType<Core::StaticMeshComponent>();
-    leftLineStaticMeshComp->setMeshColor(color);
-    leftLineStaticMeshComp->setCollidable(false);
-    leftLineStaticMeshComp->setStaticMeshAsset(lineMeshAsset);
-    const auto rightLineStaticMeshComp = rightLineActor->getFirstComponentOfType<Core::StaticMeshComponent>();
-    rightLineStaticMeshComp->setMeshColor(color);
-    rightLineStaticMeshComp->setCollidable(false);
-    rightLineStaticMeshComp->setStaticMeshAsset(lineMeshAsset);
-
-    topLineActor->setLifetime(lifetimeSec * 1000);
-    bottomLineActor->setLifetime(lifetimeSec * 1000);
-    leftLineActor->setLifetime(lifetimeSec * 1000);
-    rightLineActor->setLifetime(lifetimeSec * 1000);
-    debugActors.emplace_back(topLineActor);
-    debugActors.emplace_back(bottomLineActor);
-    debugActors.emplace_back(leftLineActor);
-    debugActors.emplace_back(rightLineActor);
-
-    topLineActor->setActorPosition(endPosition);
-    bottomLineActor->setActorPosition(endPosition);
-    leftLineActor->setActorPosition(endPosition);
-    rightLineActor->setActorPosition(endPosition);
-
-    topLineActor->setActorRotation(rotation);
-    topLineActor->rotateActor(glm::vec3(arrowHeadAngleDegrees, 180.0f, 0.0f));
-    bottomLineActor->setActorRotation(rotation);
-    bottomLineActor->rotateActor(glm::vec3(-arrowHeadAngleDegrees, 180.0f, 0.0f));
-    leftLineActor->setActorRotation(rotation);
-    leftLineActor->rotateActor(glm::vec3(0.0f, -(180.0f + arrowHeadAngleDegrees), 0.0f));
-    rightLineActor->setActorRotation(rotation);
-    rightLineActor->rotateActor(glm::vec3(0.0f, 180.0f + arrowHeadAngleDegrees, 0.0f));
-
-    topLineActor->setActorScale(glm::vec3(thickness, thickness, length * arrowHeadLength));
-    bottomLineActor->setActorScale(glm::vec3(thickness, thickness, length * arrowHeadLength));
-    leftLineActor->setActorScale(glm::vec3(thickness, thickness, length * arrowHeadLength));
-    rightLineActor->setActorScale(glm::vec3(thickness, thickness, length * arrowHeadLength));
+void Prism::Rendering::DebugDrawHelper::addLine(LineList& lineList, const glm::vec3& from, const glm::vec3& to,
+                                                  const glm::vec3& color, const Clock::time_point expiryTime)
+{
+    lineList.vertices.emplace_back(DebugLineVertex{from, color});
+    lineList.vertices.emplace_back(DebugLineVertex{to, color});
+    lineList.expiryTimes.emplace_back(expiryTime);
 }
 
-void Prism::Rendering::DebugDrawHelper::clearAll()
+Prism::Rendering::DebugDrawHelper::Clock::time_point Prism::Rendering::DebugDrawHelper::getExpiryTime(
+    const float lifetimeSeconds)
 {
-    for (const auto& lineActor : debugActors)
+    if (lifetimeSeconds < 0.0f)
     {
-        sceneManager->unregisterActor(lineActor);
+        return Clock::time_point::max();
+    }
+    return Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(lifetimeSeconds));
+}
+
+std::pair<glm::vec3, glm::vec3> Prism::Rendering::DebugDrawHelper::getOrthonormalBasis(const glm::vec3& direction)
+{
+    // Pick the reference axis least aligned with the direction to avoid a degenerate cross product
+    const auto reference = std::abs(direction.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    const auto right = glm::normalize(glm::cross(reference, direction));
+    const auto up = glm::cross(direction, right);
+    return {right, up};
+}
+
+void Prism::Rendering::DebugDrawHelper::removeExpired(LineList& lineList, const Clock::time_point now)
+{
+    // Stable in-place compaction, vertices move in pairs with their line
+    size_t writeIndex = 0;
+    for (size_t readIndex = 0; readIndex < lineList.expiryTimes.size(); ++readIndex)
+    {
+        if (lineList.expiryTimes[readIndex] <= now)
+        {
+            continue;
+        }
+        if (writeIndex != readIndex)
+        {
+            lineList.expiryTimes[writeIndex] = lineList.expiryTimes[readIndex];
+            lineList.vertices[writeIndex * 2] = lineList.vertices[readIndex * 2];
+            lineList.vertices[writeIndex * 2 + 1] = lineList.vertices[readIndex * 2 + 1];
+        }
+        ++writeIndex;
     }
-    debugActors.clear();
+    lineList.expiryTimes.resize(writeIndex);
+    lineList.vertices.resize(writeIndex * 2);
 }
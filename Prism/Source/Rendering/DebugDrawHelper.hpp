@@ -1,38 +1,85 @@
 ﻿#pragma once
+#include <chrono>
+#include <mutex>
+#include <vector>
 #include <glm/vec3.hpp>
-#include "../Core/ISceneManager.hpp"
-#include "../Core/DebugLineActor.hpp"
-#include "../Assets/StaticMeshAsset.hpp"
-#include "../Utilities/Globals.hpp"
+#include <glm/gtc/quaternion.hpp>
+#include "DebugLineVertex.hpp"
+#include "../Utilities/IService.hpp"
 
 namespace Prism::Rendering
 {
-    class DebugDrawHelper : public Core::Actor
+    struct DebugDrawVertexCounts
+    {
+        uint32_t depthTested = 0;
+        uint32_t overlay = 0;
+    };
+
+    /*
+     * Immediate mode debug primitives. Everything is appended to plain CPU line lists which the renderer uploads once
+     * per frame and draws with a single line list pipeline per depth mode, nothing here touches the scene graph.
+     * A lifetime of 0 draws the primitive for exactly one frame, a negative lifetime keeps it until clearAll().
+     * Safe to call from any thread.
+     */
+    class DebugDrawHelper : public Utility::IService
     {
     public:
-        DebugDrawHelper();
+        inline constexpr static float persistentLifetime = -1.0f;
+
         ~DebugDrawHelper() override = default;
-        void tick(float deltaTime) override;
-        void drawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float thickness = 1.0f,
-                      uint32_t lifetimeSec = 5.0f);
+        void initialize() override;
+        void initializeDeferred() override;
+        void deInitialize() override;
+
+        std::string getFullName() override
+        {
+            return "Prism::Rendering::DebugDrawHelper";
+        }
+
+        void drawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
+                      float lifetimeSeconds = 0.0f, bool depthTest = true);
         void drawLine(const glm::vec3& origin, const glm::vec3& direction, float length, const glm::vec3& color,
-                      float thickness = 1.0f, uint32_t lifetimeSec = 5.0f);
-        void drawArrow(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float thickness = 1.0f,
-                       uint32_t lifetimeSec = 5.0f);
+                      float lifetimeSeconds = 0.0f, bool depthTest = true);
+        void drawArrow(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
+                       float lifetimeSeconds = 0.0f, bool depthTest = true);
         void drawArrow(const glm::vec3& origin, const glm::vec3& direction, float length, const glm::vec3& color,
-                       float thickness = 1.0f, uint32_t lifetimeSec = 5.0f);
+                       float lifetimeSeconds = 0.0f, bool depthTest = true);
+        void drawBox(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color,
+                     float lifetimeSeconds = 0.0f, bool depthTest = true);
+        void drawBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& rotation,
+                     const glm::vec3& color, float lifetimeSeconds = 0.0f, bool depthTest = true);
+        void drawSphere(const glm::vec3& center, float radius, const glm::vec3& color, float lifetimeSeconds = 0.0f,
+                        bool depthTest = true, uint32_t segments = 24);
         void clearAll();
 
-    protected:
-        void init() override;
-        void shutdown() override;
+        [[nodiscard]] size_t getVertexCount() const;
+        /*
+         * Copies all depth tested lines, then all overlay lines into destination and removes the expired ones.
+         * Both happen under one lock, so single frame lines drawn concurrently are never removed without being copied.
+         */
+        DebugDrawVertexCounts copyVerticesAndRemoveExpired(std::vector<DebugLineVertex>& destination);
 
     private:
-        RawPtr<Core::ISceneManager> sceneManager;
-        RawPtr<Assets::StaticMeshAsset> lineMeshAsset;
-        std::vector<RawPtr<Core::DebugLineActor>> debugActors;
+        using Clock = std::chrono::steady_clock;
+
+        struct LineList
+        {
+            std::vector<DebugLineVertex> vertices;
+            // One entry per line, Clock::time_point::max() for persistent lines
+            std::vector<Clock::time_point> expiryTimes;
+        };
 
         inline constexpr static float arrowHeadAngleDegrees = 30.0f;
         inline constexpr static float arrowHeadLength = 0.125f;
+
+        mutable std::mutex mutex;
+        LineList depthTestedLines;
+        LineList overlayLines;
+
+        void addLine(LineList& lineList, const glm::vec3& from, const glm::vec3& to, const glm::vec3& color,
+                     Clock::time_point expiryTime);
+        [[nodiscard]] static Clock::time_point getExpiryTime(float lifetimeSeconds);
+        [[nodiscard]] static std::pair<glm::vec3, glm::vec3> getOrthonormalBasis(const glm::vec3& direction);
+        static void removeExpired(LineList& lineList, Clock::time_point now);
     };
 }
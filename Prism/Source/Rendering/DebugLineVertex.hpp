@@ -0,0 +1,37 @@
+﻿#pragma once
+#include "glm/glm.hpp"
+#include "vulkan/vulkan.hpp"
+
+namespace Prism::Rendering
+{
+    struct DebugLineVertex
+    {
+        glm::vec3 position;
+        glm::vec3 color;
+
+        static vk::VertexInputBindingDescription getBindingDescription()
+        {
+            vk::VertexInputBindingDescription bindingDescription;
+            bindingDescription.binding = 0;
+            bindingDescription.stride = sizeof(DebugLineVertex);
+            bindingDescription.inputRate = vk::VertexInputRate::eVertex;
+            return bindingDescription;
+        }
+
+        static std::array<vk::VertexInputAttributeDescription, 2> getAttributeDescriptions()
+        {
+            std::array<vk::VertexInputAttributeDescription, 2> attributeDescriptions = {};
+            attributeDescriptions[0].binding = 0;
+            attributeDescriptions[0].location = 0;
+            attributeDescriptions[0].format = vk::Format::eR32G32B32Sfloat;
+            attributeDescriptions[0].offset = offsetof(DebugLineVertex, position);
+
+            attributeDescriptions[1].binding = 0;
+            attributeDescriptions[1].location = 1;
+            attributeDescriptions[1].format = vk::Format::eR32G32B32Sfloat;
+            attributeDescriptions[1].offset = offsetof(DebugLineVertex, color);
+
+            return attributeDescriptions;
+        }
+    };
+}
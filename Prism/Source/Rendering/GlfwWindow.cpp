@@ -19,10 +19,10 @@ void Prism::Rendering::GlfwWindow::init()
     glfwSetWindowUserPointer(window, this);
     glfwSetFramebufferSizeCallback(window, onFrameBufferResized);
     const auto inputManager = Utility::ServiceLocator::getService<Input::IInputManager>();
-    // Manually initialize cursor callback here as the renderer may init ImGui which will init its own callback which in turn calls our callback.
-    // If this step is skipped, the inputmanager will later override the ImGui callback with its own callback which in turn causes ImGui to not work.
+    // Manually initialize input callbacks here as the renderer may init ImGui which will init its own callbacks which in turn call our callbacks.
+    // If this step is skipped, the inputmanager will later override the ImGui callbacks with its own callbacks which in turn causes ImGui to not work.
     // This may be changed if a MessageBus is implemented.
-    inputManager->initCursorCallback();
+    inputManager->initInputCallbacks();
     rendererManager = Utility::ServiceLocator::getService<IRendererManager>();
     auto vulkanRenderer = std::make_unique<Vulkan::VulkanRenderer>(window);
     renderer = vulkanRenderer.get();
@@ -32,7 +32,7 @@ void Prism::Rendering::GlfwWindow::init()
 
 void Prism::Rendering::GlfwWindow::tick(const float deltaTime)
 {
-    renderer->render();
+    // Frames are rendered by the Engine's RenderThread from the packets it extracts
 }
 
 void Prism::Rendering::GlfwWindow::shutdown()
@@ -50,6 +50,12 @@ bool Prism::Rendering::GlfwWindow::isShutdownRequested()
 
 void Prism::Rendering::GlfwWindow::pollWindowEvents()
 {
+    // Nothing is rendered while minimized, blocking keeps the frame loop from spinning until the window is restored
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED))
+    {
+        glfwWaitEvents();
+        return;
+    }
     glfwPollEvents();
 }
 
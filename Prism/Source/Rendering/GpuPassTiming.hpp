@@ -0,0 +1,11 @@
+﻿#pragma once
+
+namespace Prism::Rendering
+{
+    struct GpuPassTiming
+    {
+        // Static string, passes are named by the renderer
+        const char* name;
+        float milliseconds;
+    };
+}
@@ -0,0 +1,24 @@
+﻿#include "HeadlessWindow.hpp"
+#include "NullRenderer.hpp"
+#include "../Utilities/Logging/Log.hpp"
+#include "../Utilities/ServiceLocator.hpp"
+
+void Prism::Rendering::HeadlessWindow::init()
+{
+    LOG_DEBUG("Running headless, nothing will be rendered");
+    const auto rendererManager = Utility::ServiceLocator::getService<IRendererManager>();
+    auto nullRenderer = std::make_unique<NullRenderer>();
+    renderer = nullRenderer.get();
+    rendererManager->setActiveRenderer(std::move(nullRenderer));
+    renderer->init();
+}
+
+void Prism::Rendering::HeadlessWindow::tick(const float deltaTime)
+{
+    // Frames are rendered by the Engine's RenderThread from the packets it extracts
+}
+
+void Prism::Rendering::HeadlessWindow::shutdown()
+{
+    renderer->shutdown();
+}
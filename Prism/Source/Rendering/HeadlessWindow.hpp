@@ -0,0 +1,36 @@
+﻿#pragma once
+#include <string>
+
+#include "IWindow.hpp"
+#include "IRendererManager.hpp"
+#include "../Utilities/Globals.hpp"
+
+namespace Prism::Rendering
+{
+    // Window without any OS window behind it, drives a NullRenderer. Used by the --headless command line option.
+    class HeadlessWindow : public IWindow
+    {
+    public:
+        ~HeadlessWindow() override = default;
+        void init() override;
+        void tick(float deltaTime) override;
+        void shutdown() override;
+
+        // Headless runs are ended through the IEngineManager
+        bool isShutdownRequested() override
+        {
+            return false;
+        }
+
+        void pollWindowEvents() override
+        {
+        }
+
+        void setWindowTitle(const std::string& title) override
+        {
+        }
+
+    private:
+        RawPtr<IRenderer> renderer;
+    };
+}
@@ -1,6 +1,9 @@
 ﻿#pragma once
+#include <span>
 #include "Vulkan/ImGui/AbstractImmediateModeGui.hpp"
 #include "../Core/StaticMesh.hpp"
+#include "GpuPassTiming.hpp"
+#include "RenderFramePacket.hpp"
 
 namespace Prism::Rendering
 {
@@ -9,11 +12,25 @@ namespace Prism::Rendering
     public:
         virtual ~IRenderer() = default;
         virtual void init() = 0;
-        virtual void render() = 0;
+        // Main thread, at the end of the update: copies everything the frame needs out of the scene
+        virtual void extract(RenderFramePacket& packet) = 0;
+        // Runs on the RenderThread while the main thread updates the next frame, never touches the scene
+        virtual void render(const RenderFramePacket& packet) = 0;
+        // Main thread while render() isn't running, updates what the statistics getters below report
+        virtual void publishFrameStatistics() = 0;
+        [[nodiscard]] virtual bool isLowLatencyEnabled() const = 0;
+        // Called right before input is sampled in low latency mode while render() isn't running, blocks until the
+        // GPU finished the last frame
+        virtual void waitBeforeInputSampling() = 0;
         virtual void shutdown() = 0;
         virtual RawPtr<AbstractImmediateModeGui> getImmediateModeGui() = 0;
         virtual void onFrameBufferResized(int width, int height) = 0;
+        // Main thread, take effect with the next extracted packet
         virtual void registerNewStaticMesh(RawPtr<Core::StaticMesh> staticMesh) = 0;
         virtual void unregisterStaticMesh(uint64_t staticMeshId) = 0;
+        // GPU execution time of each pass of the most recently completed frame, empty if unsupported
+        [[nodiscard]] virtual std::span<const GpuPassTiming> getGpuPassTimings() const = 0;
+        // Static mesh draws recorded for the most recently rendered frame
+        [[nodiscard]] virtual uint32_t getDrawCount() const = 0;
     };
 }
@@ -0,0 +1,50 @@
+﻿#include "NullRenderer.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+void Prism::Rendering::NullRenderer::init()
+{
+    extractor.init();
+}
+
+void Prism::Rendering::NullRenderer::extract(RenderFramePacket& packet)
+{
+    PRISM_PROFILE_SCOPE("NullRenderer::extract");
+    extractor.extract(packet, aspectRatio);
+}
+
+void Prism::Rendering::NullRenderer::render(const RenderFramePacket& packet)
+{
+    PRISM_PROFILE_SCOPE("NullRenderer::render");
+    for (const auto& registration : packet.registeredMeshes)
+    {
+        registeredMeshIds.insert(registration.meshId);
+    }
+    for (const auto meshId : packet.unregisteredMeshIds)
+    {
+        registeredMeshIds.erase(meshId);
+    }
+    // Same as the VulkanRenderer, instances of meshes it has no buffers for are skipped
+    renderedDrawCount = 0;
+    for (const auto& meshInstance : packet.meshInstances)
+    {
+        if (registeredMeshIds.contains(meshInstance.meshId))
+        {
+            ++renderedDrawCount;
+        }
+    }
+}
+
+void Prism::Rendering::NullRenderer::shutdown()
+{
+    registeredMeshIds.clear();
+}
+
+void Prism::Rendering::NullRenderer::registerNewStaticMesh(const RawPtr<Core::StaticMesh> staticMesh)
+{
+    extractor.registerStaticMesh(staticMesh);
+}
+
+void Prism::Rendering::NullRenderer::unregisterStaticMesh(const uint64_t staticMeshId)
+{
+    extractor.unregisterStaticMesh(staticMeshId);
+}
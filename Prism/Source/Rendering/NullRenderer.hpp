@@ -0,0 +1,70 @@
+﻿#pragma once
+#include <unordered_set>
+
+#include "IRenderer.hpp"
+#include "RenderFrameExtractor.hpp"
+#include "../Utilities/Globals.hpp"
+
+namespace Prism::Rendering
+{
+    /*
+     * Renderer for headless runs. It extracts the drawable components like the VulkanRenderer does and counts the draws it
+     * would record, but never touches a GPU, so the CPU side of a frame can be measured without a window.
+     */
+    class NullRenderer final : public IRenderer
+    {
+    public:
+        ~NullRenderer() override = default;
+        void init() override;
+        void extract(RenderFramePacket& packet) override;
+        void render(const RenderFramePacket& packet) override;
+        void shutdown() override;
+
+        void publishFrameStatistics() override
+        {
+            drawCount = renderedDrawCount;
+        }
+
+        [[nodiscard]] bool isLowLatencyEnabled() const override
+        {
+            return false;
+        }
+
+        void waitBeforeInputSampling() override
+        {
+        }
+
+        // There is nothing to draw ImGui into
+        RawPtr<AbstractImmediateModeGui> getImmediateModeGui() override
+        {
+            return nullptr;
+        }
+
+        void onFrameBufferResized(int width, int height) override
+        {
+        }
+
+        void registerNewStaticMesh(RawPtr<Core::StaticMesh> staticMesh) override;
+        void unregisterStaticMesh(uint64_t staticMeshId) override;
+
+        [[nodiscard]] std::span<const GpuPassTiming> getGpuPassTimings() const override
+        {
+            return {};
+        }
+
+        [[nodiscard]] uint32_t getDrawCount() const override
+        {
+            return drawCount;
+        }
+
+    private:
+        // Aspect ratio of the window the GlfwWindow would open
+        inline constexpr static float aspectRatio = 16.0f / 9.0f;
+
+        RenderFrameExtractor extractor;
+        // Only touched by render()
+        std::unordered_set<uint64_t> registeredMeshIds;
+        uint32_t renderedDrawCount = 0;
+        uint32_t drawCount = 0;
+    };
+}
@@ -0,0 +1,111 @@
+﻿#include "RenderFrameExtractor.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../Core/StaticMeshComponent.hpp"
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/ServiceLocator.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<bool> cvarFrustumCulling(
+        "renderer.frustumCulling", true, "Only draw static meshes whose bounds intersect the camera frustum");
+}
+
+void Prism::Rendering::RenderFrameExtractor::init()
+{
+    cameraManager = Utility::ServiceLocator::getService<ICameraManager>();
+    spatialIndex = Utility::ServiceLocator::getService<Core::SpatialIndex>();
+    debugDrawHelper = Utility::ServiceLocator::getService<DebugDrawHelper>();
+}
+
+void Prism::Rendering::RenderFrameExtractor::registerStaticMesh(const RawPtr<Core::StaticMesh> staticMesh)
+{
+    pendingMeshRegistrations.push_back({staticMesh->getMeshId(), staticMesh->getMeshAsset()});
+}
+
+void Prism::Rendering::RenderFrameExtractor::unregisterStaticMesh(const uint64_t staticMeshId)
+{
+    pendingMeshUnregistrations.push_back(staticMeshId);
+}
+
+void Prism::Rendering::RenderFrameExtractor::extract(RenderFramePacket& packet, const float aspectRatio)
+{
+    PRISM_PROFILE_SCOPE("RenderFrameExtractor::extract");
+    packet.frameNumber = frameNumber++;
+    // Swapping hands the queued changes over and the packet's emptied vectors back for the next frame
+    packet.registeredMeshes.clear();
+    packet.unregisteredMeshIds.clear();
+    std::swap(packet.registeredMeshes, pendingMeshRegistrations);
+    std::swap(packet.unregisteredMeshIds, pendingMeshUnregistrations);
+
+    extractCamera(packet, aspectRatio);
+    extractStaticMeshes(packet);
+    extractDebugLines(packet);
+}
+
+void Prism::Rendering::RenderFrameExtractor::extractCamera(RenderFramePacket& packet, const float aspectRatio) const
+{
+    if (const auto activeCamera = cameraManager->getActiveCamera())
+    {
+        auto cameraTransform = activeCamera->getAbsoluteTransform();
+        packet.view = cameraTransform.toMatrix(true);
+        packet.projection = glm::perspective(glm::radians(activeCamera->fov), aspectRatio, activeCamera->zNear,
+                                             activeCamera->zFar);
+        packet.lightPosition = cameraTransform.getTranslation();
+    }
+    else
+    {
+        packet.view = glm::lookAt(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 0.0f),
+                                  glm::vec3(0.0f, 1.0f, 0.0f));
+        packet.projection = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 10.0f);
+        packet.lightPosition = glm::vec3(0.0f, 0.0f, 0.0f);
+    }
+}
+
+void Prism::Rendering::RenderFrameExtractor::extractStaticMeshes(RenderFramePacket& packet)
+{
+    visibleStaticMeshComponents.clear();
+    if (cvarFrustumCulling.get())
+    {
+        spatialIndex->queryFrustum(Core::Frustum::fromViewProjection(packet.projection * packet.view),
+                                   visibleStaticMeshComponents);
+    }
+    else
+    {
+        // The index holds exactly the components with a mesh and is kept in sync by the scene journal
+        spatialIndex->forEachComponent([this](const Core::SpatialIndexHandle&,
+                                              const RawPtr<Core::StaticMeshComponent>& staticMeshComponent,
+                                              const Core::Aabb&)
+        {
+            visibleStaticMeshComponents.push_back(staticMeshComponent);
+        });
+    }
+
+    packet.meshInstances.clear();
+    for (const auto& staticMeshComponent : visibleStaticMeshComponents)
+    {
+        if (!staticMeshComponent || !staticMeshComponent->isVisible())
+        {
+            continue;
+        }
+        const auto staticMesh = staticMeshComponent->getStaticMesh();
+        // Mesh asset is not assigned or still loading
+        if (!staticMesh)
+        {
+            continue;
+        }
+        packet.meshInstances.push_back({
+            staticMesh->getMeshId(),
+            static_cast<uint32_t>(staticMeshComponent->getStaticMeshAsset()->getIndices().size()),
+            staticMeshComponent->getAbsoluteTransform().toMatrix(), staticMeshComponent->getMeshColor()
+        });
+    }
+}
+
+void Prism::Rendering::RenderFrameExtractor::extractDebugLines(RenderFramePacket& packet) const
+{
+    // Lines of this frame end up in the packet, single frame and expired ones are removed in the same step
+    packet.debugLineCounts = debugDrawHelper->copyVerticesAndRemoveExpired(packet.debugLineVertices);
+}
@@ -0,0 +1,43 @@
+﻿#pragma once
+#include <vector>
+
+#include "ICameraManager.hpp"
+#include "DebugDrawHelper.hpp"
+#include "RenderFramePacket.hpp"
+#include "../Core/SpatialIndex.hpp"
+#include "../Core/StaticMesh.hpp"
+#include "../Utilities/Globals.hpp"
+
+namespace Prism::Rendering
+{
+    /*
+     * Copies the render relevant state of the active scene into RenderFramePackets. Shared by the renderers, which add
+     * their own data on top, e.g. the ImGui draw lists. Only to be used from the main thread.
+     */
+    class RenderFrameExtractor
+    {
+    public:
+        void init();
+
+        // Queued until the next extraction, the renderer applies them when it renders that packet
+        void registerStaticMesh(RawPtr<Core::StaticMesh> staticMesh);
+        void unregisterStaticMesh(uint64_t staticMeshId);
+
+        // The aspect ratio is the one of the surface the packet will be drawn to
+        void extract(RenderFramePacket& packet, float aspectRatio);
+
+    private:
+        RawPtr<ICameraManager> cameraManager;
+        RawPtr<Core::SpatialIndex> spatialIndex;
+        RawPtr<DebugDrawHelper> debugDrawHelper;
+        uint64_t frameNumber = 0;
+        std::vector<RenderMeshRegistration> pendingMeshRegistrations;
+        std::vector<uint64_t> pendingMeshUnregistrations;
+        // Reused every frame to avoid allocating
+        std::vector<RawPtr<Core::StaticMeshComponent>> visibleStaticMeshComponents;
+
+        void extractCamera(RenderFramePacket& packet, float aspectRatio) const;
+        void extractStaticMeshes(RenderFramePacket& packet);
+        void extractDebugLines(RenderFramePacket& packet) const;
+    };
+}
@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "DebugDrawHelper.hpp"
+#include "Vulkan/ImGui/ImGuiDrawDataSnapshot.hpp"
+#include "../Assets/AssetHandle.hpp"
+#include "../Assets/MeshAsset.hpp"
+
+namespace Prism::Rendering
+{
+    struct RenderMeshInstance
+    {
+        uint64_t meshId = 0;
+        uint32_t indexCount = 0;
+        glm::mat4 model = glm::mat4(1.0f);
+        glm::vec3 color = glm::vec3(1.0f);
+    };
+
+    struct RenderMeshRegistration
+    {
+        uint64_t meshId = 0;
+        // Keeps the vertices alive until the renderer uploaded them, even if the mesh is gone by then
+        Assets::AssetHandle<Assets::MeshAsset> meshAsset;
+    };
+
+    /*
+     * Everything a renderer needs to draw one frame, copied out of the scene at the end of the update. render() only
+     * reads the packet, so the main thread can simulate the next frame while this one is recorded. Packets are reused,
+     * their vectors keep their capacity, so extracting doesn't allocate in steady state.
+     */
+    struct RenderFramePacket
+    {
+        uint64_t frameNumber = 0;
+        glm::mat4 view = glm::mat4(1.0f);
+        glm::mat4 projection = glm::mat4(1.0f);
+        glm::vec3 lightPosition = glm::vec3(0.0f);
+        // Visible static meshes, already frustum culled
+        std::vector<RenderMeshInstance> meshInstances;
+        // Mesh changes since the previous packet, registrations apply before unregistrations
+        std::vector<RenderMeshRegistration> registeredMeshes;
+        std::vector<uint64_t> unregisteredMeshIds;
+        // Depth tested lines first, then overlay ones
+        std::vector<DebugLineVertex> debugLineVertices;
+        DebugDrawVertexCounts debugLineCounts;
+        // Empty for renderers without ImGui
+        ImGuiDrawDataSnapshot imGuiDrawData;
+    };
+}
@@ -0,0 +1,140 @@
+﻿#include "RenderThread.hpp"
+
+#include "../Utilities/ConsoleVariables.hpp"
+#include "../Utilities/Profiling/AllocationTracker.hpp"
+#include "../Utilities/Profiling/Profiler.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<bool> cvarRenderThread(
+        "renderer.renderThread", true,
+        "Render on a thread of its own while the next frame is updated, off renders on the main thread after the update");
+}
+
+Prism::Rendering::RenderThread::~RenderThread()
+{
+    stop();
+}
+
+void Prism::Rendering::RenderThread::start(const RawPtr<IRenderer> newRenderer)
+{
+    renderer = newRenderer;
+    stopRequested = false;
+    thread = std::thread(&RenderThread::threadLoop, this);
+}
+
+void Prism::Rendering::RenderThread::stop()
+{
+    if (!thread.joinable())
+    {
+        return;
+    }
+    {
+        std::scoped_lock lock(mutex);
+        stopRequested = true;
+    }
+    frameSubmitted.notify_one();
+    thread.join();
+}
+
+void Prism::Rendering::RenderThread::submit()
+{
+    {
+        PRISM_PROFILE_SCOPE("RenderThread::waitForIdle");
+        waitForIdle();
+    }
+    // Nothing renders right now, so the renderer can hand out what the last frame measured
+    lastRenderTime = std::chrono::nanoseconds(renderStopWatch.getTimeInNanoseconds());
+    renderer->publishFrameStatistics();
+
+    const auto& packet = packets[extractionPacketIndex];
+    extractionPacketIndex = (extractionPacketIndex + 1) % static_cast<uint32_t>(packets.size());
+    if (!cvarRenderThread.get() || !thread.joinable())
+    {
+        renderFrame(packet);
+        lastRenderTime = std::chrono::nanoseconds(renderStopWatch.getTimeInNanoseconds());
+        renderer->publishFrameStatistics();
+        return;
+    }
+    {
+        std::scoped_lock lock(mutex);
+        pendingPacket = &packet;
+        busy = true;
+    }
+    frameSubmitted.notify_one();
+}
+
+void Prism::Rendering::RenderThread::waitForIdle()
+{
+    std::exception_ptr exception;
+    {
+        std::unique_lock lock(mutex);
+        frameRendered.wait(lock, [this]
+        {
+            return !busy;
+        });
+        std::swap(exception, renderException);
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void Prism::Rendering::RenderThread::waitBeforeInputSampling()
+{
+    if (!renderer->isLowLatencyEnabled())
+    {
+        return;
+    }
+    waitForIdle();
+    renderer->waitBeforeInputSampling();
+}
+
+void Prism::Rendering::RenderThread::threadLoop()
+{
+    PRISM_PROFILE_THREAD("Render");
+    PRISM_ALLOCATION_SCOPE("Renderer");
+    while (true)
+    {
+        const RenderFramePacket* packet;
+        {
+            std::unique_lock lock(mutex);
+            frameSubmitted.wait(lock, [this]
+            {
+                return stopRequested || pendingPacket;
+            });
+            // A frame submitted right before stopping is still rendered
+            if (!pendingPacket)
+            {
+                return;
+            }
+            packet = pendingPacket;
+            pendingPacket = nullptr;
+        }
+
+        std::exception_ptr exception;
+        try
+        {
+            renderFrame(*packet);
+        }
+        catch (...)
+        {
+            // The main thread rethrows it, like it would if it had rendered itself
+            exception = std::current_exception();
+        }
+        {
+            std::scoped_lock lock(mutex);
+            renderException = exception;
+            busy = false;
+        }
+        frameRendered.notify_one();
+    }
+}
+
+void Prism::Rendering::RenderThread::renderFrame(const RenderFramePacket& packet)
+{
+    renderStopWatch.start();
+    renderer->render(packet);
+    renderStopWatch.stop();
+}
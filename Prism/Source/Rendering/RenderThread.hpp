@@ -0,0 +1,75 @@
+﻿#pragma once
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "IRenderer.hpp"
+#include "RenderFramePacket.hpp"
+#include "../Utilities/Globals.hpp"
+#include "../Utilities/StopWatch.hpp"
+
+namespace Prism::Rendering
+{
+    /*
+     * Runs IRenderer::render on a thread of its own, so frame N is recorded and submitted while the main thread
+     * simulates frame N+1. Packets are double buffered: the main thread extracts into one while the render thread
+     * reads the other, submit() swaps them once the render thread is done with its frame.
+     * With renderer.renderThread off, submit() renders on the calling thread instead.
+     * All functions are to be called from the main thread.
+     */
+    class RenderThread
+    {
+    public:
+        RenderThread() = default;
+        RenderThread(const RenderThread& other) = delete;
+        RenderThread(RenderThread&& other) noexcept = delete;
+        RenderThread& operator=(const RenderThread& other) = delete;
+        RenderThread& operator=(RenderThread&& other) noexcept = delete;
+        ~RenderThread();
+
+        void start(RawPtr<IRenderer> newRenderer);
+        // Finishes the frame being rendered and joins the thread
+        void stop();
+
+        // The packet to extract the next frame into, the render thread doesn't touch it until submit()
+        [[nodiscard]] RenderFramePacket& getExtractionPacket()
+        {
+            return packets[extractionPacketIndex];
+        }
+
+        // Waits for the previous frame, then hands the extracted packet over
+        void submit();
+        // Blocks until the render thread finished the frame it is working on, rethrows what rendering it threw
+        void waitForIdle();
+        // In low latency mode the GPU is waited for, which needs the previous frame to be submitted first
+        void waitBeforeInputSampling();
+
+        // Time render() took for the most recently finished frame, as of the last submit()
+        [[nodiscard]] std::chrono::nanoseconds getLastRenderTime() const
+        {
+            return lastRenderTime;
+        }
+
+    private:
+        void threadLoop();
+        void renderFrame(const RenderFramePacket& packet);
+
+        RawPtr<IRenderer> renderer;
+        std::array<RenderFramePacket, 2> packets;
+        uint32_t extractionPacketIndex = 0;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable frameSubmitted;
+        std::condition_variable frameRendered;
+        // Guarded by the mutex
+        const RenderFramePacket* pendingPacket = nullptr;
+        bool busy = false;
+        bool stopRequested = false;
+        std::exception_ptr renderException;
+        // Written by whichever thread renders, read after the handoff through the mutex
+        Utility::StopWatch renderStopWatch;
+        std::chrono::nanoseconds lastRenderTime = std::chrono::nanoseconds::zero();
+    };
+}
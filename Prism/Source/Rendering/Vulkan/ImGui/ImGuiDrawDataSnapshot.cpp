@@ -0,0 +1,45 @@
+﻿#include "ImGuiDrawDataSnapshot.hpp"
+
+#include <cstring>
+
+namespace
+{
+    // ImVector's assignment frees and reallocates, resizing keeps the capacity of earlier frames
+    template <typename T>
+    void copyVector(ImVector<T>& destination, const ImVector<T>& source)
+    {
+        destination.resize(source.Size);
+        if (source.Size > 0)
+        {
+            std::memcpy(destination.Data, source.Data, source.size_in_bytes());
+        }
+    }
+}
+
+void Prism::Rendering::ImGuiDrawDataSnapshot::capture(const ImDrawData& source)
+{
+    while (drawLists.size() < static_cast<size_t>(source.CmdListsCount))
+    {
+        drawLists.emplace_back(std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData()));
+    }
+
+    drawData.Clear();
+    for (int i = 0; i < source.CmdListsCount; ++i)
+    {
+        const auto& sourceList = *source.CmdLists[i];
+        auto& drawList = *drawLists[i];
+        copyVector(drawList.CmdBuffer, sourceList.CmdBuffer);
+        copyVector(drawList.IdxBuffer, sourceList.IdxBuffer);
+        copyVector(drawList.VtxBuffer, sourceList.VtxBuffer);
+        drawList.Flags = sourceList.Flags;
+        drawData.CmdLists.push_back(&drawList);
+    }
+    drawData.Valid = source.Valid;
+    drawData.CmdListsCount = source.CmdListsCount;
+    drawData.TotalIdxCount = source.TotalIdxCount;
+    drawData.TotalVtxCount = source.TotalVtxCount;
+    drawData.DisplayPos = source.DisplayPos;
+    drawData.DisplaySize = source.DisplaySize;
+    drawData.FramebufferScale = source.FramebufferScale;
+    drawData.OwnerViewport = source.OwnerViewport;
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+
+#include "imgui.h"
+
+namespace Prism::Rendering
+{
+    /*
+     * Copy of the draw data of one ImGui frame. ImGui rebuilds its draw lists on every NewFrame, the copy lets the
+     * render thread draw a frame's UI while the main thread already builds the next one. The lists are reused, so
+     * capturing only allocates when the UI grows.
+     */
+    class ImGuiDrawDataSnapshot
+    {
+    public:
+        // Main thread, right after ImGui::Render()
+        void capture(const ImDrawData& source);
+
+        // Empty until the first capture. The backends take a mutable pointer but only read from it.
+        [[nodiscard]] ImDrawData* getDrawData() const
+        {
+            return const_cast<ImDrawData*>(&drawData);
+        }
+
+    private:
+        ImDrawData drawData;
+        std::vector<std::unique_ptr<ImDrawList>> drawLists;
+    };
+}
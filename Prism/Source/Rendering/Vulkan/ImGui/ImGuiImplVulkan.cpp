@@ -11,10 +11,11 @@ void Prism::Rendering::Vulkan::ImGuiImplVulkan::init(GLFWwindow* glfwWindow, con
                                                        vk::UniqueInstance& instance,
                                                        const vk::PhysicalDevice physicalDevice,
                                                        const RawPtr<vk::UniqueDevice> logicalDevicePtr,
-                                                       const vk::RenderPass renderPass,
+                                                       const vk::Format colorAttachmentFormat,
                                                        const vk::Queue graphicsQueue)
 {
     this->vulkanRenderer = renderer;
+    this->colorAttachmentFormat = static_cast<VkFormat>(colorAttachmentFormat);
     this->logicalDevice = logicalDevicePtr;
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -64,7 +65,13 @@ void Prism::Rendering::Vulkan::ImGuiImplVulkan::init(GLFWwindow* glfwWindow, con
     initInfo.Instance = instance.get();
     initInfo.PhysicalDevice = physicalDevice;
     initInfo.Device = logicalDevicePtr.get()->get();
-    initInfo.RenderPass = renderPass;
+    // Renders into the rendering instance the render graph begins for the ImGui pass
+    initInfo.UseDynamicRendering = true;
+    initInfo.RenderPass = VK_NULL_HANDLE;
+    initInfo.PipelineRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+    initInfo.PipelineRenderingCreateInfo.pNext = nullptr;
+    initInfo.PipelineRenderingCreateInfo.colorAttachmentCount = 1;
+    initInfo.PipelineRenderingCreateInfo.pColorAttachmentFormats = &this->colorAttachmentFormat;
     initInfo.QueueFamily = vulkanRenderer->findQueueFamilies(physicalDevice).graphicsFamily.value();
     initInfo.Queue = graphicsQueue;
     initInfo.PipelineCache = nullptr;
@@ -107,10 +114,16 @@ void Prism::Rendering::Vulkan::ImGuiImplVulkan::newFrame()
     }
 }
 
-void Prism::Rendering::Vulkan::ImGuiImplVulkan::render(const vk::CommandBuffer& commandBuffer)
+void Prism::Rendering::Vulkan::ImGuiImplVulkan::endFrame(ImGuiDrawDataSnapshot& snapshot)
 {
     ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+    snapshot.capture(*ImGui::GetDrawData());
+}
+
+void Prism::Rendering::Vulkan::ImGuiImplVulkan::render(const vk::CommandBuffer& commandBuffer,
+                                                         const ImGuiDrawDataSnapshot& snapshot)
+{
+    ImGui_ImplVulkan_RenderDrawData(snapshot.getDrawData(), commandBuffer);
 }
 
 void Prism::Rendering::Vulkan::ImGuiImplVulkan::shutdown() const
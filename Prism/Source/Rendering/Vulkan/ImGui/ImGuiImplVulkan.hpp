@@ -2,6 +2,7 @@
 
 #include "vulkan/vulkan.hpp"
 #include "AbstractImmediateModeGui.hpp"
+#include "ImGuiDrawDataSnapshot.hpp"
 #include "../../../Utilities/Globals.hpp"
 
 struct GLFWwindow;
@@ -16,14 +17,18 @@ namespace Prism::Rendering::Vulkan
         explicit ImGuiImplVulkan() = default;
         void init(GLFWwindow* glfwWindow, RawPtr<VulkanRenderer> renderer, vk::UniqueInstance& instance,
                   vk::PhysicalDevice physicalDevice, RawPtr<vk::UniqueDevice> logicalDevicePtr,
-                  vk::RenderPass renderPass,
+                  vk::Format colorAttachmentFormat,
                   vk::Queue graphicsQueue);
+        // Main thread, builds the UI of all components. endFrame() captures it for rendering on another thread.
         void newFrame();
-        void render(const vk::CommandBuffer& commandBuffer);
+        void endFrame(ImGuiDrawDataSnapshot& snapshot);
+        void render(const vk::CommandBuffer& commandBuffer, const ImGuiDrawDataSnapshot& snapshot);
         void shutdown() const;
 
     private:
         vk::DescriptorPool descriptorPool;
+        // ImGui keeps a pointer to it for creating its pipeline
+        VkFormat colorAttachmentFormat = VK_FORMAT_UNDEFINED;
         RawPtr<vk::UniqueDevice> logicalDevice;
         RawPtr<VulkanRenderer> vulkanRenderer;
     };
@@ -0,0 +1,644 @@
+﻿#include "RenderGraph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "VulkanGpuTimer.hpp"
+
+namespace
+{
+    constexpr vk::AccessFlags2 writeAccessMask = vk::AccessFlagBits2::eColorAttachmentWrite |
+        vk::AccessFlagBits2::eDepthStencilAttachmentWrite | vk::AccessFlagBits2::eShaderWrite |
+        vk::AccessFlagBits2::eShaderStorageWrite | vk::AccessFlagBits2::eTransferWrite |
+        vk::AccessFlagBits2::eMemoryWrite;
+}
+
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder& Prism::Rendering::Vulkan::RenderGraph::PassBuilder::writeColor(
+    const RenderGraphResource image, const vk::AttachmentLoadOp loadOp, const vk::ClearColorValue& clearValue)
+{
+    auto& pass = graph.passes[passIndex];
+    if (pass.colorAttachments.size() >= maxColorAttachments)
+    {
+        throw std::runtime_error("Render graph pass " + std::string(pass.name) + " has too many color attachments");
+    }
+    const bool loads = loadOp == vk::AttachmentLoadOp::eLoad;
+    auto access = vk::AccessFlags2(vk::AccessFlagBits2::eColorAttachmentWrite);
+    if (loads)
+    {
+        access |= vk::AccessFlagBits2::eColorAttachmentRead;
+    }
+    pass.accesses.push_back({
+        image, vk::ImageLayout::eColorAttachmentOptimal, vk::PipelineStageFlagBits2::eColorAttachmentOutput, access,
+        loads, true
+    });
+    pass.colorAttachments.push_back({
+        image, vk::ImageLayout::eColorAttachmentOptimal, loadOp, vk::AttachmentStoreOp::eStore,
+        vk::ClearValue(clearValue)
+    });
+    graph.resources[image].usage |= vk::ImageUsageFlagBits::eColorAttachment;
+    return *this;
+}
+
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder& Prism::Rendering::Vulkan::RenderGraph::PassBuilder::writeDepth(
+    const RenderGraphResource image, const vk::AttachmentLoadOp loadOp, const vk::ClearDepthStencilValue& clearValue)
+{
+    auto& pass = graph.passes[passIndex];
+    // Depth tests read the attachment whatever the load op is
+    pass.accesses.push_back({
+        image, vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+        vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+        loadOp == vk::AttachmentLoadOp::eLoad, true
+    });
+    pass.depthAttachment = Attachment{
+        image, vk::ImageLayout::eDepthStencilAttachmentOptimal, loadOp, vk::AttachmentStoreOp::eStore,
+        vk::ClearValue(clearValue)
+    };
+    graph.resources[image].usage |= vk::ImageUsageFlagBits::eDepthStencilAttachment;
+    return *this;
+}
+
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder& Prism::Rendering::Vulkan::RenderGraph::PassBuilder::readDepth(
+    const RenderGraphResource image)
+{
+    auto& pass = graph.passes[passIndex];
+    pass.accesses.push_back({
+        image, vk::ImageLayout::eDepthStencilReadOnlyOptimal,
+        vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+        vk::AccessFlagBits2::eDepthStencilAttachmentRead, true, false
+    });
+    pass.depthAttachment = Attachment{
+        image, vk::ImageLayout::eDepthStencilReadOnlyOptimal, vk::AttachmentLoadOp::eLoad,
+        vk::AttachmentStoreOp::eNone, vk::ClearValue()
+    };
+    graph.resources[image].usage |= vk::ImageUsageFlagBits::eDepthStencilAttachment;
+    return *this;
+}
+
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder& Prism::Rendering::Vulkan::RenderGraph::PassBuilder::sampleImage(
+    const RenderGraphResource image, const vk::PipelineStageFlags2 stages)
+{
+    graph.passes[passIndex].accesses.push_back({
+        image, vk::ImageLayout::eShaderReadOnlyOptimal, stages, vk::AccessFlagBits2::eShaderSampledRead, true, false
+    });
+    graph.resources[image].usage |= vk::ImageUsageFlagBits::eSampled;
+    return *this;
+}
+
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder&
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder::setSideEffects()
+{
+    graph.passes[passIndex].sideEffects = true;
+    return *this;
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::init(const vk::Device newDevice, const vk::PhysicalDevice& physicalDevice)
+{
+    device = newDevice;
+    memoryProperties = physicalDevice.getMemoryProperties();
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::reset()
+{
+    for (const auto& resource : resources)
+    {
+        if (!resource.imported)
+        {
+            device.destroyImageView(resource.view);
+            device.destroyImage(resource.image);
+        }
+    }
+    for (const auto& memoryBlock : memoryBlocks)
+    {
+        device.freeMemory(memoryBlock.memory);
+    }
+    resources.clear();
+    passes.clear();
+    memoryBlocks.clear();
+    finalBarriers.clear();
+    culledPassCount = 0;
+    barrierCount = 0;
+    transientMemorySize = 0;
+    aliasedMemorySize = 0;
+}
+
+Prism::Rendering::Vulkan::RenderGraphResource Prism::Rendering::Vulkan::RenderGraph::importImage(
+    const RenderGraphImageInfo& info, const vk::ImageLayout initialLayout, const vk::PipelineStageFlags2 initialStages,
+    const vk::ImageLayout finalLayout)
+{
+    Resource resource;
+    resource.info = info;
+    resource.imported = true;
+    resource.initialLayout = initialLayout;
+    resource.initialStages = initialStages;
+    resource.finalLayout = finalLayout;
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::setImportedImage(const RenderGraphResource resource, const vk::Image image,
+                                                             const vk::ImageView view)
+{
+    resources[resource].image = image;
+    resources[resource].view = view;
+}
+
+Prism::Rendering::Vulkan::RenderGraphResource Prism::Rendering::Vulkan::RenderGraph::createImage(
+    const RenderGraphImageInfo& info)
+{
+    Resource resource;
+    resource.info = info;
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+
+Prism::Rendering::Vulkan::RenderGraph::PassBuilder Prism::Rendering::Vulkan::RenderGraph::addPass(
+    const char* name, ExecuteCallback execute)
+{
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    passes.push_back(std::move(pass));
+    return {*this, static_cast<uint32_t>(passes.size() - 1)};
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::compile()
+{
+    cullPasses();
+    allocateTransientImages();
+    computeBarriers();
+
+    size_t maxBarriers = finalBarriers.size();
+    for (const auto& pass : passes)
+    {
+        maxBarriers = std::max(maxBarriers, pass.barriers.size());
+    }
+    barrierScratch.reserve(maxBarriers);
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::execute(const vk::CommandBuffer& commandBuffer, VulkanGpuTimer& gpuTimer)
+{
+    for (const auto& pass : passes)
+    {
+        if (pass.culled)
+        {
+            continue;
+        }
+        recordBarriers(commandBuffer, pass.barriers);
+        const bool rendering = !pass.colorAttachments.empty() || pass.depthAttachment;
+        if (rendering && !pass.continuesRendering)
+        {
+            beginRendering(commandBuffer, pass);
+        }
+        gpuTimer.beginPass(commandBuffer, pass.name);
+        pass.execute(commandBuffer);
+        gpuTimer.endPass(commandBuffer);
+        if (rendering && !pass.keepsRendering)
+        {
+            commandBuffer.endRendering();
+        }
+    }
+    recordBarriers(commandBuffer, finalBarriers);
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::cullPasses()
+{
+    // Walks backwards from the outputs, an image is needed while a later surviving pass uses its current contents
+    std::vector<bool> needed(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        needed[i] = resources[i].imported && resources[i].finalLayout != vk::ImageLayout::eUndefined;
+    }
+    culledPassCount = 0;
+    for (auto pass = passes.rbegin(); pass != passes.rend(); ++pass)
+    {
+        pass->culled = !pass->sideEffects && std::ranges::none_of(pass->accesses, [&needed](const Access& access)
+        {
+            return access.writes && needed[access.resource];
+        });
+        if (pass->culled)
+        {
+            ++culledPassCount;
+            continue;
+        }
+
+        // Nobody looks at attachments after this pass, e.g. depth, so they don't have to be written back to memory
+        for (auto& attachment : pass->colorAttachments)
+        {
+            attachment.storeOp = needed[attachment.resource]
+                                     ? vk::AttachmentStoreOp::eStore
+                                     : vk::AttachmentStoreOp::eDontCare;
+        }
+        if (pass->depthAttachment && pass->depthAttachment->storeOp != vk::AttachmentStoreOp::eNone)
+        {
+            pass->depthAttachment->storeOp = needed[pass->depthAttachment->resource]
+                                                 ? vk::AttachmentStoreOp::eStore
+                                                 : vk::AttachmentStoreOp::eDontCare;
+        }
+
+        for (const auto& access : pass->accesses)
+        {
+            if (access.writes && !access.reads)
+            {
+                needed[access.resource] = false;
+            }
+        }
+        for (const auto& access : pass->accesses)
+        {
+            if (access.reads)
+            {
+                needed[access.resource] = true;
+            }
+        }
+    }
+
+    for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+    {
+        if (passes[passIndex].culled)
+        {
+            continue;
+        }
+        for (const auto& access : passes[passIndex].accesses)
+        {
+            auto& resource = resources[access.resource];
+            if (resource.firstPass == noPass)
+            {
+                resource.firstPass = passIndex;
+            }
+            resource.lastPass = passIndex;
+        }
+    }
+}
+
+bool Prism::Rendering::Vulkan::RenderGraph::canContinueRendering(const Pass& previous, const Pass& pass) const
+{
+    // Same attachments, nothing cleared and nothing else touched, otherwise a barrier or new load op is needed
+    if (pass.colorAttachments.empty() && !pass.depthAttachment)
+    {
+        return false;
+    }
+    const size_t attachmentCount = pass.colorAttachments.size() + (pass.depthAttachment ? 1 : 0);
+    if (pass.accesses.size() != attachmentCount || pass.colorAttachments.size() != previous.colorAttachments.size() ||
+        pass.depthAttachment.has_value() != previous.depthAttachment.has_value())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < pass.colorAttachments.size(); ++i)
+    {
+        if (pass.colorAttachments[i].resource != previous.colorAttachments[i].resource ||
+            pass.colorAttachments[i].loadOp != vk::AttachmentLoadOp::eLoad)
+        {
+            return false;
+        }
+    }
+    if (pass.depthAttachment)
+    {
+        return pass.depthAttachment->resource == previous.depthAttachment->resource &&
+            pass.depthAttachment->layout == previous.depthAttachment->layout &&
+            pass.depthAttachment->loadOp == vk::AttachmentLoadOp::eLoad;
+    }
+    return true;
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::computeBarriers()
+{
+    /*
+     * Transient images start undefined, but the memory may still be in use by the images aliasing it, in this frame
+     * or the previous one still executing. Their first barrier waits for every use of their memory block.
+     */
+    std::vector<ImageState> blockStates(memoryBlocks.size());
+    for (const auto& pass : passes)
+    {
+        if (pass.culled)
+        {
+            continue;
+        }
+        for (const auto& access : pass.accesses)
+        {
+            const auto& resource = resources[access.resource];
+            if (resource.imported)
+            {
+                continue;
+            }
+            auto& blockState = blockStates[resource.memoryBlock];
+            blockState.writeStages |= access.stages;
+            blockState.writeAccess |= access.access & writeAccessMask;
+        }
+    }
+
+    std::vector<ImageState> states(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        const auto& resource = resources[i];
+        if (resource.imported)
+        {
+            states[i] = {resource.initialLayout, resource.initialStages, {}, {}};
+        }
+        else if (resource.memoryBlock != UINT32_MAX)
+        {
+            states[i] = blockStates[resource.memoryBlock];
+            states[i].layout = vk::ImageLayout::eUndefined;
+        }
+    }
+
+    barrierCount = 0;
+    // First pass of the rendering instance the previous surviving pass recorded into
+    uint32_t renderingPass = noPass;
+    uint32_t previousPass = noPass;
+    for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+    {
+        auto& pass = passes[passIndex];
+        pass.barriers.clear();
+        if (pass.culled)
+        {
+            continue;
+        }
+
+        if (renderingPass != noPass && canContinueRendering(passes[renderingPass], pass))
+        {
+            // Draws within one rendering instance are ordered by the rasterization order, no barrier needed
+            pass.continuesRendering = true;
+            passes[previousPass].keepsRendering = true;
+            previousPass = passIndex;
+            auto& firstPass = passes[renderingPass];
+            for (size_t i = 0; i < pass.colorAttachments.size(); ++i)
+            {
+                firstPass.colorAttachments[i].storeOp = pass.colorAttachments[i].storeOp;
+            }
+            if (pass.depthAttachment)
+            {
+                firstPass.depthAttachment->storeOp = pass.depthAttachment->storeOp;
+            }
+            for (const auto& access : pass.accesses)
+            {
+                auto& state = states[access.resource];
+                state.writeStages |= access.stages;
+                state.writeAccess |= access.access & writeAccessMask;
+            }
+            continue;
+        }
+        const bool rendering = !pass.colorAttachments.empty() || pass.depthAttachment;
+        renderingPass = rendering ? passIndex : noPass;
+        previousPass = passIndex;
+
+        for (const auto& access : pass.accesses)
+        {
+            auto& state = states[access.resource];
+            const bool layoutChange = state.layout != access.layout;
+            if (access.writes)
+            {
+                // Waits for earlier writes and, as the write would race them otherwise, for earlier reads
+                pass.barriers.push_back({
+                    access.resource, state.layout, access.layout, state.writeStages | state.readStages,
+                    state.writeAccess, access.stages, access.access
+                });
+                state = {access.layout, access.stages, access.access & writeAccessMask, {}};
+                continue;
+            }
+            // Reads after reads in the same layout don't need a barrier
+            if (!layoutChange && !(access.stages & ~state.readStages))
+            {
+                continue;
+            }
+            pass.barriers.push_back({
+                access.resource, state.layout, access.layout,
+                layoutChange ? state.writeStages | state.readStages : state.writeStages, state.writeAccess,
+                access.stages, access.access
+            });
+            if (layoutChange)
+            {
+                // Later readers only have to wait for the transition, which happens before these stages
+                state = {access.layout, access.stages, {}, access.stages};
+            }
+            else
+            {
+                state.readStages |= access.stages;
+            }
+        }
+        barrierCount += static_cast<uint32_t>(pass.barriers.size());
+    }
+
+    finalBarriers.clear();
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        const auto& resource = resources[i];
+        const auto& state = states[i];
+        if (!resource.imported || resource.finalLayout == vk::ImageLayout::eUndefined ||
+            resource.finalLayout == state.layout)
+        {
+            continue;
+        }
+        // Whoever consumes the image, e.g. the presentation engine, waits on a semaphore signaled after all commands
+        finalBarriers.push_back({
+            static_cast<RenderGraphResource>(i), state.layout, resource.finalLayout,
+            state.writeStages | state.readStages, state.writeAccess, vk::PipelineStageFlagBits2::eNone,
+            vk::AccessFlagBits2::eNone
+        });
+    }
+    barrierCount += static_cast<uint32_t>(finalBarriers.size());
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::allocateTransientImages()
+{
+    std::vector<std::pair<RenderGraphResource, vk::MemoryRequirements>> transientImages;
+    for (uint32_t i = 0; i < resources.size(); ++i)
+    {
+        auto& resource = resources[i];
+        if (resource.imported || resource.firstPass == noPass)
+        {
+            continue;
+        }
+
+        vk::ImageCreateInfo imageInfo = {};
+        imageInfo.imageType = vk::ImageType::e2D;
+        imageInfo.extent = vk::Extent3D{resource.info.extent.width, resource.info.extent.height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = resource.info.format;
+        imageInfo.tiling = vk::ImageTiling::eOptimal;
+        imageInfo.initialLayout = vk::ImageLayout::eUndefined;
+        imageInfo.usage = resource.usage;
+        imageInfo.sharingMode = vk::SharingMode::eExclusive;
+        imageInfo.samples = vk::SampleCountFlagBits::e1;
+        try
+        {
+            resource.image = device.createImage(imageInfo);
+        }
+        catch (vk::SystemError& e)
+        {
+            throw std::runtime_error("Failed to create render graph image: " + std::string(e.what()));
+        }
+        transientImages.emplace_back(i, device.getImageMemoryRequirements(resource.image));
+    }
+
+    // Largest first, smaller images then fit into the blocks of larger ones they don't overlap with
+    std::ranges::sort(transientImages, [](const auto& a, const auto& b)
+    {
+        return a.second.size > b.second.size;
+    });
+    vk::DeviceSize imageMemorySize = 0;
+    for (const auto& [resourceIndex, requirements] : transientImages)
+    {
+        auto& resource = resources[resourceIndex];
+        imageMemorySize += requirements.size;
+        const auto block = std::ranges::find_if(memoryBlocks, [&](const MemoryBlock& memoryBlock)
+        {
+            // Every image is bound at offset 0, so only the memory type has to be compatible
+            if ((memoryBlock.memoryTypeBits & requirements.memoryTypeBits) == 0)
+            {
+                return false;
+            }
+            return std::ranges::none_of(memoryBlock.images, [&](const RenderGraphResource other)
+            {
+                return resource.firstPass <= resources[other].lastPass &&
+                    resources[other].firstPass <= resource.lastPass;
+            });
+        });
+        if (block == memoryBlocks.end())
+        {
+            resource.memoryBlock = static_cast<uint32_t>(memoryBlocks.size());
+            memoryBlocks.push_back({nullptr, requirements.size, requirements.memoryTypeBits, {resourceIndex}});
+            continue;
+        }
+        resource.memoryBlock = static_cast<uint32_t>(block - memoryBlocks.begin());
+        block->size = std::max(block->size, requirements.size);
+        block->memoryTypeBits &= requirements.memoryTypeBits;
+        block->images.push_back(resourceIndex);
+    }
+
+    transientMemorySize = 0;
+    for (auto& memoryBlock : memoryBlocks)
+    {
+        vk::MemoryAllocateInfo allocInfo = {};
+        allocInfo.allocationSize = memoryBlock.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memoryBlock.memoryTypeBits);
+        try
+        {
+            memoryBlock.memory = device.allocateMemory(allocInfo);
+        }
+        catch (vk::SystemError& e)
+        {
+            throw std::runtime_error("Failed to allocate render graph memory: " + std::string(e.what()));
+        }
+        transientMemorySize += memoryBlock.size;
+
+        for (const auto resourceIndex : memoryBlock.images)
+        {
+            auto& resource = resources[resourceIndex];
+            device.bindImageMemory(resource.image, memoryBlock.memory, 0);
+
+            vk::ImageViewCreateInfo viewInfo = {};
+            viewInfo.image = resource.image;
+            viewInfo.viewType = vk::ImageViewType::e2D;
+            viewInfo.format = resource.info.format;
+            viewInfo.subresourceRange.aspectMask = resource.info.aspect;
+            viewInfo.subresourceRange.baseMipLevel = 0;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount = 1;
+            try
+            {
+                resource.view = device.createImageView(viewInfo);
+            }
+            catch (vk::SystemError& e)
+            {
+                throw std::runtime_error("Failed to create render graph image view: " + std::string(e.what()));
+            }
+        }
+    }
+    aliasedMemorySize = imageMemorySize - transientMemorySize;
+}
+
+uint32_t Prism::Rendering::Vulkan::RenderGraph::findMemoryType(const uint32_t typeFilter) const
+{
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        if ((typeFilter & (1 << i)) &&
+            (memoryProperties.memoryTypes[i].propertyFlags & vk::MemoryPropertyFlagBits::eDeviceLocal))
+        {
+            return i;
+        }
+    }
+    throw std::runtime_error("Failed to find device local memory for the render graph!");
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::recordBarriers(const vk::CommandBuffer& commandBuffer,
+                                                           const std::vector<Barrier>& barriers)
+{
+    if (barriers.empty())
+    {
+        return;
+    }
+    barrierScratch.clear();
+    for (const auto& barrier : barriers)
+    {
+        const auto& resource = resources[barrier.resource];
+        vk::ImageMemoryBarrier2 imageBarrier = {};
+        imageBarrier.srcStageMask = barrier.srcStages;
+        imageBarrier.srcAccessMask = barrier.srcAccess;
+        imageBarrier.dstStageMask = barrier.dstStages;
+        imageBarrier.dstAccessMask = barrier.dstAccess;
+        imageBarrier.oldLayout = barrier.oldLayout;
+        imageBarrier.newLayout = barrier.newLayout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = resource.image;
+        imageBarrier.subresourceRange.aspectMask = resource.info.aspect;
+        imageBarrier.subresourceRange.baseMipLevel = 0;
+        imageBarrier.subresourceRange.levelCount = 1;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount = 1;
+        barrierScratch.push_back(imageBarrier);
+    }
+
+    vk::DependencyInfo dependencyInfo = {};
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barrierScratch.size());
+    dependencyInfo.pImageMemoryBarriers = barrierScratch.data();
+    commandBuffer.pipelineBarrier2(dependencyInfo);
+}
+
+void Prism::Rendering::Vulkan::RenderGraph::beginRendering(const vk::CommandBuffer& commandBuffer,
+                                                           const Pass& pass) const
+{
+    const auto toAttachmentInfo = [this](const Attachment& attachment)
+    {
+        vk::RenderingAttachmentInfo attachmentInfo = {};
+        attachmentInfo.imageView = resources[attachment.resource].view;
+        attachmentInfo.imageLayout = attachment.layout;
+        attachmentInfo.loadOp = attachment.loadOp;
+        attachmentInfo.storeOp = attachment.storeOp;
+        attachmentInfo.clearValue = attachment.clearValue;
+        return attachmentInfo;
+    };
+
+    std::array<vk::RenderingAttachmentInfo, maxColorAttachments> colorAttachmentInfos;
+    for (size_t i = 0; i < pass.colorAttachments.size(); ++i)
+    {
+        colorAttachmentInfos[i] = toAttachmentInfo(pass.colorAttachments[i]);
+    }
+    vk::RenderingAttachmentInfo depthAttachmentInfo = {};
+    if (pass.depthAttachment)
+    {
+        depthAttachmentInfo = toAttachmentInfo(*pass.depthAttachment);
+    }
+
+    const auto& firstAttachment = pass.colorAttachments.empty()
+                                      ? *pass.depthAttachment
+                                      : pass.colorAttachments.front();
+    vk::RenderingInfo renderingInfo = {};
+    renderingInfo.renderArea.offset = vk::Offset2D{0, 0};
+    renderingInfo.renderArea.extent = resources[firstAttachment.resource].info.extent;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = static_cast<uint32_t>(pass.colorAttachments.size());
+    renderingInfo.pColorAttachments = colorAttachmentInfos.data();
+    if (pass.depthAttachment)
+    {
+        renderingInfo.pDepthAttachment = &depthAttachmentInfo;
+        if (resources[pass.depthAttachment->resource].info.aspect & vk::ImageAspectFlagBits::eStencil)
+        {
+            renderingInfo.pStencilAttachment = &depthAttachmentInfo;
+        }
+    }
+    commandBuffer.beginRendering(renderingInfo);
+}
@@ -0,0 +1,219 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "vulkan/vulkan.hpp"
+
+namespace Prism::Rendering::Vulkan
+{
+    class VulkanGpuTimer;
+
+    // Index of an image declared in a RenderGraph
+    using RenderGraphResource = uint32_t;
+
+    struct RenderGraphImageInfo
+    {
+        vk::Format format = vk::Format::eUndefined;
+        vk::Extent2D extent;
+        vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor;
+    };
+
+    /*
+     * Frame level description of the rendering. Passes declare the images they read and write, compile() derives the
+     * synchronization2 barriers between them, culls passes whose results nobody consumes, merges consecutive passes
+     * into one dynamic rendering instance where the attachments allow it, and lets transient images with disjoint
+     * lifetimes share memory. Passes execute in the order they were added.
+     * The graph is declared and compiled once and executed every frame, only imported images change per frame. It is
+     * declared again after reset(), e.g. when the swapchain was recreated.
+     */
+    class RenderGraph
+    {
+    public:
+        using ExecuteCallback = std::function<void(const vk::CommandBuffer& commandBuffer)>;
+
+        class PassBuilder
+        {
+        public:
+            // The clear value is only used with eClear, eLoad keeps what earlier passes rendered
+            PassBuilder& writeColor(RenderGraphResource image, vk::AttachmentLoadOp loadOp,
+                                    const vk::ClearColorValue& clearValue = {});
+            PassBuilder& writeDepth(RenderGraphResource image, vk::AttachmentLoadOp loadOp,
+                                    const vk::ClearDepthStencilValue& clearValue = {});
+            // Depth tested against without writing it
+            PassBuilder& readDepth(RenderGraphResource image);
+            PassBuilder& sampleImage(RenderGraphResource image,
+                                     vk::PipelineStageFlags2 stages = vk::PipelineStageFlagBits2::eFragmentShader);
+            // The pass has effects beyond its images, e.g. a readback, and is never culled
+            PassBuilder& setSideEffects();
+
+        private:
+            friend class RenderGraph;
+
+            PassBuilder(RenderGraph& graph, const uint32_t passIndex) : graph(graph), passIndex(passIndex)
+            {
+            }
+
+            RenderGraph& graph;
+            uint32_t passIndex;
+        };
+
+        inline constexpr static uint32_t maxColorAttachments = 8;
+
+        void init(vk::Device newDevice, const vk::PhysicalDevice& physicalDevice);
+        // Drops all passes and images and frees the transient memory, the device must be idle
+        void reset();
+
+        /*
+         * Image owned outside the graph, e.g. the swapchain image. It is expected in initialLayout with its last
+         * writes made available by initialStages, e.g. the stage the acquire semaphore waits at, and left in
+         * finalLayout. Imported images with a final layout are the outputs that keep passes alive.
+         */
+        RenderGraphResource importImage(const RenderGraphImageInfo& info, vk::ImageLayout initialLayout,
+                                        vk::PipelineStageFlags2 initialStages, vk::ImageLayout finalLayout);
+        // Retargets an imported image, e.g. to the swapchain image acquired for this frame
+        void setImportedImage(RenderGraphResource resource, vk::Image image, vk::ImageView view);
+        // Image created by compile() and only valid within a frame, its contents don't survive into the next one
+        RenderGraphResource createImage(const RenderGraphImageInfo& info);
+        // The name must outlive the graph, it ends up in the GPU timings
+        PassBuilder addPass(const char* name, ExecuteCallback execute);
+
+        void compile();
+        // Records all passes that survived culling, doesn't allocate
+        void execute(const vk::CommandBuffer& commandBuffer, VulkanGpuTimer& gpuTimer);
+
+        [[nodiscard]] uint32_t getPassCount() const
+        {
+            return static_cast<uint32_t>(passes.size());
+        }
+
+        [[nodiscard]] uint32_t getCulledPassCount() const
+        {
+            return culledPassCount;
+        }
+
+        [[nodiscard]] uint32_t getBarrierCount() const
+        {
+            return barrierCount;
+        }
+
+        // Memory of all transient images and the part of it saved by aliasing
+        [[nodiscard]] vk::DeviceSize getTransientMemorySize() const
+        {
+            return transientMemorySize;
+        }
+
+        [[nodiscard]] vk::DeviceSize getAliasedMemorySize() const
+        {
+            return aliasedMemorySize;
+        }
+
+    private:
+        inline constexpr static uint32_t noPass = UINT32_MAX;
+
+        struct ImageState
+        {
+            vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+            // Last write, or the last layout transition, which later accesses synchronize with
+            vk::PipelineStageFlags2 writeStages;
+            vk::AccessFlags2 writeAccess;
+            // Stages that read since then and already waited for it
+            vk::PipelineStageFlags2 readStages;
+        };
+
+        struct Resource
+        {
+            RenderGraphImageInfo info;
+            bool imported = false;
+            vk::ImageLayout initialLayout = vk::ImageLayout::eUndefined;
+            vk::PipelineStageFlags2 initialStages;
+            vk::ImageLayout finalLayout = vk::ImageLayout::eUndefined;
+            vk::ImageUsageFlags usage;
+            vk::Image image;
+            vk::ImageView view;
+            // Lifetime of transient images in pass indices, noPass if no surviving pass uses it
+            uint32_t firstPass = noPass;
+            uint32_t lastPass = noPass;
+            uint32_t memoryBlock = UINT32_MAX;
+        };
+
+        struct Access
+        {
+            RenderGraphResource resource;
+            vk::ImageLayout layout;
+            vk::PipelineStageFlags2 stages;
+            vk::AccessFlags2 access;
+            // Whether earlier contents are used, a write without it makes all earlier writes irrelevant
+            bool reads;
+            bool writes;
+        };
+
+        struct Attachment
+        {
+            RenderGraphResource resource;
+            vk::ImageLayout layout;
+            vk::AttachmentLoadOp loadOp;
+            vk::AttachmentStoreOp storeOp;
+            vk::ClearValue clearValue;
+        };
+
+        struct Barrier
+        {
+            RenderGraphResource resource;
+            vk::ImageLayout oldLayout;
+            vk::ImageLayout newLayout;
+            vk::PipelineStageFlags2 srcStages;
+            vk::AccessFlags2 srcAccess;
+            vk::PipelineStageFlags2 dstStages;
+            vk::AccessFlags2 dstAccess;
+        };
+
+        struct Pass
+        {
+            const char* name = nullptr;
+            ExecuteCallback execute;
+            std::vector<Access> accesses;
+            std::vector<Attachment> colorAttachments;
+            std::optional<Attachment> depthAttachment;
+            bool sideEffects = false;
+            bool culled = false;
+            // Runs inside the rendering instance of the previous pass
+            bool continuesRendering = false;
+            // The next pass runs inside this one's rendering instance
+            bool keepsRendering = false;
+            std::vector<Barrier> barriers;
+        };
+
+        struct MemoryBlock
+        {
+            vk::DeviceMemory memory;
+            vk::DeviceSize size = 0;
+            uint32_t memoryTypeBits = 0;
+            std::vector<RenderGraphResource> images;
+        };
+
+        vk::Device device;
+        vk::PhysicalDeviceMemoryProperties memoryProperties;
+        std::vector<Resource> resources;
+        std::vector<Pass> passes;
+        std::vector<MemoryBlock> memoryBlocks;
+        // Transitions of the imported images into their final layouts after the last pass
+        std::vector<Barrier> finalBarriers;
+        uint32_t culledPassCount = 0;
+        uint32_t barrierCount = 0;
+        vk::DeviceSize transientMemorySize = 0;
+        vk::DeviceSize aliasedMemorySize = 0;
+        // Reused every frame to avoid allocating
+        std::vector<vk::ImageMemoryBarrier2> barrierScratch;
+
+        void cullPasses();
+        [[nodiscard]] bool canContinueRendering(const Pass& previous, const Pass& pass) const;
+        void computeBarriers();
+        void allocateTransientImages();
+        [[nodiscard]] uint32_t findMemoryType(uint32_t typeFilter) const;
+        void recordBarriers(const vk::CommandBuffer& commandBuffer, const std::vector<Barrier>& barriers);
+        void beginRendering(const vk::CommandBuffer& commandBuffer, const Pass& pass) const;
+    };
+}
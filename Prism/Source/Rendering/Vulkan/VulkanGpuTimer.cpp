@@ -0,0 +1,118 @@
+﻿#include "VulkanGpuTimer.hpp"
+#include "../../Utilities/Logging/Log.hpp"
+
+void Prism::Rendering::Vulkan::VulkanGpuTimer::init(const vk::Device device, const vk::PhysicalDevice& physicalDevice,
+                                                    const uint32_t queueFamilyIndex, const uint32_t framesInFlight)
+{
+    this->device = device;
+    const auto properties = physicalDevice.getProperties();
+    const auto queueFamilies = physicalDevice.getQueueFamilyProperties();
+    const uint32_t validBits = queueFamilyIndex < queueFamilies.size()
+                                   ? queueFamilies[queueFamilyIndex].timestampValidBits
+                                   : 0;
+    if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f)
+    {
+        LOG_WARN("Timestamp queries are not supported on the graphics queue, GPU timings are unavailable");
+        supported = false;
+        return;
+    }
+    supported = true;
+    timestampPeriodNanoseconds = properties.limits.timestampPeriod;
+    timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+    vk::QueryPoolCreateInfo queryPoolInfo = {};
+    queryPoolInfo.queryType = vk::QueryType::eTimestamp;
+    queryPoolInfo.queryCount = maxPasses * 2;
+
+    frames.resize(framesInFlight);
+    for (auto& frame : frames)
+    {
+        try
+        {
+            frame.queryPool = device.createQueryPool(queryPoolInfo);
+        }
+        catch (vk::SystemError& e)
+        {
+            throw std::runtime_error("Failed to create timestamp query pool: " + std::string(e.what()));
+        }
+    }
+    queryResults.resize(maxPasses * 2);
+}
+
+void Prism::Rendering::Vulkan::VulkanGpuTimer::shutdown()
+{
+    for (const auto& frame : frames)
+    {
+        device.destroyQueryPool(frame.queryPool);
+    }
+    frames.clear();
+    passTimings.clear();
+}
+
+void Prism::Rendering::Vulkan::VulkanGpuTimer::beginFrame(const vk::CommandBuffer& commandBuffer,
+                                                          const uint32_t frameIndex)
+{
+    if (!supported)
+    {
+        return;
+    }
+    currentFrameIndex = frameIndex;
+    auto& frame = frames[frameIndex];
+    readResults(frame);
+    frame.passNames.clear();
+    commandBuffer.resetQueryPool(frame.queryPool, 0, maxPasses * 2);
+}
+
+void Prism::Rendering::Vulkan::VulkanGpuTimer::beginPass(const vk::CommandBuffer& commandBuffer, const char* name)
+{
+    auto& frame = frames[currentFrameIndex];
+    if (!supported || passOpen || frame.passNames.size() >= maxPasses)
+    {
+        return;
+    }
+    const auto queryIndex = static_cast<uint32_t>(frame.passNames.size()) * 2;
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.queryPool, queryIndex);
+    frame.passNames.emplace_back(name);
+    passOpen = true;
+}
+
+void Prism::Rendering::Vulkan::VulkanGpuTimer::endPass(const vk::CommandBuffer& commandBuffer)
+{
+    if (!supported || !passOpen)
+    {
+        return;
+    }
+    auto& frame = frames[currentFrameIndex];
+    const auto queryIndex = static_cast<uint32_t>(frame.passNames.size()) * 2 - 1;
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, frame.queryPool, queryIndex);
+    passOpen = false;
+}
+
+void Prism::Rendering::Vulkan::VulkanGpuTimer::readResults(FrameQueries& frame)
+{
+    if (frame.passNames.empty())
+    {
+        return;
+    }
+    const auto queryCount = static_cast<uint32_t>(frame.passNames.size()) * 2;
+    // No wait flag, the fence of this frame already signaled. eNotReady only happens if a pass was never submitted.
+    const auto result = device.getQueryPoolResults(frame.queryPool, 0, queryCount, queryCount * sizeof(uint64_t),
+                                                   queryResults.data(), sizeof(uint64_t),
+                                                   vk::QueryResultFlagBits::e64);
+    if (result != vk::Result::eSuccess)
+    {
+        return;
+    }
+
+    passTimings.clear();
+    for (size_t i = 0; i < frame.passNames.size(); ++i)
+    {
+        const uint64_t begin = queryResults[i * 2] & timestampMask;
+        const uint64_t end = queryResults[i * 2 + 1] & timestampMask;
+        const uint64_t ticks = (end - begin) & timestampMask;
+        passTimings.emplace_back(GpuPassTiming{
+            frame.passNames[i],
+            static_cast<float>(static_cast<double>(ticks) * timestampPeriodNanoseconds / 1000000.0)
+        });
+    }
+}
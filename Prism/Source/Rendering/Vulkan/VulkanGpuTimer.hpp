@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <span>
+#include <vector>
+
+#include "vulkan/vulkan.hpp"
+#include "../GpuPassTiming.hpp"
+
+namespace Prism::Rendering::Vulkan
+{
+    /*
+     * Timestamp queries around render passes, one query pool per frame in flight. Results of a frame are read back
+     * when its command buffer is recorded again, at which point its fence has signaled, so reading never stalls.
+     */
+    class VulkanGpuTimer
+    {
+    public:
+        inline constexpr static uint32_t maxPasses = 16;
+
+        void init(vk::Device device, const vk::PhysicalDevice& physicalDevice, uint32_t queueFamilyIndex,
+                  uint32_t framesInFlight);
+        void shutdown();
+
+        // Must be called outside a render pass, right after the command buffer began recording
+        void beginFrame(const vk::CommandBuffer& commandBuffer, uint32_t frameIndex);
+        void beginPass(const vk::CommandBuffer& commandBuffer, const char* name);
+        void endPass(const vk::CommandBuffer& commandBuffer);
+
+        [[nodiscard]] bool isSupported() const
+        {
+            return supported;
+        }
+
+        // Timings of the most recently completed frame
+        [[nodiscard]] std::span<const GpuPassTiming> getPassTimings() const
+        {
+            return passTimings;
+        }
+
+    private:
+        struct FrameQueries
+        {
+            vk::QueryPool queryPool;
+            std::vector<const char*> passNames;
+        };
+
+        vk::Device device;
+        bool supported = false;
+        float timestampPeriodNanoseconds = 1.0f;
+        uint64_t timestampMask = ~0ull;
+        std::vector<FrameQueries> frames;
+        uint32_t currentFrameIndex = 0;
+        bool passOpen = false;
+        std::vector<GpuPassTiming> passTimings;
+        std::vector<uint64_t> queryResults;
+
+        void readResults(FrameQueries& frame);
+    };
+}
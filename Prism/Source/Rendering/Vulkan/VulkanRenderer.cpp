@@ -1,11 +1,14 @@
-﻿#include <map>
+﻿#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <map>
 #include <set>
 #include <chrono>
 #include "../../Utilities/ServiceLocator.hpp"
 #include "../../Assets/AssetManager.hpp"
 #include "../../Assets/ShaderAsset.hpp"
 #include "../../Assets/TextureAsset.hpp"
-#include "../../Core/StaticMeshComponent.hpp"
+#include "../../Utilities/ConsoleVariables.hpp"
 #include "../../Utilities/Logging/Log.hpp"
 #include "../Vertex.hpp"
 #include "../UniformBufferObject.hpp"
@@ -14,6 +17,8 @@
 #include <glm/gtx/matrix_decompose.hpp>
 #include "../PushConstantObject.hpp"
 #include "VulkanBuffer.hpp"
+#include "../../Utilities/Profiling/Profiler.hpp"
+#include "../../Utilities/Profiling/AllocationTracker.hpp"
 
 // Include these two last to avoid windows macro redefinitions!
 // VulkanRenderer.hpp BEFORE glfw3.h!!!
@@ -24,6 +29,21 @@ VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
 #include <GLFW/glfw3.h>
 
+namespace
+{
+    Prism::Utility::ConsoleVariable<uint32_t> cvarPresentMode(
+        "renderer.presentMode", 1, 0, 2,
+        "0 FIFO (vsync), 1 mailbox, 2 immediate (uncapped, may tear). Unsupported modes fall back to FIFO.");
+
+    Prism::Utility::ConsoleVariable<uint32_t> cvarFramesInFlight(
+        "renderer.framesInFlight", 2, 1, Prism::Rendering::Vulkan::VulkanRenderer::maxFramesInFlight,
+        "Frames the CPU may record ahead of the GPU, more smooth out spikes at the cost of input latency. "
+        "Applied when the swapchain is recreated next, which a change triggers right away.");
+
+    Prism::Utility::ConsoleVariable<bool> cvarLowLatency(
+        "renderer.lowLatency", false,
+        "Wait for the GPU to finish the last frame before sampling input, trades throughput for input latency");
+}
 
 namespace Prism::Rendering::Vulkan
 {
@@ -58,13 +78,19 @@ namespace Prism::Rendering::Vulkan
     VulkanRenderer::VulkanRenderer(GLFWwindow* newGlfwWindow)
     {
         this->glfwWindow = newGlfwWindow;
-        this->cameraManager = Utility::ServiceLocator::getService<ICameraManager>();
-        this->sceneManager = Utility::ServiceLocator::getService<Core::ISceneManager>();
         this->graphicsDebugBridge = Utility::ServiceLocator::getService<GraphicsDebugBridge>();
     }
 
     void VulkanRenderer::init()
     {
+        extractor.init();
+        // Updated by onFrameBufferResized from now on
+        int width = 0;
+        int height = 0;
+        glfwGetFramebufferSize(glfwWindow, &width, &height);
+        framebufferWidth = width;
+        framebufferHeight = height;
+
         createInstance();
         setupDebugCallback();
         createSurface();
@@ -72,27 +98,73 @@ namespace Prism::Rendering::Vulkan
         createLogicalDevice();
         createSwapChain();
         createImageViews();
-        createRenderPass();
+        depthFormat = findDepthFormat();
+        renderGraph.init(*logicalDevice, physicalDevice);
+        createRenderGraph();
         createDescriptorSetLayout();
         createGraphicsPipeline();
+        createDebugLinePipelines();
         createCommandPools();
-        createDepthResources();
-        createFramebuffers();
         createTextureImage();
         createTextureImageView();
         createTextureSampler();
         createUniformBuffers();
+        createDebugLineBuffers();
         createDescriptorPool();
         createDescriptorSets();
 
-        imGuiImpl.init(glfwWindow, this, instance, physicalDevice, &logicalDevice, renderPass, graphicsQueue);
+        imGuiImpl.init(glfwWindow, this, instance, physicalDevice, &logicalDevice, swapChainImageFormat,
+                       graphicsQueue);
 
         createCommandBuffers();
         createSyncObjects();
+        framesInFlightSetting = cvarFramesInFlight.get();
+
+        gpuTimer.init(*logicalDevice, physicalDevice, findQueueFamilies(physicalDevice).graphicsFamily.value(),
+                      maxFramesInFlight);
     }
 
-    void VulkanRenderer::render()
+    void VulkanRenderer::extract(RenderFramePacket& packet)
     {
+        PRISM_PROFILE_SCOPE("VulkanRenderer::extract");
+        // The swapchain follows the framebuffer, while minimized nothing is rendered anyway
+        const auto width = framebufferWidth.load();
+        const auto height = framebufferHeight.load();
+        const float aspectRatio = height > 0 ? static_cast<float>(width) / static_cast<float>(height) : 1.0f;
+        extractor.extract(packet, aspectRatio);
+        {
+            PRISM_PROFILE_SCOPE("ImGui");
+            PRISM_ALLOCATION_SCOPE("ImGui");
+            // Debug panels are excluded from the steady state check, their allocations still show up in the tag
+            PRISM_ALLOCATION_ALLOW();
+            // The panels read the scene, so the UI is built here and render() only records its draw lists
+            imGuiImpl.newFrame();
+            imGuiImpl.endFrame(packet.imGuiDrawData);
+        }
+    }
+
+    void VulkanRenderer::render(const RenderFramePacket& packet)
+    {
+        PRISM_PROFILE_SCOPE("VulkanRenderer::render");
+        // Uploads wait for their copy to finish, so this packet can already draw the new meshes
+        for (const auto& registration : packet.registeredMeshes)
+        {
+            createMesh(registration);
+        }
+        for (const auto meshId : packet.unregisteredMeshIds)
+        {
+            pendingMeshDeletions.push_back({meshId, submittedFrameSerial});
+        }
+
+        if (framebufferResized || cvarPresentMode.get() != presentModeSetting ||
+            cvarFramesInFlight.get() != framesInFlightSetting)
+        {
+            LOG_DEBUG("Window resized, present mode or frames in flight changed - recreating swapchain!");
+            if (!recreateSwapChain())
+            {
+                return;
+            }
+        }
         const auto waitForFencesResult = logicalDevice->waitForFences(1, &inFlightFences[currentFrame], VK_TRUE,
                                                                       std::numeric_limits<uint64_t>::max());
         if (waitForFencesResult != vk::Result::eSuccess)
@@ -100,19 +172,26 @@ namespace Prism::Rendering::Vulkan
             throw std::runtime_error("Failed to wait for fences: " + vk::to_string(waitForFencesResult));
         }
 
-        for (const auto& meshIdToBeDeleted : pendingMeshIdsToBeDeleted)
+        // A fence also covers everything submitted before it, this slot held the oldest frame still in flight
+        completedFrameSerial = std::max(completedFrameSerial, frameSerials[currentFrame]);
+        // Other slots may still draw with a mesh, its buffers only go once every frame that could use them is done
+        std::erase_if(pendingMeshDeletions, [this](const PendingMeshDeletion& deletion)
         {
-            std::erase_if(meshes, [meshIdToBeDeleted](const std::shared_ptr<VulkanMesh>& vulkanMesh)
+            if (deletion.lastUsingFrameSerial > completedFrameSerial)
             {
-                if (!vulkanMesh->hasMeshIdAssociated(meshIdToBeDeleted))
+                return false;
+            }
+            std::erase_if(meshes, [&deletion](const std::shared_ptr<VulkanMesh>& vulkanMesh)
+            {
+                if (!vulkanMesh->hasMeshIdAssociated(deletion.meshId))
                 {
                     return false;
                 }
-                vulkanMesh->unassociateMeshId(meshIdToBeDeleted);
+                vulkanMesh->unassociateMeshId(deletion.meshId);
                 return vulkanMesh->getMeshIds().empty();
             });
-        }
-        pendingMeshIdsToBeDeleted.clear();
+            return true;
+        });
 
         uint32_t imageIndex;
         try
@@ -131,8 +210,11 @@ namespace Prism::Rendering::Vulkan
             throw std::runtime_error("Failed to acquire next image from swapchain: " + std::string(e.what()));
         }
 
-        updateCommandBuffer(static_cast<uint32_t>(currentFrame), imageIndex);
+        framePacket = &packet;
+        updateDebugLineBuffer(static_cast<uint32_t>(currentFrame));
         updateUniformBuffer(static_cast<uint32_t>(currentFrame));
+        updateCommandBuffer(static_cast<uint32_t>(currentFrame), imageIndex);
+        framePacket = nullptr;
 
 
         vk::SubmitInfo submitInfo = {};
@@ -161,6 +243,8 @@ namespace Prism::Rendering::Vulkan
         try
         {
             graphicsQueue.submit(submitInfo, inFlightFences[currentFrame]);
+            lastSubmittedFrame = currentFrame;
+            frameSerials[currentFrame] = ++submittedFrameSerial;
         }
         catch (vk::SystemError& e)
         {
@@ -189,31 +273,50 @@ namespace Prism::Rendering::Vulkan
         {
             throw std::runtime_error("Failed to present new image to the swapchain: " + std::string(e.what()));
         }
-        if (presentKhrResult == vk::Result::eSuboptimalKHR || framebufferResized)
+        if (presentKhrResult == vk::Result::eSuboptimalKHR || presentKhrResult == vk::Result::eErrorOutOfDateKHR ||
+            framebufferResized)
         {
             LOG_DEBUG("Swapchain out of date/suboptimal/window resized - recreating!");
-            framebufferResized = false;
             recreateSwapChain();
             return;
         }
 
-        currentFrame = (currentFrame + 1) & maxFramesInFlight;
+        currentFrame = (currentFrame + 1) % framesInFlightSetting;
     }
 
-    void VulkanRenderer::cleanupSwapChain()
+    void VulkanRenderer::publishFrameStatistics()
+    {
+        drawCount = renderedDrawCount;
+        const auto gpuPassTimings = gpuTimer.getPassTimings();
+        passTimings.assign(gpuPassTimings.begin(), gpuPassTimings.end());
+    }
+
+    bool VulkanRenderer::isLowLatencyEnabled() const
     {
-        logicalDevice->destroyImageView(depthImageView);
-        logicalDevice->destroyImage(depthImage);
-        logicalDevice->freeMemory(depthImageMemory);
+        return cvarLowLatency.get();
+    }
 
-        for (const auto& framebuffer : swapChainFramebuffers)
+    void VulkanRenderer::waitBeforeInputSampling()
+    {
+        // With the GPU idle the next frame can't queue behind others, it presents as soon as it is recorded
+        const auto waitForFenceResult = logicalDevice->waitForFences(1, &inFlightFences[lastSubmittedFrame], VK_TRUE,
+                                                                     std::numeric_limits<uint64_t>::max());
+        if (waitForFenceResult != vk::Result::eSuccess)
         {
-            logicalDevice->destroyFramebuffer(framebuffer);
+            throw std::runtime_error("Failed to wait for fences: " + vk::to_string(waitForFenceResult));
         }
+    }
+
+    void VulkanRenderer::cleanupSwapChain()
+    {
+        // Its transient images are sized to the swapchain
+        renderGraph.reset();
 
-        logicalDevice->destroyRenderPass(renderPass);
         logicalDevice->destroyPipeline(graphicsPipeline);
         logicalDevice->destroyPipelineLayout(pipelineLayout);
+        logicalDevice->destroyPipeline(debugLinePipeline);
+        logicalDevice->destroyPipeline(debugLineOverlayPipeline);
+        logicalDevice->destroyPipelineLayout(debugLinePipelineLayout);
 
         for (const auto& imageView : swapChainImageViews)
         {
@@ -227,6 +330,7 @@ namespace Prism::Rendering::Vulkan
         logicalDevice->waitIdle();
 
         imGuiImpl.shutdown();
+        gpuTimer.shutdown();
 
         cleanupSwapChain();
 
@@ -249,6 +353,7 @@ namespace Prism::Rendering::Vulkan
         {
             logicalDevice->destroyBuffer(uniformBuffers[i]);
             logicalDevice->freeMemory(uniformBuffersMemory[i]);
+            destroyDebugLineBuffer(i);
         }
 
         logicalDevice->destroyDescriptorPool(descriptorPool);
@@ -265,43 +370,54 @@ namespace Prism::Rendering::Vulkan
         instance->destroySurfaceKHR(surface);
     }
 
+    std::span<const GpuPassTiming> VulkanRenderer::getGpuPassTimings() const
+    {
+        return passTimings;
+    }
+
     RawPtr<AbstractImmediateModeGui> VulkanRenderer::getImmediateModeGui()
     {
         return &imGuiImpl;
     }
 
-    void VulkanRenderer::onFrameBufferResized(int width, int height)
+    void VulkanRenderer::onFrameBufferResized(const int width, const int height)
     {
+        framebufferWidth = width;
+        framebufferHeight = height;
         framebufferResized = true;
     }
 
-    void VulkanRenderer::recreateSwapChain()
+    bool VulkanRenderer::recreateSwapChain()
     {
-        int width = 0;
-        int height = 0;
-        while (width == 0 || height == 0)
+        // Minimized, the flag makes the next frame try again. Waiting for window events is up to the main thread.
+        if (framebufferWidth == 0 || framebufferHeight == 0)
         {
-            glfwGetFramebufferSize(glfwWindow, &width, &height);
-            glfwWaitEvents();
+            framebufferResized = true;
+            return false;
         }
+        framebufferResized = false;
 
         logicalDevice->waitIdle();
+        // Nothing is in flight anymore, so every slot is idle and the slot count can change safely
+        completedFrameSerial = submittedFrameSerial;
+        framesInFlightSetting = cvarFramesInFlight.get();
+        currentFrame = 0;
 
         cleanupSwapChain();
 
         createSwapChain();
         createImageViews();
-        createRenderPass();
+        createRenderGraph();
         createGraphicsPipeline();
-        createDepthResources();
-        createFramebuffers();
+        createDebugLinePipelines();
         createCommandBuffers();
+        return true;
     }
 
 
-    std::unique_ptr<VulkanBuffer> VulkanRenderer::createVertexBuffer(const std::vector<Vertex>& vertices)
+    std::unique_ptr<VulkanBuffer> VulkanRenderer::createVertexBuffer(const std::span<const Vertex> vertices)
     {
-        const vk::DeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
+        const vk::DeviceSize bufferSize = vertices.size_bytes();
 
         vk::Buffer stagingBuffer;
         vk::DeviceMemory stagingBufferMemory;
@@ -329,9 +445,9 @@ namespace Prism::Rendering::Vulkan
     }
 
 
-    std::unique_ptr<VulkanBuffer> VulkanRenderer::createIndexBuffer(const std::vector<uint32_t>& indices)
+    std::unique_ptr<VulkanBuffer> VulkanRenderer::createIndexBuffer(const std::span<const uint32_t> indices)
     {
-        const vk::DeviceSize bufferSize = sizeof(indices[0]) * indices.size();
+        const vk::DeviceSize bufferSize = indices.size_bytes();
 
         vk::Buffer stagingBuffer;
         vk::DeviceMemory stagingBufferMemory;
@@ -353,33 +469,38 @@ namespace Prism::Rendering::Vulkan
         return std::make_unique<VulkanBuffer>(indexBuffer, indexBufferMemory);
     }
 
-    void VulkanRenderer::registerNewStaticMesh(
-        const RawPtr<Core::StaticMesh> staticMesh)
+    void VulkanRenderer::createMesh(const RenderMeshRegistration& registration)
     {
-        const auto meshIter = std::ranges::find_if(meshes, [staticMesh](const std::shared_ptr<VulkanMesh>& vulkanMesh)
+        const auto& meshAsset = registration.meshAsset;
+        const auto meshIter = std::ranges::find_if(meshes, [&meshAsset](const std::shared_ptr<VulkanMesh>& vulkanMesh)
         {
-            return vulkanMesh->getMeshAssetName() == staticMesh->getMeshAsset()->getName();
+            return vulkanMesh->getMeshAssetName() == meshAsset->getName();
         });
         if (meshIter != meshes.end())
         {
-            if ((*meshIter)->associateMeshId(staticMesh->getMeshId()))
+            if ((*meshIter)->associateMeshId(registration.meshId))
             {
                 return;
             }
             throw std::runtime_error("Failed to associate mesh id with existing mesh! This should never happen!");
         }
-        auto vertexBuffer = createVertexBuffer(staticMesh->getMeshAsset()->getVertices());
-        auto indexBuffer = createIndexBuffer(staticMesh->getMeshAsset()->getIndices());
+        auto vertexBuffer = createVertexBuffer(meshAsset->getVertices());
+        auto indexBuffer = createIndexBuffer(meshAsset->getIndices());
         auto vulkanMesh = std::make_shared<
-            VulkanMesh>(&logicalDevice, staticMesh->getMeshAsset()->getName(),
-                        std::vector{staticMesh->getMeshId()},
+            VulkanMesh>(&logicalDevice, meshAsset->getName(),
+                        std::vector{registration.meshId},
                         std::move(vertexBuffer), std::move(indexBuffer));
         meshes.emplace_back(vulkanMesh);
     }
 
+    void VulkanRenderer::registerNewStaticMesh(const RawPtr<Core::StaticMesh> staticMesh)
+    {
+        extractor.registerStaticMesh(staticMesh);
+    }
+
     void VulkanRenderer::unregisterStaticMesh(const uint64_t staticMeshId)
     {
-        pendingMeshIdsToBeDeleted.emplace_back(staticMeshId);
+        extractor.unregisterStaticMesh(staticMeshId);
     }
 
     void VulkanRenderer::createInstance()
@@ -555,6 +676,18 @@ namespace Prism::Rendering::Vulkan
             return 0;
         }
 
+        // The render graph records with dynamic rendering and synchronization2
+        if (deviceProperties.apiVersion < VK_API_VERSION_1_3)
+        {
+            return 0;
+        }
+        const auto features = device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan13Features>();
+        const auto& vulkan13Features = features.get<vk::PhysicalDeviceVulkan13Features>();
+        if (!vulkan13Features.dynamicRendering || !vulkan13Features.synchronization2)
+        {
+            return 0;
+        }
+
         if (deviceProperties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu)
         {
             score += 1000;
@@ -638,11 +771,16 @@ namespace Prism::Rendering::Vulkan
         vk::PhysicalDeviceFeatures deviceFeatures;
         deviceFeatures.samplerAnisotropy = VK_TRUE;
 
+        vk::PhysicalDeviceVulkan13Features vulkan13Features;
+        vulkan13Features.dynamicRendering = VK_TRUE;
+        vulkan13Features.synchronization2 = VK_TRUE;
+
         auto createInfo = vk::DeviceCreateInfo(
             vk::DeviceCreateFlags(),
             static_cast<uint32_t>(queueCreateInfos.size()),
             queueCreateInfos.data()
         );
+        createInfo.pNext = &vulkan13Features;
         createInfo.pEnabledFeatures = &deviceFeatures;
         createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
         createInfo.ppEnabledExtensionNames = deviceExtensions.data();
@@ -691,6 +829,7 @@ namespace Prism::Rendering::Vulkan
     {
         const SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
         const vk::SurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
+        presentModeSetting = cvarPresentMode.get();
         const vk::PresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
         const vk::Extent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
 
@@ -769,21 +908,17 @@ namespace Prism::Rendering::Vulkan
     vk::PresentModeKHR VulkanRenderer::chooseSwapPresentMode(
         const std::vector<vk::PresentModeKHR>& availablePresentModes) const
     {
-        auto bestMode = vk::PresentModeKHR::eFifo;
-
-        for (const auto& availablePresentMode : availablePresentModes)
+        constexpr std::array presentModes = {
+            vk::PresentModeKHR::eFifo, vk::PresentModeKHR::eMailbox, vk::PresentModeKHR::eImmediate
+        };
+        const auto requestedMode = presentModes[presentModeSetting];
+        if (std::ranges::find(availablePresentModes, requestedMode) != availablePresentModes.end())
         {
-            if (availablePresentMode == vk::PresentModeKHR::eMailbox)
-            {
-                return availablePresentMode;
-            }
-            else if (availablePresentMode == vk::PresentModeKHR::eImmediate)
-            {
-                bestMode = availablePresentMode;
-            }
+            return requestedMode;
         }
-
-        return bestMode;
+        // FIFO is the only mode every implementation has to support
+        LOG_WARN("Present mode {} is not supported, falling back to FIFO", vk::to_string(requestedMode));
+        return vk::PresentModeKHR::eFifo;
     }
 
     vk::Extent2D VulkanRenderer::chooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities) const
@@ -794,10 +929,9 @@ namespace Prism::Rendering::Vulkan
         }
         else
         {
-            int width;
-            int height;
-            glfwGetFramebufferSize(glfwWindow, &width, &height);
-            vk::Extent2D actualExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+            vk::Extent2D actualExtent = {
+                static_cast<uint32_t>(framebufferWidth.load()), static_cast<uint32_t>(framebufferHeight.load())
+            };
 
             actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width,
                                             capabilities.maxImageExtent.width);
@@ -818,72 +952,57 @@ namespace Prism::Rendering::Vulkan
         }
     }
 
-    void VulkanRenderer::createRenderPass()
-    {
-        vk::AttachmentDescription colorAttachment = {};
-        colorAttachment.format = swapChainImageFormat;
-        colorAttachment.samples = vk::SampleCountFlagBits::e1;
-        colorAttachment.loadOp = vk::AttachmentLoadOp::eClear;
-        colorAttachment.storeOp = vk::AttachmentStoreOp::eStore;
-        colorAttachment.stencilLoadOp = vk::AttachmentLoadOp::eDontCare;
-        colorAttachment.stencilStoreOp = vk::AttachmentStoreOp::eDontCare;
-        colorAttachment.initialLayout = vk::ImageLayout::eUndefined;
-        // TODO: ImGui renders final layout, not this pass!
-        //colorAttachment.finalLayout = vk::ImageLayout::eColorAttachmentOptimal;
-        colorAttachment.finalLayout = vk::ImageLayout::ePresentSrcKHR;
-
-        vk::AttachmentDescription depthAttachment = {};
-        depthAttachment.format = findDepthFormat();
-        depthAttachment.samples = vk::SampleCountFlagBits::e1;
-        depthAttachment.loadOp = vk::AttachmentLoadOp::eClear;
-        depthAttachment.storeOp = vk::AttachmentStoreOp::eDontCare;
-        depthAttachment.stencilLoadOp = vk::AttachmentLoadOp::eDontCare;
-        depthAttachment.stencilStoreOp = vk::AttachmentStoreOp::eDontCare;
-        depthAttachment.initialLayout = vk::ImageLayout::eUndefined;
-        depthAttachment.finalLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-
-        vk::AttachmentReference colorAttachmentRef;
-        colorAttachmentRef.attachment = 0;
-        colorAttachmentRef.layout = vk::ImageLayout::eColorAttachmentOptimal;
-
-        vk::AttachmentReference depthAttachmentRef;
-        depthAttachmentRef.attachment = 1;
-        depthAttachmentRef.layout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-
-        vk::SubpassDescription subPass = {};
-        subPass.pipelineBindPoint = vk::PipelineBindPoint::eGraphics;
-        subPass.colorAttachmentCount = 1;
-        subPass.pColorAttachments = &colorAttachmentRef;
-        subPass.pDepthStencilAttachment = &depthAttachmentRef;
-
-        vk::SubpassDependency dependency = {};
-        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-        dependency.dstSubpass = 0;
-        dependency.srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput |
-            vk::PipelineStageFlagBits::eEarlyFragmentTests;
-        dependency.srcAccessMask = vk::AccessFlagBits::eNone;
-        dependency.dstStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput |
-            vk::PipelineStageFlagBits::eEarlyFragmentTests;
-        dependency.dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite |
-            vk::AccessFlagBits::eDepthStencilAttachmentWrite;
-
-        const std::array attachments = {colorAttachment, depthAttachment};
-        vk::RenderPassCreateInfo renderPassInfo = {};
-        renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-        renderPassInfo.pAttachments = attachments.data();
-        renderPassInfo.subpassCount = 1;
-        renderPassInfo.pSubpasses = &subPass;
-        renderPassInfo.dependencyCount = 1;
-        renderPassInfo.pDependencies = &dependency;
-
-        try
+    void VulkanRenderer::createRenderGraph()
+    {
+        backBufferImage = renderGraph.importImage({swapChainImageFormat, swapChainExtent},
+                                                  vk::ImageLayout::eUndefined,
+                                                  vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                                                  vk::ImageLayout::ePresentSrcKHR);
+        auto depthAspect = vk::ImageAspectFlags(vk::ImageAspectFlagBits::eDepth);
+        if (hasStencilComponent(depthFormat))
         {
-            renderPass = logicalDevice->createRenderPass(renderPassInfo);
+            depthAspect |= vk::ImageAspectFlagBits::eStencil;
         }
-        catch (vk::SystemError& e)
+        const auto depthImage = renderGraph.createImage({depthFormat, swapChainExtent, depthAspect});
+
+        renderGraph.addPass("Scene", [this](const vk::CommandBuffer& commandBuffer)
         {
-            throw std::runtime_error("Failed to create render pass: " + std::string(e.what()));
+            recordScenePass(commandBuffer);
+        }).writeColor(backBufferImage, vk::AttachmentLoadOp::eClear,
+                      vk::ClearColorValue(std::array{0.0f, 0.0f, 0.0f, 1.0f}))
+          .writeDepth(depthImage, vk::AttachmentLoadOp::eClear, vk::ClearDepthStencilValue(1.0f, 0));
+
+        // Loads both attachments, so it continues the rendering instance of the scene pass
+        renderGraph.addPass("DebugLines", [this](const vk::CommandBuffer& commandBuffer)
+        {
+            recordDebugLinePass(commandBuffer);
+        }).writeColor(backBufferImage, vk::AttachmentLoadOp::eLoad)
+          .writeDepth(depthImage, vk::AttachmentLoadOp::eLoad);
+
+        // Its pipeline has no depth attachment, so it needs a rendering instance of its own
+        renderGraph.addPass("ImGui", [this](const vk::CommandBuffer& commandBuffer)
+        {
+            recordImGuiPass(commandBuffer);
+        }).writeColor(backBufferImage, vk::AttachmentLoadOp::eLoad);
+        renderGraph.compile();
+
+        LOG_DEBUG("Render graph compiled: {} passes, {} culled, {} barriers, {} bytes transient memory ({} aliased)",
+                  renderGraph.getPassCount(), renderGraph.getCulledPassCount(), renderGraph.getBarrierCount(),
+                  renderGraph.getTransientMemorySize(), renderGraph.getAliasedMemorySize());
+    }
+
+    vk::PipelineRenderingCreateInfo VulkanRenderer::getPipelineRenderingInfo()
+    {
+        // Attachment formats of the scene passes, the pipelines are only used within them
+        vk::PipelineRenderingCreateInfo renderingInfo = {};
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachmentFormats = &swapChainImageFormat;
+        renderingInfo.depthAttachmentFormat = depthFormat;
+        if (hasStencilComponent(depthFormat))
+        {
+            renderingInfo.stencilAttachmentFormat = depthFormat;
         }
+        return renderingInfo;
     }
 
     vk::UniqueShaderModule VulkanRenderer::createShaderModule(const std::vector<char>& shaderCode)
@@ -1050,6 +1169,7 @@ namespace Prism::Rendering::Vulkan
             throw std::runtime_error("Failed to create pipeline layout: " + std::string(e.what()));
         }
 
+        const auto renderingInfo = getPipelineRenderingInfo();
         vk::GraphicsPipelineCreateInfo pipelineInfo = {};
         pipelineInfo.stageCount = 2;
         pipelineInfo.pStages = shaderStages.data();
@@ -1061,8 +1181,7 @@ namespace Prism::Rendering::Vulkan
         pipelineInfo.pDepthStencilState = &depthStencil;
         pipelineInfo.pColorBlendState = &colorBlending;
         pipelineInfo.layout = pipelineLayout;
-        pipelineInfo.renderPass = renderPass;
-        pipelineInfo.subpass = 0;
+        pipelineInfo.pNext = &renderingInfo;
         pipelineInfo.basePipelineHandle = nullptr;
         auto graphicsPipelineResult = logicalDevice->createGraphicsPipeline(nullptr, pipelineInfo);
         if (graphicsPipelineResult.result == vk::Result::eSuccess)
@@ -1076,40 +1195,144 @@ namespace Prism::Rendering::Vulkan
         }
     }
 
-    void VulkanRenderer::createFramebuffers()
+    void VulkanRenderer::createDebugLinePipelines()
     {
-        swapChainFramebuffers.resize(swapChainImageViews.size());
+        const auto assetManager = Utility::ServiceLocator::getService<Assets::AssetManager>();
+        const auto vertexShaderAsset = assetManager->getAsset<Assets::ShaderAsset>(
+            "Assets/Shaders/debug_line.vert.spv");
+        const auto fragmentShaderAsset = assetManager->getAsset<Assets::ShaderAsset>(
+            "Assets/Shaders/debug_line.frag.spv");
+        if (!vertexShaderAsset || !fragmentShaderAsset)
+        {
+            throw std::runtime_error("Failed to load debug line shader assets!");
+        }
+
+        auto vertexShaderModule = createShaderModule(vertexShaderAsset->getShader());
+        auto fragmentShaderModule = createShaderModule(fragmentShaderAsset->getShader());
+        std::array shaderStages = {
+            vk::PipelineShaderStageCreateInfo(vk::PipelineShaderStageCreateFlags(), vk::ShaderStageFlagBits::eVertex,
+                                              *vertexShaderModule, "main"),
+            vk::PipelineShaderStageCreateInfo(vk::PipelineShaderStageCreateFlags(), vk::ShaderStageFlagBits::eFragment,
+                                              *fragmentShaderModule, "main")
+        };
+
+        auto bindingDescription = DebugLineVertex::getBindingDescription();
+        auto attributeDescriptions = DebugLineVertex::getAttributeDescriptions();
+
+        vk::PipelineVertexInputStateCreateInfo vertexInputInfo = {};
+        vertexInputInfo.vertexBindingDescriptionCount = 1;
+        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+        vk::PipelineInputAssemblyStateCreateInfo inputAssembly = {};
+        inputAssembly.topology = vk::PrimitiveTopology::eLineList;
+        inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+        vk::Viewport viewport = {};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = static_cast<float>(swapChainExtent.width);
+        viewport.height = static_cast<float>(swapChainExtent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+
+        vk::Rect2D scissor = {};
+        scissor.offset = vk::Offset2D(0, 0);
+        scissor.extent = swapChainExtent;
+
+        vk::PipelineViewportStateCreateInfo viewportState = {};
+        viewportState.viewportCount = 1;
+        viewportState.pViewports = &viewport;
+        viewportState.scissorCount = 1;
+        viewportState.pScissors = &scissor;
+
+        // Wide lines are an optional device feature, so all debug lines are one pixel wide
+        vk::PipelineRasterizationStateCreateInfo rasterizer = {};
+        rasterizer.depthClampEnable = VK_FALSE;
+        rasterizer.rasterizerDiscardEnable = VK_FALSE;
+        rasterizer.polygonMode = vk::PolygonMode::eFill;
+        rasterizer.lineWidth = 1.0f;
+        rasterizer.cullMode = vk::CullModeFlagBits::eNone;
+        rasterizer.frontFace = vk::FrontFace::eCounterClockwise;
+        rasterizer.depthBiasEnable = VK_FALSE;
+
+        vk::PipelineMultisampleStateCreateInfo multisampling = {};
+        multisampling.sampleShadingEnable = VK_FALSE;
+        multisampling.rasterizationSamples = vk::SampleCountFlagBits::e1;
+
+        vk::PipelineDepthStencilStateCreateInfo depthStencil = {};
+        depthStencil.depthTestEnable = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp = vk::CompareOp::eLessOrEqual;
+        depthStencil.depthBoundsTestEnable = VK_FALSE;
+        depthStencil.stencilTestEnable = VK_FALSE;
 
-        for (size_t i = 0; i < swapChainImageViews.size(); ++i)
+        vk::PipelineColorBlendAttachmentState colorBlendAttachment = {};
+        colorBlendAttachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
+            vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
+        colorBlendAttachment.blendEnable = VK_FALSE;
+
+        vk::PipelineColorBlendStateCreateInfo colorBlending = {};
+        colorBlending.logicOpEnable = VK_FALSE;
+        colorBlending.attachmentCount = 1;
+        colorBlending.pAttachments = &colorBlendAttachment;
+
+        // Shares the descriptor sets of the mesh pipeline, only the view and projection are read
+        vk::PipelineLayoutCreateInfo pipelineLayoutInfo = {};
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 0;
+
+        try
         {
-            const std::array attachments = {
-                swapChainImageViews[i],
-                depthImageView
-            };
+            debugLinePipelineLayout = logicalDevice->createPipelineLayout(pipelineLayoutInfo);
+        }
+        catch (const vk::SystemError& e)
+        {
+            throw std::runtime_error("Failed to create debug line pipeline layout: " + std::string(e.what()));
+        }
 
-            vk::FramebufferCreateInfo framebufferInfo = {};
-            framebufferInfo.renderPass = renderPass;
-            framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-            framebufferInfo.pAttachments = attachments.data();
-            framebufferInfo.width = swapChainExtent.width;
-            framebufferInfo.height = swapChainExtent.height;
-            framebufferInfo.layers = 1;
+        const auto renderingInfo = getPipelineRenderingInfo();
+        vk::GraphicsPipelineCreateInfo pipelineInfo = {};
+        pipelineInfo.stageCount = 2;
+        pipelineInfo.pStages = shaderStages.data();
+        pipelineInfo.pVertexInputState = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.layout = debugLinePipelineLayout;
+        pipelineInfo.pNext = &renderingInfo;
+        pipelineInfo.basePipelineHandle = nullptr;
+        auto debugLinePipelineResult = logicalDevice->createGraphicsPipeline(nullptr, pipelineInfo);
+        if (debugLinePipelineResult.result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error(
+                "Failed to create debug line pipeline, error: " + vk::to_string(debugLinePipelineResult.result));
+        }
+        debugLinePipeline = debugLinePipelineResult.value;
 
-            try
-            {
-                swapChainFramebuffers[i] = logicalDevice->createFramebuffer(framebufferInfo);
-            }
-            catch (vk::SystemError& e)
-            {
-                throw std::runtime_error("Failed to create framebuffer: " + std::string(e.what()));
-            }
+        // Overlay variant ignores and leaves the depth buffer alone
+        depthStencil.depthTestEnable = VK_FALSE;
+        depthStencil.depthWriteEnable = VK_FALSE;
+        auto debugLineOverlayPipelineResult = logicalDevice->createGraphicsPipeline(nullptr, pipelineInfo);
+        if (debugLineOverlayPipelineResult.result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error(
+                "Failed to create debug line overlay pipeline, error: " + vk::to_string(
+                    debugLineOverlayPipelineResult.result));
         }
+        debugLineOverlayPipeline = debugLineOverlayPipelineResult.value;
     }
 
     void VulkanRenderer::createCommandPools()
     {
         globalCommandPool = createCommandPool();
-        for (size_t i = 0; i < swapChainImages.size(); ++i)
+        // One per frame in flight, command buffers are recorded per frame and not per swapchain image
+        for (size_t i = 0; i < maxFramesInFlight; ++i)
         {
             commandPools.push_back(createCommandPool());
         }
@@ -1132,17 +1355,6 @@ namespace Prism::Rendering::Vulkan
         }
     }
 
-    void VulkanRenderer::createDepthResources()
-    {
-        const auto depthFormat = findDepthFormat();
-        createImage(swapChainExtent.width, swapChainExtent.height, depthFormat, vk::ImageTiling::eOptimal,
-                    vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal,
-                    depthImage, depthImageMemory);
-        depthImageView = createImageView(depthImage, depthFormat, vk::ImageAspectFlagBits::eDepth);
-        transitionImageLayout(depthImage, depthFormat, vk::ImageLayout::eUndefined,
-                              vk::ImageLayout::eDepthStencilAttachmentOptimal);
-    }
-
     vk::Format VulkanRenderer::findSupportedFormat(const std::vector<vk::Format>& candidates,
                                                    const vk::ImageTiling tiling,
                                                    const vk::FormatFeatureFlags& features) const
@@ -1179,7 +1391,8 @@ namespace Prism::Rendering::Vulkan
     void VulkanRenderer::createTextureImage()
     {
         const auto assetManager = Utility::ServiceLocator::getService<Assets::AssetManager>();
-        const auto textureAsset = assetManager->getAsset<Assets::TextureAsset>("Assets/Textures/texture.jpg");
+        const std::string texturePath = "Assets/Textures/texture.jpg";
+        auto textureAsset = assetManager->getAsset<Assets::TextureAsset>(texturePath);
         if (!textureAsset)
         {
             throw std::runtime_error("Failed to load texture asset!");
@@ -1203,14 +1416,22 @@ namespace Prism::Rendering::Vulkan
                     vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
                     vk::MemoryPropertyFlagBits::eDeviceLocal, textureImage, textureImageMemory);
 
-        transitionImageLayout(textureImage, vk::Format::eR8G8B8A8Srgb, vk::ImageLayout::eUndefined,
+        // One submit and wait for the whole upload instead of one per step
+        const vk::CommandBuffer commandBuffer = beginSingleTimeCommands();
+        transitionImageLayout(commandBuffer, textureImage, vk::ImageLayout::eUndefined,
                               vk::ImageLayout::eTransferDstOptimal);
-        copyBufferToImage(stagingBuffer, textureImage, textureAsset->getWidth(), textureAsset->getHeight());
-        transitionImageLayout(textureImage, vk::Format::eR8G8B8A8Srgb, vk::ImageLayout::eTransferDstOptimal,
+        copyBufferToImage(commandBuffer, stagingBuffer, textureImage, textureAsset->getWidth(),
+                          textureAsset->getHeight());
+        transitionImageLayout(commandBuffer, textureImage, vk::ImageLayout::eTransferDstOptimal,
                               vk::ImageLayout::eShaderReadOnlyOptimal);
+        endSingleTimeCommands(commandBuffer);
 
         logicalDevice->destroyBuffer(stagingBuffer);
         logicalDevice->freeMemory(stagingBufferMemory);
+        // The pixels live on the GPU now. Others may still use the cached asset, so it is only dropped when we were
+        // the last user, uploading it again reloads it from disk.
+        textureAsset.reset();
+        assetManager->evictIfUnreferenced<Assets::TextureAsset>(texturePath);
     }
 
     void VulkanRenderer::createImage(const uint32_t width, const uint32_t height, const vk::Format format,
@@ -1339,12 +1560,10 @@ namespace Prism::Rendering::Vulkan
         logicalDevice->freeCommandBuffers(globalCommandPool, commandBuffer);
     }
 
-    void VulkanRenderer::transitionImageLayout(vk::Image image, vk::Format format, const vk::ImageLayout oldLayout,
-                                               const vk::ImageLayout newLayout)
+    void VulkanRenderer::transitionImageLayout(const vk::CommandBuffer& commandBuffer, const vk::Image image,
+                                               const vk::ImageLayout oldLayout, const vk::ImageLayout newLayout)
     {
-        const vk::CommandBuffer commandBuffer = beginSingleTimeCommands();
-
-        vk::ImageMemoryBarrier barrier = {};
+        vk::ImageMemoryBarrier2 barrier = {};
         barrier.oldLayout = oldLayout;
         barrier.newLayout = newLayout;
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -1356,61 +1575,36 @@ namespace Prism::Rendering::Vulkan
         barrier.subresourceRange.baseArrayLayer = 0;
         barrier.subresourceRange.layerCount = 1;
 
-        vk::PipelineStageFlags sourceStage;
-        vk::PipelineStageFlags destinationStage;
-
-        if (newLayout == vk::ImageLayout::eDepthStencilAttachmentOptimal)
-        {
-            barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eDepth;
-            if (hasStencilComponent(format))
-            {
-                barrier.subresourceRange.aspectMask |= vk::ImageAspectFlagBits::eStencil;
-            }
-        }
-        else
-        {
-            barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-        }
-
+        // Attachments are transitioned by the render graph, this only covers uploads
         if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eTransferDstOptimal)
         {
-            barrier.srcAccessMask = vk::AccessFlagBits::eNone;
-            barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-            sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
-            destinationStage = vk::PipelineStageFlagBits::eTransfer;
+            barrier.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+            barrier.srcAccessMask = vk::AccessFlagBits2::eNone;
+            barrier.dstStageMask = vk::PipelineStageFlagBits2::eCopy;
+            barrier.dstAccessMask = vk::AccessFlagBits2::eTransferWrite;
         }
         else if (oldLayout == vk::ImageLayout::eTransferDstOptimal && newLayout ==
             vk::ImageLayout::eShaderReadOnlyOptimal)
         {
-            barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-            barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-            sourceStage = vk::PipelineStageFlagBits::eTransfer;
-            destinationStage = vk::PipelineStageFlagBits::eFragmentShader;
-        }
-        else if (oldLayout == vk::ImageLayout::eUndefined && newLayout ==
-            vk::ImageLayout::eDepthStencilAttachmentOptimal)
-        {
-            barrier.srcAccessMask = vk::AccessFlagBits::eNone;
-            barrier.dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead |
-                vk::AccessFlagBits::eDepthStencilAttachmentWrite;
-            sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
-            destinationStage = vk::PipelineStageFlagBits::eEarlyFragmentTests;
+            barrier.srcStageMask = vk::PipelineStageFlagBits2::eCopy;
+            barrier.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+            barrier.dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader;
+            barrier.dstAccessMask = vk::AccessFlagBits2::eShaderSampledRead;
         }
         else
         {
             throw std::invalid_argument("Unsupported layout transition!");
         }
 
-        commandBuffer.pipelineBarrier(sourceStage, destinationStage, vk::DependencyFlags(), nullptr, nullptr, barrier);
-
-        endSingleTimeCommands(commandBuffer);
+        vk::DependencyInfo dependencyInfo = {};
+        dependencyInfo.imageMemoryBarrierCount = 1;
+        dependencyInfo.pImageMemoryBarriers = &barrier;
+        commandBuffer.pipelineBarrier2(dependencyInfo);
     }
 
-    void VulkanRenderer::copyBufferToImage(vk::Buffer buffer, vk::Image image, const uint32_t width,
-                                           const uint32_t height)
+    void VulkanRenderer::copyBufferToImage(const vk::CommandBuffer& commandBuffer, const vk::Buffer buffer,
+                                           const vk::Image image, const uint32_t width, const uint32_t height)
     {
-        const vk::CommandBuffer commandBuffer = beginSingleTimeCommands();
-
         vk::BufferImageCopy region;
         region.bufferOffset = 0;
         region.bufferRowLength = 0;
@@ -1423,8 +1617,6 @@ namespace Prism::Rendering::Vulkan
         region.imageExtent = vk::Extent3D{width, height, 1};
 
         commandBuffer.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, region);
-
-        endSingleTimeCommands(commandBuffer);
     }
 
     void VulkanRenderer::createUniformBuffers()
@@ -1440,6 +1632,57 @@ namespace Prism::Rendering::Vulkan
         }
     }
 
+    void VulkanRenderer::createDebugLineBuffers()
+    {
+        debugLineBuffers.resize(maxFramesInFlight);
+        debugLineBuffersMemory.resize(maxFramesInFlight);
+        debugLineBuffersMapped.resize(maxFramesInFlight);
+        debugLineBufferCapacities.resize(maxFramesInFlight);
+        debugLineVertexCounts.resize(maxFramesInFlight);
+        for (size_t i = 0; i < maxFramesInFlight; ++i)
+        {
+            createDebugLineBuffer(i, minDebugLineBufferVertexCount);
+        }
+    }
+
+    void VulkanRenderer::createDebugLineBuffer(const size_t frameIndex, const size_t vertexCapacity)
+    {
+        const vk::DeviceSize bufferSize = vertexCapacity * sizeof(DebugLineVertex);
+        createBuffer(bufferSize, vk::BufferUsageFlagBits::eVertexBuffer,
+                     vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                     debugLineBuffers[frameIndex], debugLineBuffersMemory[frameIndex]);
+        debugLineBuffersMapped[frameIndex] = static_cast<DebugLineVertex*>(
+            logicalDevice->mapMemory(debugLineBuffersMemory[frameIndex], 0, bufferSize));
+        debugLineBufferCapacities[frameIndex] = vertexCapacity;
+    }
+
+    void VulkanRenderer::destroyDebugLineBuffer(const size_t frameIndex)
+    {
+        logicalDevice->unmapMemory(debugLineBuffersMemory[frameIndex]);
+        logicalDevice->destroyBuffer(debugLineBuffers[frameIndex]);
+        logicalDevice->freeMemory(debugLineBuffersMemory[frameIndex]);
+        debugLineBuffersMapped[frameIndex] = nullptr;
+        debugLineBufferCapacities[frameIndex] = 0;
+    }
+
+    void VulkanRenderer::updateDebugLineBuffer(const uint32_t currentImage)
+    {
+        // The fence of this frame has been waited on, so its buffer is no longer read by the GPU
+        const auto& debugLineCounts = framePacket->debugLineCounts;
+        const size_t vertexCount = debugLineCounts.depthTested + debugLineCounts.overlay;
+        if (vertexCount > debugLineBufferCapacities[currentImage])
+        {
+            destroyDebugLineBuffer(currentImage);
+            createDebugLineBuffer(currentImage, std::bit_ceil(vertexCount));
+        }
+        if (vertexCount > 0)
+        {
+            std::memcpy(debugLineBuffersMapped[currentImage], framePacket->debugLineVertices.data(),
+                        vertexCount * sizeof(DebugLineVertex));
+        }
+        debugLineVertexCounts[currentImage] = debugLineCounts;
+    }
+
     void VulkanRenderer::createBuffer(const vk::DeviceSize size, const vk::BufferUsageFlags& usage,
                                       const vk::MemoryPropertyFlags& properties, vk::Buffer& buffer,
                                       vk::DeviceMemory& bufferMemory)
@@ -1537,8 +1780,8 @@ namespace Prism::Rendering::Vulkan
 
     void VulkanRenderer::createCommandBuffers()
     {
-        commandBuffers.resize(swapChainFramebuffers.size());
-        for (size_t i = 0; i < swapChainFramebuffers.size(); ++i)
+        commandBuffers.resize(commandPools.size());
+        for (size_t i = 0; i < commandPools.size(); ++i)
         {
             vk::CommandBufferAllocateInfo allocInfo = {};
             allocInfo.commandPool = commandPools[i];
@@ -1558,7 +1801,7 @@ namespace Prism::Rendering::Vulkan
 
     void VulkanRenderer::createCommandBuffer(const vk::CommandBuffer& commandBuffer, const uint32_t currentImage)
     {
-        const auto activeScene = sceneManager->getActiveScene();
+        PRISM_PROFILE_SCOPE("VulkanRenderer::createCommandBuffer");
 
         vk::CommandBufferBeginInfo beginInfo = {};
         beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
@@ -1571,82 +1814,10 @@ namespace Prism::Rendering::Vulkan
         {
             throw std::runtime_error("Failed to begin recording commandbuffer: " + std::string(e.what()));
         }
+        gpuTimer.beginFrame(commandBuffer, static_cast<uint32_t>(currentFrame));
 
-        vk::RenderPassBeginInfo renderPassInfo = {};
-        renderPassInfo.renderPass = renderPass;
-        renderPassInfo.framebuffer = swapChainFramebuffers[currentImage];
-        renderPassInfo.renderArea.offset = vk::Offset2D{0, 0};
-        renderPassInfo.renderArea.extent = swapChainExtent;
-
-        std::array<vk::ClearValue, 2> clearValues = {};
-        clearValues[0].color = vk::ClearColorValue(std::array{0.0f, 0.0f, 0.0f, 1.0f});
-        clearValues[1].depthStencil = vk::ClearDepthStencilValue(1.0f, 0);
-        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-        renderPassInfo.pClearValues = clearValues.data();
-
-        const auto activeCamera = cameraManager->getActiveCamera();
-
-
-        commandBuffer.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
-        {
-            commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, graphicsPipeline);
-            const auto staticMeshComponents = activeScene->getComponents<Core::StaticMeshComponent>();
-            for (const auto& staticMeshComponent : staticMeshComponents)
-            {
-                if (!staticMeshComponent || !staticMeshComponent->isVisible())
-                {
-                    continue;
-                }
-                const auto staticMesh = staticMeshComponent->getStaticMesh();
-
-                const auto meshIter = std::ranges::find_if(meshes,
-                                                           [&](const std::shared_ptr<VulkanMesh>& vulkanMesh)
-                                                           {
-                                                               return vulkanMesh->hasMeshIdAssociated(staticMesh->
-                                                                   getMeshId());
-                                                           });
-                if (meshIter == meshes.end())
-                {
-                    LOG_ERROR("Could not find associated VulkanMesh of StaticMeshComponent {}, this should not happen!",
-                              staticMeshComponent->getName());
-                    continue;
-                }
-                const auto vulkanMesh = *meshIter;
-                std::array vertexBuffers = {
-                    vulkanMesh->getVertexBuffer().getBuffer()
-                };
-                constexpr std::array<vk::DeviceSize, 1> offsets = {0};
-                const auto indexBuffer = vulkanMesh->getIndexBuffer().getBuffer();
-                commandBuffer.bindVertexBuffers(0, 1, vertexBuffers.data(), offsets.data());
-                commandBuffer.bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
-                commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0, 1,
-                                                 &descriptorSets[currentFrame], 0, nullptr);
-
-                PushConstantObject pco = {};
-                pco.model = staticMeshComponent->getAbsoluteTransform().toMatrix();
-                pco.color = staticMeshComponent->getMeshColor();
-                if (activeCamera)
-                {
-                    pco.lightPos = activeCamera->getAbsoluteTransform().getTranslation();
-                }
-                else
-                {
-                    pco.lightPos = glm::vec3(0.0f, 0.0f, 0.0f);
-                }
-                commandBuffer.pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0,
-                                            sizeof(PushConstantObject), &pco);
-
-                commandBuffer.drawIndexed(
-                    static_cast<uint32_t>(staticMeshComponent->getStaticMeshAsset()->getIndices().size()), 1, 0, 0,
-                    0);
-            }
-        }
-
-        // ImGui Rendering
-        imGuiImpl.newFrame();
-        imGuiImpl.render(commandBuffer);
-
-        commandBuffer.endRenderPass();
+        renderGraph.setImportedImage(backBufferImage, swapChainImages[currentImage], swapChainImageViews[currentImage]);
+        renderGraph.execute(commandBuffer, gpuTimer);
 
         try
         {
@@ -1658,6 +1829,79 @@ namespace Prism::Rendering::Vulkan
         }
     }
 
+    void VulkanRenderer::recordScenePass(const vk::CommandBuffer& commandBuffer)
+    {
+        renderedDrawCount = 0;
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, graphicsPipeline);
+        // Already culled by the extraction
+        for (const auto& meshInstance : framePacket->meshInstances)
+        {
+            const auto meshIter = std::ranges::find_if(meshes,
+                                                       [&](const std::shared_ptr<VulkanMesh>& vulkanMesh)
+                                                       {
+                                                           return vulkanMesh->hasMeshIdAssociated(meshInstance.meshId);
+                                                       });
+            if (meshIter == meshes.end())
+            {
+                LOG_RATE_LIMITED(LOG_ERROR, "Could not find associated VulkanMesh of mesh {}, this should not happen!",
+                                 meshInstance.meshId);
+                continue;
+            }
+            const auto vulkanMesh = *meshIter;
+            std::array vertexBuffers = {
+                vulkanMesh->getVertexBuffer().getBuffer()
+            };
+            constexpr std::array<vk::DeviceSize, 1> offsets = {0};
+            const auto indexBuffer = vulkanMesh->getIndexBuffer().getBuffer();
+            commandBuffer.bindVertexBuffers(0, 1, vertexBuffers.data(), offsets.data());
+            commandBuffer.bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0, 1,
+                                             &descriptorSets[currentFrame], 0, nullptr);
+
+            PushConstantObject pco = {};
+            pco.model = meshInstance.model;
+            pco.color = meshInstance.color;
+            pco.lightPos = framePacket->lightPosition;
+            commandBuffer.pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0,
+                                        sizeof(PushConstantObject), &pco);
+
+            commandBuffer.drawIndexed(meshInstance.indexCount, 1, 0, 0, 0);
+            ++renderedDrawCount;
+        }
+    }
+
+    void VulkanRenderer::recordDebugLinePass(const vk::CommandBuffer& commandBuffer)
+    {
+        // Depth tested ones first and overlay ones on top, both live in the same buffer
+        const auto& debugLineCounts = debugLineVertexCounts[currentFrame];
+        if (debugLineCounts.depthTested > 0 || debugLineCounts.overlay > 0)
+        {
+            const std::array vertexBuffers = {debugLineBuffers[currentFrame]};
+            constexpr std::array<vk::DeviceSize, 1> offsets = {0};
+            commandBuffer.bindVertexBuffers(0, 1, vertexBuffers.data(), offsets.data());
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, debugLinePipelineLayout, 0, 1,
+                                             &descriptorSets[currentFrame], 0, nullptr);
+            if (debugLineCounts.depthTested > 0)
+            {
+                commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, debugLinePipeline);
+                commandBuffer.draw(debugLineCounts.depthTested, 1, 0, 0);
+            }
+            if (debugLineCounts.overlay > 0)
+            {
+                commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, debugLineOverlayPipeline);
+                commandBuffer.draw(debugLineCounts.overlay, 1, debugLineCounts.depthTested, 0);
+            }
+        }
+    }
+
+    void VulkanRenderer::recordImGuiPass(const vk::CommandBuffer& commandBuffer)
+    {
+        PRISM_PROFILE_SCOPE("ImGui");
+        PRISM_ALLOCATION_SCOPE("ImGui");
+        imGuiImpl.render(commandBuffer, framePacket->imGuiDrawData);
+    }
+
     void VulkanRenderer::updateCommandBuffer(const uint32_t currentImage, const uint32_t imageIndex)
     {
         const auto& oldCommandPool = commandPools[currentImage];
@@ -1669,26 +1913,8 @@ namespace Prism::Rendering::Vulkan
     void VulkanRenderer::updateUniformBuffer(const uint32_t currentImage)
     {
         UniformBufferObject ubo;
-
-        //Retrieve active camera
-        if (const auto activeCamera = cameraManager->getActiveCamera())
-        {
-            auto camTransform = activeCamera->getAbsoluteTransform();
-            ubo.view = camTransform.toMatrix(true);
-            ubo.projection = glm::perspective(glm::radians(activeCamera->fov),
-                                              static_cast<float>(swapChainExtent.width) / static_cast<float>(
-                                                  swapChainExtent.height),
-                                              activeCamera->zNear, activeCamera->zFar);
-        }
-        else
-        {
-            ubo.view = glm::lookAt(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 0.0f),
-                                   glm::vec3(0.0f, 1.0f, 0.0f));
-            ubo.projection = glm::perspective(glm::radians(45.0f),
-                                              static_cast<float>(swapChainExtent.width) / static_cast<float>(
-                                                  swapChainExtent.height), 0.1f,
-                                              10.0f);
-        }
+        ubo.view = framePacket->view;
+        ubo.projection = framePacket->projection;
 
         constexpr vk::DeviceSize bufferSize = sizeof(UniformBufferObject);
         void* data = logicalDevice->mapMemory(uniformBuffersMemory[currentImage], 0, bufferSize);
@@ -1,12 +1,16 @@
 ﻿#pragma once
+#include <array>
+#include <atomic>
 #include <optional>
+#include <span>
 
-#include "../ICameraManager.hpp"
-#include "../../Core/ISceneManager.hpp"
 #include "vulkan/vulkan.hpp"
 #include "../IRenderer.hpp"
+#include "../RenderFrameExtractor.hpp"
 #include "VulkanBuffer.hpp"
 #include "VulkanMesh.hpp"
+#include "VulkanGpuTimer.hpp"
+#include "RenderGraph.hpp"
 #include "ImGui/ImGuiImplVulkan.hpp"
 #include "../GraphicsDebugBridge.hpp"
 
@@ -36,18 +40,30 @@ namespace Prism::Rendering::Vulkan
     class VulkanRenderer : public IRenderer
     {
     public:
-        inline constexpr static uint32_t maxFramesInFlight = 2;
+        // Per frame resources exist this many times, renderer.framesInFlight selects how many of them are used
+        inline constexpr static uint32_t maxFramesInFlight = 3;
         vk::Format swapChainImageFormat = vk::Format::eUndefined;
         std::vector<vk::Image> swapChainImages;
 
         explicit VulkanRenderer(GLFWwindow* newGlfwWindow);
         void init() override;
-        void render() override;
+        void extract(RenderFramePacket& packet) override;
+        void render(const RenderFramePacket& packet) override;
+        void publishFrameStatistics() override;
+        [[nodiscard]] bool isLowLatencyEnabled() const override;
+        void waitBeforeInputSampling() override;
         void shutdown() override;
         RawPtr<AbstractImmediateModeGui> getImmediateModeGui() override;
         void onFrameBufferResized(int width, int height) override;
         void registerNewStaticMesh(RawPtr<Core::StaticMesh> staticMesh) override;
         void unregisterStaticMesh(uint64_t staticMeshId) override;
+        [[nodiscard]] std::span<const GpuPassTiming> getGpuPassTimings() const override;
+
+        [[nodiscard]] uint32_t getDrawCount() const override
+        {
+            return drawCount;
+        }
+
         vk::CommandBuffer beginSingleTimeCommands();
         void endSingleTimeCommands(vk::CommandBuffer commandBuffer);
         [[nodiscard]] QueueFamilyIndices findQueueFamilies(const vk::PhysicalDevice& device) const;
@@ -60,9 +76,18 @@ namespace Prism::Rendering::Vulkan
 
         RawPtr<GraphicsDebugBridge> graphicsDebugBridge;
 
-        RawPtr<ICameraManager> cameraManager;
-        RawPtr<Core::ISceneManager> sceneManager;
+        RenderFrameExtractor extractor;
         ImGuiImplVulkan imGuiImpl;
+        VulkanGpuTimer gpuTimer;
+        RenderGraph renderGraph;
+        // Imported into the render graph, retargeted to the acquired swapchain image every frame
+        RenderGraphResource backBufferImage = 0;
+        // Packet of the frame being recorded, only set within render()
+        const RenderFramePacket* framePacket = nullptr;
+        // Written by render(), copied for the main thread by publishFrameStatistics()
+        uint32_t renderedDrawCount = 0;
+        uint32_t drawCount = 0;
+        std::vector<GpuPassTiming> passTimings;
 
         vk::UniqueInstance instance;
         vk::UniqueDebugUtilsMessengerEXT debugMessenger;
@@ -78,12 +103,14 @@ namespace Prism::Rendering::Vulkan
 
         vk::Extent2D swapChainExtent;
         std::vector<vk::ImageView> swapChainImageViews;
-        std::vector<vk::Framebuffer> swapChainFramebuffers;
+        vk::Format depthFormat = vk::Format::eUndefined;
 
-        vk::RenderPass renderPass;
         vk::DescriptorSetLayout descriptorSetLayout;
         vk::PipelineLayout pipelineLayout;
         vk::Pipeline graphicsPipeline;
+        vk::PipelineLayout debugLinePipelineLayout;
+        vk::Pipeline debugLinePipeline;
+        vk::Pipeline debugLineOverlayPipeline;
 
         vk::CommandPool globalCommandPool;
 
@@ -93,15 +120,26 @@ namespace Prism::Rendering::Vulkan
         vk::Sampler textureSampler;
 
         std::vector<std::shared_ptr<VulkanMesh>> meshes;
-        std::vector<uint64_t> pendingMeshIdsToBeDeleted;
+        struct PendingMeshDeletion
+        {
+            uint64_t meshId;
+            // Serial of the last frame submitted before the unregistration, the last one that may draw the mesh
+            uint64_t lastUsingFrameSerial;
+        };
 
-        vk::Image depthImage;
-        vk::DeviceMemory depthImageMemory;
-        vk::ImageView depthImageView;
+        std::vector<PendingMeshDeletion> pendingMeshDeletions;
 
         std::vector<vk::Buffer> uniformBuffers;
         std::vector<vk::DeviceMemory> uniformBuffersMemory;
 
+        // Host visible and persistently mapped, rewritten every frame with the lines of the DebugDrawHelper
+        inline constexpr static size_t minDebugLineBufferVertexCount = 4096;
+        std::vector<vk::Buffer> debugLineBuffers;
+        std::vector<vk::DeviceMemory> debugLineBuffersMemory;
+        std::vector<DebugLineVertex*> debugLineBuffersMapped;
+        std::vector<size_t> debugLineBufferCapacities;
+        std::vector<DebugDrawVertexCounts> debugLineVertexCounts;
+
         vk::DescriptorPool descriptorPool;
         std::vector<vk::DescriptorSet> descriptorSets;
 
@@ -112,8 +150,20 @@ namespace Prism::Rendering::Vulkan
         std::vector<vk::Semaphore> renderFinishedSemaphores;
         std::vector<vk::Fence> inFlightFences;
         size_t currentFrame = 0;
+        size_t lastSubmittedFrame = 0;
+        // Every submitted frame gets the next serial, frameSerials holds the last one submitted per slot
+        uint64_t submittedFrameSerial = 0;
+        uint64_t completedFrameSerial = 0;
+        std::array<uint64_t, maxFramesInFlight> frameSerials = {};
+        // renderer.presentMode the swapchain was created with, a different value recreates it
+        uint32_t presentModeSetting = 0;
+        // renderer.framesInFlight in use, only changed while the device is idle during a swapchain recreation
+        uint32_t framesInFlightSetting = 1;
 
-        bool framebufferResized = false;
+        // Set from the window callbacks on the main thread, GLFW must not be called from the render thread
+        std::atomic<bool> framebufferResized = false;
+        std::atomic<int> framebufferWidth = 0;
+        std::atomic<int> framebufferHeight = 0;
 
         std::vector<const char*> validationLayers = {
             "VK_LAYER_KHRONOS_validation"
@@ -126,7 +176,9 @@ namespace Prism::Rendering::Vulkan
             VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
             VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
             VK_KHR_RAY_QUERY_EXTENSION_NAME,
-            VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME
+            VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+            // Core since 1.3, but ImGui only uses dynamic rendering through the extension's entry points
+            VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME
         };
 
 #ifdef Prism_DEBUG
@@ -147,9 +199,11 @@ namespace Prism::Rendering::Vulkan
         [[nodiscard]] bool checkDeviceExtensionSupport(const vk::PhysicalDevice& device) const;
         [[nodiscard]] SwapChainSupportDetails querySwapChainSupport(const vk::PhysicalDevice& device) const;
         void createSwapChain();
-        std::unique_ptr<VulkanBuffer> createVertexBuffer(const std::vector<Vertex>& vertices);
-        std::unique_ptr<VulkanBuffer> createIndexBuffer(const std::vector<uint32_t>& indices);
-        void recreateSwapChain();
+        std::unique_ptr<VulkanBuffer> createVertexBuffer(std::span<const Vertex> vertices);
+        std::unique_ptr<VulkanBuffer> createIndexBuffer(std::span<const uint32_t> indices);
+        void createMesh(const RenderMeshRegistration& registration);
+        // Returns false while the window is minimized, the swapchain is recreated once it has a size again
+        bool recreateSwapChain();
         void cleanupSwapChain();
         [[nodiscard]] vk::SurfaceFormatKHR chooseSwapSurfaceFormat(
             const std::vector<vk::SurfaceFormatKHR>& availableFormats) const;
@@ -157,12 +211,16 @@ namespace Prism::Rendering::Vulkan
             const std::vector<vk::PresentModeKHR>& availablePresentModes) const;
         [[nodiscard]] vk::Extent2D chooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities) const;
         void createImageViews();
-        void createRenderPass();
+        void createRenderGraph();
+        [[nodiscard]] vk::PipelineRenderingCreateInfo getPipelineRenderingInfo();
         void createGraphicsPipeline();
-        void createFramebuffers();
+        void createDebugLinePipelines();
+        void createDebugLineBuffers();
+        void createDebugLineBuffer(size_t frameIndex, size_t vertexCapacity);
+        void destroyDebugLineBuffer(size_t frameIndex);
+        void updateDebugLineBuffer(uint32_t currentImage);
         void createCommandPools();
         vk::CommandPool createCommandPool();
-        void createDepthResources();
         vk::Format findSupportedFormat(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling,
                                        const vk::FormatFeatureFlags& features) const;
         vk::Format findDepthFormat() const;
@@ -175,9 +233,11 @@ namespace Prism::Rendering::Vulkan
         vk::ImageView createImageView(const vk::Image& image, const vk::Format& format,
                                       const vk::ImageAspectFlags& aspectFlags);
         void createTextureSampler();
-        void transitionImageLayout(vk::Image image, vk::Format format, vk::ImageLayout oldLayout,
+        // Record into the given command buffer, so uploads can batch them into a single submit
+        void transitionImageLayout(const vk::CommandBuffer& commandBuffer, vk::Image image, vk::ImageLayout oldLayout,
                                    vk::ImageLayout newLayout);
-        void copyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height);
+        void copyBufferToImage(const vk::CommandBuffer& commandBuffer, vk::Buffer buffer, vk::Image image,
+                               uint32_t width, uint32_t height);
         void createUniformBuffers();
         void copyBuffer(const VkBuffer& srcBuffer, const VkBuffer& dstBuffer, VkDeviceSize size,
                         vk::CommandBuffer commandBuffer = {nullptr});
@@ -185,6 +245,9 @@ namespace Prism::Rendering::Vulkan
         void createCommandBuffers();
         void createSyncObjects();
         void createCommandBuffer(const vk::CommandBuffer& commandBuffer, uint32_t currentImage);
+        void recordScenePass(const vk::CommandBuffer& commandBuffer);
+        void recordDebugLinePass(const vk::CommandBuffer& commandBuffer);
+        void recordImGuiPass(const vk::CommandBuffer& commandBuffer);
         void updateCommandBuffer(uint32_t currentImage, uint32_t imageIndex);
         void updateUniformBuffer(uint32_t currentImage);
         void createDescriptorPool();
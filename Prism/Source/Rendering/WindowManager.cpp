@@ -4,6 +4,12 @@ void Prism::Rendering::WindowManager::initialize()
 {
 }
 
+void Prism::Rendering::WindowManager::declareDependencies(Utility::ServiceDependencies& dependencies)
+{
+    // GLFW may only be used from the thread that initialized it
+    dependencies.requireMainThread();
+}
+
 void Prism::Rendering::WindowManager::initializeDeferred()
 {
 }
@@ -22,6 +22,7 @@ namespace Prism::Rendering
         void initialize() override;
         void initializeDeferred() override;
         void deInitialize() override;
+        void declareDependencies(Utility::ServiceDependencies& dependencies) override;
 
         std::string getFullName() override
         {
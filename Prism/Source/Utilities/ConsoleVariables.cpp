@@ -0,0 +1,265 @@
+﻿#include "ConsoleVariables.hpp"
+
+#include <charconv>
+#include <fstream>
+
+#include "Logging/Log.hpp"
+
+namespace
+{
+    [[nodiscard]] std::string_view trim(std::string_view text)
+    {
+        constexpr std::string_view whitespace = " \t\r\n";
+        const auto first = text.find_first_not_of(whitespace);
+        if (first == std::string_view::npos)
+        {
+            return {};
+        }
+        const auto last = text.find_last_not_of(whitespace);
+        return text.substr(first, last - first + 1);
+    }
+
+    template <typename T>
+    bool parseNumber(const std::string_view text, T& value)
+    {
+        T parsedValue{};
+        const char* end = text.data() + text.size();
+        const auto [pointer, errorCode] = std::from_chars(text.data(), end, parsedValue);
+        if (errorCode != std::errc() || pointer != end)
+        {
+            return false;
+        }
+        value = parsedValue;
+        return true;
+    }
+
+    // Splits "name value" or "name=value", the value is empty if there is none
+    [[nodiscard]] std::pair<std::string_view, std::string_view> splitAssignment(std::string_view text)
+    {
+        text = trim(text);
+        auto separator = text.find('=');
+        if (separator == std::string_view::npos)
+        {
+            separator = text.find_first_of(" \t");
+        }
+        if (separator == std::string_view::npos)
+        {
+            return {text, {}};
+        }
+        return {trim(text.substr(0, separator)), trim(text.substr(separator + 1))};
+    }
+}
+
+bool Prism::Utility::parseConsoleVariableValue(const std::string_view text, bool& value)
+{
+    const auto trimmedText = trim(text);
+    for (const std::string_view trueText : {"1", "true", "on", "yes"})
+    {
+        if (trimmedText == trueText)
+        {
+            value = true;
+            return true;
+        }
+    }
+    for (const std::string_view falseText : {"0", "false", "off", "no"})
+    {
+        if (trimmedText == falseText)
+        {
+            value = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Prism::Utility::parseConsoleVariableValue(const std::string_view text, int32_t& value)
+{
+    return parseNumber(trim(text), value);
+}
+
+bool Prism::Utility::parseConsoleVariableValue(const std::string_view text, uint32_t& value)
+{
+    return parseNumber(trim(text), value);
+}
+
+bool Prism::Utility::parseConsoleVariableValue(const std::string_view text, float& value)
+{
+    return parseNumber(trim(text), value);
+}
+
+std::string Prism::Utility::formatConsoleVariableValue(const bool value)
+{
+    return value ? "true" : "false";
+}
+
+std::string Prism::Utility::formatConsoleVariableValue(const int32_t value)
+{
+    return std::to_string(value);
+}
+
+std::string Prism::Utility::formatConsoleVariableValue(const uint32_t value)
+{
+    return std::to_string(value);
+}
+
+std::string Prism::Utility::formatConsoleVariableValue(const float value)
+{
+    // Shortest text that parses back to the exact same float
+    char buffer[32];
+    const auto [pointer, errorCode] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return {buffer, pointer};
+}
+
+Prism::Utility::ConsoleVariableRegistry& Prism::Utility::ConsoleVariableRegistry::registryInstance()
+{
+    static ConsoleVariableRegistry instance;
+    return instance;
+}
+
+void Prism::Utility::ConsoleVariableRegistry::registerVariable(IConsoleVariable& variable)
+{
+    const std::string_view name = variable.getName();
+    const auto it = std::ranges::lower_bound(variables, name, {}, [](const IConsoleVariable* other)
+    {
+        return std::string_view(other->getName());
+    });
+    if (it != variables.end() && name == (*it)->getName())
+    {
+        throw std::runtime_error("ConsoleVariableRegistry: console variable '" + std::string(name) +
+            "' is defined more than once");
+    }
+    variables.insert(it, &variable);
+
+    if (const auto pendingIt = pendingValues.find(std::string(name)); pendingIt != pendingValues.end())
+    {
+        setVariableValue(variable, pendingIt->second);
+        pendingValues.erase(pendingIt);
+    }
+}
+
+Prism::Utility::IConsoleVariable* Prism::Utility::ConsoleVariableRegistry::findVariable(
+    const std::string_view name) const
+{
+    const auto it = std::ranges::lower_bound(variables, name, {}, [](const IConsoleVariable* other)
+    {
+        return std::string_view(other->getName());
+    });
+    return it != variables.end() && name == (*it)->getName() ? *it : nullptr;
+}
+
+void Prism::Utility::ConsoleVariableRegistry::setValue(const std::string_view name, const std::string_view value)
+{
+    if (const auto variable = findVariable(name))
+    {
+        setVariableValue(*variable, value);
+        return;
+    }
+    pendingValues.insert_or_assign(std::string(name), std::string(value));
+}
+
+bool Prism::Utility::ConsoleVariableRegistry::executeCommand(const std::string_view command)
+{
+    const auto [name, value] = splitAssignment(command);
+    if (name.empty())
+    {
+        return false;
+    }
+    const auto variable = findVariable(name);
+    if (!variable)
+    {
+        LOG_WARN("Unknown console variable '{}'", name);
+        return false;
+    }
+    if (value.empty())
+    {
+        LOG_INFO("{} = {} (default {}): {}", variable->getName(), variable->getValueAsString(),
+                 variable->getDefaultValueAsString(), variable->getDescription());
+        return true;
+    }
+    return setVariableValue(*variable, value);
+}
+
+void Prism::Utility::ConsoleVariableRegistry::loadConfigFile(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open())
+    {
+        LOG_DEBUG("No console variable file '{}', using defaults", fileName);
+        return;
+    }
+
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        std::string_view text = line;
+        if (const auto comment = text.find('#'); comment != std::string_view::npos)
+        {
+            text = text.substr(0, comment);
+        }
+        const auto [name, value] = splitAssignment(text);
+        if (name.empty())
+        {
+            continue;
+        }
+        if (value.empty())
+        {
+            LOG_WARN("{}:{}: console variable '{}' has no value", fileName, lineNumber, name);
+            continue;
+        }
+        setValue(name, value);
+    }
+    LOG_INFO("Loaded console variables from '{}'", fileName);
+}
+
+bool Prism::Utility::ConsoleVariableRegistry::saveConfigFile(const std::string& fileName) const
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Failed to open console variable file '{}' for writing", fileName);
+        return false;
+    }
+    for (const auto variable : variables)
+    {
+        if (!variable->isDefault())
+        {
+            file << "# " << variable->getDescription() << "\n";
+            file << variable->getName() << " = " << variable->getValueAsString() << "\n";
+        }
+    }
+    LOG_INFO("Saved console variables to '{}'", fileName);
+    return true;
+}
+
+void Prism::Utility::ConsoleVariableRegistry::applyCommandLineArgs(const std::vector<CommandLineArg>& commandLineArgs)
+{
+    for (const auto& [argName, rawValue] : commandLineArgs)
+    {
+        if (argName != commandLineArgName)
+        {
+            continue;
+        }
+        const auto separator = rawValue.find('=');
+        if (separator == std::string::npos)
+        {
+            LOG_WARN("Ignoring --{} {}, expected name=value", commandLineArgName, rawValue);
+            continue;
+        }
+        const std::string_view argValue = rawValue;
+        setValue(trim(argValue.substr(0, separator)), trim(argValue.substr(separator + 1)));
+    }
+}
+
+bool Prism::Utility::ConsoleVariableRegistry::setVariableValue(IConsoleVariable& variable,
+                                                                const std::string_view value)
+{
+    if (!variable.setValueFromString(value))
+    {
+        LOG_WARN("Invalid value '{}' for console variable '{}', keeping {}", value, variable.getName(),
+                 variable.getValueAsString());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,274 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "CommandLineArgsManager.hpp"
+
+namespace Prism::Utility
+{
+    enum class ConsoleVariableType
+    {
+        Bool,
+        Int32,
+        UInt32,
+        Float
+    };
+
+    enum class ConsoleVariableFlags : uint32_t
+    {
+        None = 0,
+        // Only read during startup, a changed value takes effect on the next run
+        RequiresRestart = 1 << 0
+    };
+
+    template <typename T>
+    concept ConsoleVariableValue = std::is_same_v<T, bool> || std::is_same_v<T, int32_t> ||
+        std::is_same_v<T, uint32_t> || std::is_same_v<T, float>;
+
+    // Without exceptions, returns false and leaves the output untouched if the text isn't a valid value
+    bool parseConsoleVariableValue(std::string_view text, bool& value);
+    bool parseConsoleVariableValue(std::string_view text, int32_t& value);
+    bool parseConsoleVariableValue(std::string_view text, uint32_t& value);
+    bool parseConsoleVariableValue(std::string_view text, float& value);
+    [[nodiscard]] std::string formatConsoleVariableValue(bool value);
+    [[nodiscard]] std::string formatConsoleVariableValue(int32_t value);
+    [[nodiscard]] std::string formatConsoleVariableValue(uint32_t value);
+    [[nodiscard]] std::string formatConsoleVariableValue(float value);
+
+    class IConsoleVariable
+    {
+    public:
+        IConsoleVariable(const IConsoleVariable& other) = delete;
+        IConsoleVariable(IConsoleVariable&& other) noexcept = delete;
+        IConsoleVariable& operator=(const IConsoleVariable& other) = delete;
+        IConsoleVariable& operator=(IConsoleVariable&& other) noexcept = delete;
+        virtual ~IConsoleVariable() = default;
+
+        [[nodiscard]] const char* getName() const
+        {
+            return name;
+        }
+
+        [[nodiscard]] const char* getDescription() const
+        {
+            return description;
+        }
+
+        [[nodiscard]] bool hasFlag(const ConsoleVariableFlags flag) const
+        {
+            return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(flag)) != 0;
+        }
+
+        [[nodiscard]] virtual ConsoleVariableType getType() const = 0;
+        [[nodiscard]] virtual std::string getValueAsString() const = 0;
+        [[nodiscard]] virtual std::string getDefaultValueAsString() const = 0;
+        [[nodiscard]] virtual bool isDefault() const = 0;
+        // Keeps the current value and returns false if the text can't be parsed
+        virtual bool setValueFromString(std::string_view text) = 0;
+        virtual void resetToDefault() = 0;
+
+    protected:
+        IConsoleVariable(const char* name, const char* description, const ConsoleVariableFlags flags)
+            : name(name), description(description), flags(flags)
+        {
+        }
+
+    private:
+        const char* name;
+        const char* description;
+        ConsoleVariableFlags flags;
+    };
+
+    /*
+     * Knows every console variable of the process. Values for variables that are not registered yet, e.g. because
+     * their translation unit is initialized later, are kept as text and applied once the variable shows up.
+     */
+    class ConsoleVariableRegistry
+    {
+    public:
+        inline constexpr static const char* defaultConfigFileName = "Prism.cfg";
+        // Command line option holding name=value pairs, may be given multiple times
+        inline constexpr static const char* commandLineArgName = "cvar";
+
+        ConsoleVariableRegistry(const ConsoleVariableRegistry& other) = delete;
+        ConsoleVariableRegistry(ConsoleVariableRegistry&& other) noexcept = delete;
+        ConsoleVariableRegistry& operator=(const ConsoleVariableRegistry& other) = delete;
+        ConsoleVariableRegistry& operator=(ConsoleVariableRegistry&& other) noexcept = delete;
+        ~ConsoleVariableRegistry() = default;
+
+        static ConsoleVariableRegistry& registryInstance();
+
+        void registerVariable(IConsoleVariable& variable);
+        [[nodiscard]] IConsoleVariable* findVariable(std::string_view name) const;
+
+        // Sorted by name
+        [[nodiscard]] const std::vector<IConsoleVariable*>& getVariables() const
+        {
+            return variables;
+        }
+
+        // Unknown names are kept until a variable with that name registers
+        void setValue(std::string_view name, std::string_view value);
+
+        // "name value" or "name=value" sets the variable, "name" alone logs its value and description
+        bool executeCommand(std::string_view command);
+
+        // One name = value per line, # starts a comment. A missing file is not an error.
+        void loadConfigFile(const std::string& fileName);
+        // Writes every variable that differs from its default
+        bool saveConfigFile(const std::string& fileName) const;
+
+        // Applied after the config file, so the command line always wins
+        void applyCommandLineArgs(const std::vector<CommandLineArg>& commandLineArgs);
+
+    private:
+        ConsoleVariableRegistry() = default;
+
+        std::vector<IConsoleVariable*> variables;
+        std::unordered_map<std::string, std::string> pendingValues;
+
+        static bool setVariableValue(IConsoleVariable& variable, std::string_view value);
+    };
+
+    /*
+     * Typed runtime setting, meant to be defined with static storage duration next to the code that reads it:
+     *     ConsoleVariable<uint32_t> cvarWorkerThreads("jobs.workerThreads", 0, "...");
+     * Reading is a single relaxed atomic load and safe from any thread, so hot code can query it every frame. Values
+     * from the config file and the command line are parsed once and applied when the variable registers itself.
+     * Setting and the change callbacks happen on the main thread.
+     */
+    template <ConsoleVariableValue T>
+    class ConsoleVariable final : public IConsoleVariable
+    {
+    public:
+        using ChangeCallback = std::function<void(T)>;
+
+        static_assert(std::atomic<T>::is_always_lock_free);
+
+        ConsoleVariable(const char* name, const T defaultValue, const char* description,
+                        const ConsoleVariableFlags flags = ConsoleVariableFlags::None,
+                        ChangeCallback changeCallback = {})
+            : ConsoleVariable(name, defaultValue, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(),
+                              description, flags, std::move(changeCallback))
+        {
+        }
+
+        // Values outside of [minValue, maxValue] are clamped
+        ConsoleVariable(const char* name, const T defaultValue, const T minValue, const T maxValue,
+                        const char* description, const ConsoleVariableFlags flags = ConsoleVariableFlags::None,
+                        ChangeCallback changeCallback = {})
+            : IConsoleVariable(name, description, flags), defaultValue(defaultValue), minValue(minValue),
+              maxValue(maxValue), value(std::clamp(defaultValue, minValue, maxValue))
+        {
+            if (changeCallback)
+            {
+                changeCallbacks.push_back(std::move(changeCallback));
+            }
+            ConsoleVariableRegistry::registryInstance().registerVariable(*this);
+        }
+
+        [[nodiscard]] T get() const
+        {
+            return value.load(std::memory_order_relaxed);
+        }
+
+        void set(T newValue)
+        {
+            newValue = std::clamp(newValue, minValue, maxValue);
+            if (value.exchange(newValue, std::memory_order_relaxed) == newValue)
+            {
+                return;
+            }
+            for (const auto& changeCallback : changeCallbacks)
+            {
+                changeCallback(newValue);
+            }
+        }
+
+        void addChangeCallback(ChangeCallback changeCallback)
+        {
+            changeCallbacks.push_back(std::move(changeCallback));
+        }
+
+        [[nodiscard]] T getDefaultValue() const
+        {
+            return defaultValue;
+        }
+
+        [[nodiscard]] T getMinValue() const
+        {
+            return minValue;
+        }
+
+        [[nodiscard]] T getMaxValue() const
+        {
+            return maxValue;
+        }
+
+        [[nodiscard]] ConsoleVariableType getType() const override
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return ConsoleVariableType::Bool;
+            }
+            else if constexpr (std::is_same_v<T, int32_t>)
+            {
+                return ConsoleVariableType::Int32;
+            }
+            else if constexpr (std::is_same_v<T, uint32_t>)
+            {
+                return ConsoleVariableType::UInt32;
+            }
+            else
+            {
+                return ConsoleVariableType::Float;
+            }
+        }
+
+        [[nodiscard]] std::string getValueAsString() const override
+        {
+            return formatConsoleVariableValue(get());
+        }
+
+        [[nodiscard]] std::string getDefaultValueAsString() const override
+        {
+            return formatConsoleVariableValue(defaultValue);
+        }
+
+        [[nodiscard]] bool isDefault() const override
+        {
+            return get() == std::clamp(defaultValue, minValue, maxValue);
+        }
+
+        bool setValueFromString(const std::string_view text) override
+        {
+            T parsedValue;
+            if (!parseConsoleVariableValue(text, parsedValue))
+            {
+                return false;
+            }
+            set(parsedValue);
+            return true;
+        }
+
+        void resetToDefault() override
+        {
+            set(defaultValue);
+        }
+
+    private:
+        const T defaultValue;
+        const T minValue;
+        const T maxValue;
+        std::atomic<T> value;
+        std::vector<ChangeCallback> changeCallbacks;
+    };
+}
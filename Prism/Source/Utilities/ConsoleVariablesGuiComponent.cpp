@@ -0,0 +1,128 @@
+﻿#include "ConsoleVariablesGuiComponent.hpp"
+
+#include <cstring>
+
+#include "../Rendering/Vulkan/ImGui/imgui.h"
+
+void Prism::Utility::ConsoleVariablesGuiComponent::renderUi()
+{
+    auto& registry = ConsoleVariableRegistry::registryInstance();
+    ImGui::Begin("Console Variables");
+    if (ImGui::InputTextWithHint("##Command", "name value", command.data(), command.size(),
+                                 ImGuiInputTextFlags_EnterReturnsTrue))
+    {
+        registry.executeCommand(command.data());
+        command[0] = '\0';
+        ImGui::SetKeyboardFocusHere(-1);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save"))
+    {
+        registry.saveConfigFile(ConsoleVariableRegistry::defaultConfigFileName);
+    }
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("Writes all changed variables to %s", ConsoleVariableRegistry::defaultConfigFileName);
+    }
+    ImGui::InputTextWithHint("##Filter", "Filter", filter.data(), filter.size());
+
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg |
+        ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("Table_ConsoleVariables", 3, flags))
+    {
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Value");
+        ImGui::TableSetupColumn("Default");
+        ImGui::TableHeadersRow();
+        for (const auto variable : registry.getVariables())
+        {
+            if (filter[0] != '\0' && !std::strstr(variable->getName(), filter.data()))
+            {
+                continue;
+            }
+            ImGui::PushID(variable->getName());
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(variable->getName());
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("%s%s", variable->getDescription(),
+                                  variable->hasFlag(ConsoleVariableFlags::RequiresRestart)
+                                      ? "\nTakes effect after a restart"
+                                      : "");
+            }
+            ImGui::TableNextColumn();
+            renderValueEditor(*variable);
+            ImGui::TableNextColumn();
+            if (variable->isDefault())
+            {
+                ImGui::TextDisabled("default");
+            }
+            else if (ImGui::SmallButton("Reset"))
+            {
+                variable->resetToDefault();
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void Prism::Utility::ConsoleVariablesGuiComponent::shutdown()
+{
+}
+
+void Prism::Utility::ConsoleVariablesGuiComponent::renderValueEditor(IConsoleVariable& variable)
+{
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    switch (variable.getType())
+    {
+    case ConsoleVariableType::Bool:
+        {
+            auto& boolVariable = static_cast<ConsoleVariable<bool>&>(variable);
+            bool value = boolVariable.get();
+            if (ImGui::Checkbox("##Value", &value))
+            {
+                boolVariable.set(value);
+            }
+            break;
+        }
+    case ConsoleVariableType::Int32:
+        {
+            auto& intVariable = static_cast<ConsoleVariable<int32_t>&>(variable);
+            int32_t value = intVariable.get();
+            const int32_t minValue = intVariable.getMinValue();
+            const int32_t maxValue = intVariable.getMaxValue();
+            if (ImGui::DragScalar("##Value", ImGuiDataType_S32, &value, 0.1f, &minValue, &maxValue))
+            {
+                intVariable.set(value);
+            }
+            break;
+        }
+    case ConsoleVariableType::UInt32:
+        {
+            auto& uintVariable = static_cast<ConsoleVariable<uint32_t>&>(variable);
+            uint32_t value = uintVariable.get();
+            const uint32_t minValue = uintVariable.getMinValue();
+            const uint32_t maxValue = uintVariable.getMaxValue();
+            if (ImGui::DragScalar("##Value", ImGuiDataType_U32, &value, 0.1f, &minValue, &maxValue))
+            {
+                uintVariable.set(value);
+            }
+            break;
+        }
+    case ConsoleVariableType::Float:
+        {
+            auto& floatVariable = static_cast<ConsoleVariable<float>&>(variable);
+            float value = floatVariable.get();
+            const float minValue = floatVariable.getMinValue();
+            const float maxValue = floatVariable.getMaxValue();
+            if (ImGui::DragScalar("##Value", ImGuiDataType_Float, &value, 0.01f, &minValue, &maxValue, "%.3f"))
+            {
+                floatVariable.set(value);
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <array>
+
+#include "ConsoleVariables.hpp"
+#include "../Rendering/Vulkan/ImGui/IImmediateModeGuiComponent.hpp"
+
+namespace Prism::Utility
+{
+    // Lists and edits all console variables, the command line accepts the same "name value" syntax as the config file
+    class ConsoleVariablesGuiComponent : public Rendering::IImmediateModeGuiComponent
+    {
+    public:
+        ConsoleVariablesGuiComponent() = default;
+        void renderUi() override;
+        void shutdown() override;
+
+    private:
+        std::array<char, 64> filter = {};
+        std::array<char, 256> command = {};
+
+        static void renderValueEditor(IConsoleVariable& variable);
+    };
+}
@@ -99,6 +99,11 @@ void Prism::Utility::EngineClock::stopRenderTimer()
     renderTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endRenderTime - startRenderTime);
 }
 
+void Prism::Utility::EngineClock::setRenderTime(const std::chrono::nanoseconds newRenderTime)
+{
+    renderTime = newRenderTime;
+}
+
 void Prism::Utility::EngineClock::updateFrameDelta()
 {
     ++frameCount;
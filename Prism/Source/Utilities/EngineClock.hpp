@@ -14,18 +14,7 @@ namespace Prism::Utility
         [[nodiscard]] uint64_t engineElapsedMicroseconds() const;
         [[nodiscard]] uint64_t engineElapsedNanoseconds() const;
 
-        /*[[nodiscard]] float physicsAverageSeconds() const;
-        [[nodiscard]] long double physicsAverageSecondsDouble() const;
-        [[nodiscard]] float updateAverageSeconds() const;
-        [[nodiscard]] long double updateAverageSecondsDouble() const;
-        [[nodiscard]] float renderAverageSeconds() const;
-        [[nodiscard]] long double renderAverageSecondsDouble() const;
-        [[nodiscard]] float physicsAverageMs() const;
-        [[nodiscard]] long double physicsAverageMsDouble() const;
-        [[nodiscard]] float updateAverageMs() const;
-        [[nodiscard]] long double updateAverageMsDouble() const;
-        [[nodiscard]] float renderAverageMs() const;
-        [[nodiscard]] long double renderAverageMsDouble() const;*/
+        // Averages and percentiles over many frames are provided by Utility::FrameStatistics
 
         void startPhysicsTimer();
         void stopPhysicsTimer();
@@ -33,6 +22,8 @@ namespace Prism::Utility
         void stopUpdateTimer();
         void startRenderTimer();
         void stopRenderTimer();
+        // For render times measured on another thread, e.g. by the RenderThread
+        void setRenderTime(std::chrono::nanoseconds newRenderTime);
 
         void updateFrameDelta();
         [[nodiscard]] float getFrameDelta() const;
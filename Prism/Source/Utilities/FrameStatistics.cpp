@@ -0,0 +1,132 @@
+﻿#include "FrameStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Logging/Log.hpp"
+
+size_t Prism::Utility::FrameHistogram::getBucketIndex(const float milliseconds)
+{
+    if (milliseconds <= firstBucketMilliseconds)
+    {
+        return 0;
+    }
+    const auto bucket = static_cast<size_t>(std::log2(milliseconds / firstBucketMilliseconds) *
+        static_cast<float>(bucketsPerOctave));
+    return std::min(bucket, bucketCount - 1);
+}
+
+float Prism::Utility::FrameHistogram::getBucketLowerBound(const size_t bucketIndex)
+{
+    return firstBucketMilliseconds * std::exp2(static_cast<float>(bucketIndex) / static_cast<float>(bucketsPerOctave));
+}
+
+Prism::Utility::FrameStatistics::FrameStatistics(const size_t windowSize) : windowSize(std::max<size_t>(windowSize, 1))
+{
+    samples.reserve(this->windowSize);
+}
+
+Prism::Utility::FrameStatistics::~FrameStatistics()
+{
+    stopCsvStream();
+}
+
+void Prism::Utility::FrameStatistics::addSample(const FrameSample& sample)
+{
+    if (samples.size() < windowSize)
+    {
+        samples.emplace_back(sample);
+    }
+    else
+    {
+        samples[nextSampleIndex] = sample;
+    }
+    nextSampleIndex = (nextSampleIndex + 1) % windowSize;
+
+    if (csvFile.is_open())
+    {
+        csvFile << totalFrameCount << ',' << sample.frameMilliseconds << ',' << sample.updateMilliseconds << ','
+            << sample.renderMilliseconds << ',' << sample.physicsMilliseconds << '\n';
+    }
+    ++totalFrameCount;
+}
+
+void Prism::Utility::FrameStatistics::setWindowSize(const size_t newWindowSize)
+{
+    windowSize = std::max<size_t>(newWindowSize, 1);
+    clear();
+    samples.reserve(windowSize);
+}
+
+void Prism::Utility::FrameStatistics::clear()
+{
+    samples.clear();
+    nextSampleIndex = 0;
+}
+
+Prism::Utility::FrameMetricSummary Prism::Utility::FrameStatistics::computeSummary(const FrameMetric metric) const
+{
+    FrameMetricSummary summary;
+    if (samples.empty())
+    {
+        return summary;
+    }
+
+    sortScratch.clear();
+    double sum = 0.0;
+    for (const auto& sample : samples)
+    {
+        const float value = sample.get(metric);
+        sortScratch.emplace_back(value);
+        sum += value;
+    }
+    // Sorting a window of a few thousand floats once per report is cheaper than maintaining order per sample
+    std::ranges::sort(sortScratch);
+
+    // Nearest rank percentiles
+    const auto percentile = [this](const double fraction)
+    {
+        const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortScratch.size())));
+        return sortScratch[std::clamp<size_t>(rank, 1, sortScratch.size()) - 1];
+    };
+    summary.sampleCount = sortScratch.size();
+    summary.min = sortScratch.front();
+    summary.max = sortScratch.back();
+    summary.average = static_cast<float>(sum / static_cast<double>(sortScratch.size()));
+    summary.p50 = percentile(0.50);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+Prism::Utility::FrameHistogram Prism::Utility::FrameStatistics::buildHistogram(const FrameMetric metric) const
+{
+    FrameHistogram histogram;
+    for (const auto& sample : samples)
+    {
+        ++histogram.counts[FrameHistogram::getBucketIndex(sample.get(metric))];
+    }
+    return histogram;
+}
+
+bool Prism::Utility::FrameStatistics::startCsvStream(const std::string& fileName)
+{
+    stopCsvStream();
+    csvFile.open(fileName, std::ios::trunc);
+    if (!csvFile)
+    {
+        LOG_ERROR("Failed to open frame statistics CSV file {}", fileName);
+        return false;
+    }
+    csvFile << "frame,frame_ms,update_ms,render_ms,physics_ms\n";
+    LOG_INFO("Streaming frame statistics to {}", fileName);
+    return true;
+}
+
+void Prism::Utility::FrameStatistics::stopCsvStream()
+{
+    if (csvFile.is_open())
+    {
+        csvFile.close();
+    }
+}
@@ -0,0 +1,123 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Prism::Utility
+{
+    enum class FrameMetric : uint8_t
+    {
+        Frame,
+        Update,
+        Render,
+        Physics,
+        Count
+    };
+
+    struct FrameSample
+    {
+        float frameMilliseconds = 0.0f;
+        float updateMilliseconds = 0.0f;
+        float renderMilliseconds = 0.0f;
+        float physicsMilliseconds = 0.0f;
+
+        [[nodiscard]] float get(const FrameMetric metric) const
+        {
+            switch (metric)
+            {
+            case FrameMetric::Update:
+                return updateMilliseconds;
+            case FrameMetric::Render:
+                return renderMilliseconds;
+            case FrameMetric::Physics:
+                return physicsMilliseconds;
+            default:
+                return frameMilliseconds;
+            }
+        }
+    };
+
+    struct FrameMetricSummary
+    {
+        size_t sampleCount = 0;
+        float min = 0.0f;
+        float average = 0.0f;
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+    };
+
+    // Buckets grow exponentially so both sub-millisecond noise and long hitches get a useful resolution
+    struct FrameHistogram
+    {
+        inline constexpr static float firstBucketMilliseconds = 0.5f;
+        inline constexpr static uint32_t bucketsPerOctave = 4;
+        // Covers 0.5ms to 128ms, the first and last bucket also take everything below and above
+        inline constexpr static size_t bucketCount = 8 * bucketsPerOctave + 1;
+
+        std::array<uint32_t, bucketCount> counts = {};
+
+        [[nodiscard]] static size_t getBucketIndex(float milliseconds);
+        [[nodiscard]] static float getBucketLowerBound(size_t bucketIndex);
+    };
+
+    /*
+     * Rolling window of per frame timings. Summaries and histograms are computed on demand from the window,
+     * optionally every sample is also streamed to a CSV file to analyze stutter offline.
+     */
+    class FrameStatistics
+    {
+    public:
+        inline constexpr static size_t defaultWindowSize = 1000;
+
+        explicit FrameStatistics(size_t windowSize = defaultWindowSize);
+        FrameStatistics(const FrameStatistics& other) = delete;
+        FrameStatistics(FrameStatistics&& other) noexcept = delete;
+        FrameStatistics& operator=(const FrameStatistics& other) = delete;
+        FrameStatistics& operator=(FrameStatistics&& other) noexcept = delete;
+        ~FrameStatistics();
+
+        void addSample(const FrameSample& sample);
+        // Drops all samples
+        void setWindowSize(size_t newWindowSize);
+        void clear();
+
+        [[nodiscard]] FrameMetricSummary computeSummary(FrameMetric metric) const;
+        [[nodiscard]] FrameHistogram buildHistogram(FrameMetric metric) const;
+
+        bool startCsvStream(const std::string& fileName);
+        void stopCsvStream();
+
+        [[nodiscard]] bool isCsvStreaming() const
+        {
+            return csvFile.is_open();
+        }
+
+        [[nodiscard]] size_t getWindowSize() const
+        {
+            return windowSize;
+        }
+
+        [[nodiscard]] size_t getSampleCount() const
+        {
+            return samples.size();
+        }
+
+        [[nodiscard]] uint64_t getTotalFrameCount() const
+        {
+            return totalFrameCount;
+        }
+
+    private:
+        size_t windowSize;
+        // Ring buffer, nextSampleIndex points at the oldest sample once the window is full
+        std::vector<FrameSample> samples;
+        size_t nextSampleIndex = 0;
+        uint64_t totalFrameCount = 0;
+        std::ofstream csvFile;
+        mutable std::vector<float> sortScratch;
+    };
+}
@@ -0,0 +1,40 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Prism::Utility
+{
+    class Hash
+    {
+    public:
+        inline constexpr static uint64_t fnv1aOffsetBasis = 14695981039346656037ull;
+        inline constexpr static uint64_t fnv1aPrime = 1099511628211ull;
+
+        // 64 bit FNV-1a, pass a previous result as seed to hash data incrementally
+        [[nodiscard]] static uint64_t fnv1a64(const void* data, const size_t size,
+                                              const uint64_t seed = fnv1aOffsetBasis)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            uint64_t hash = seed;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= fnv1aPrime;
+            }
+            return hash;
+        }
+
+        [[nodiscard]] static constexpr uint64_t fnv1a64(const std::string_view str,
+                                                        const uint64_t seed = fnv1aOffsetBasis)
+        {
+            uint64_t hash = seed;
+            for (const char c : str)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= fnv1aPrime;
+            }
+            return hash;
+        }
+    };
+}
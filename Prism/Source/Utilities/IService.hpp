@@ -1,8 +1,53 @@
 ﻿#pragma once
 #include <string>
+#include <vector>
 
 namespace Prism::Utility
 {
+    // Identifies a service by the interface it is registered with, the address is unique per type
+    using ServiceTypeKey = const void*;
+
+    template <typename T>
+    inline constexpr char serviceTypeTag = 0;
+
+    template <typename T>
+    [[nodiscard]] constexpr ServiceTypeKey getServiceTypeKey()
+    {
+        return &serviceTypeTag<T>;
+    }
+
+    // Filled by IService::declareDependencies
+    class ServiceDependencies
+    {
+    public:
+        // Both initialize and initializeDeferred of this service run after the ones of I
+        template <typename I>
+        void add()
+        {
+            dependencies.push_back(getServiceTypeKey<I>());
+        }
+
+        // For services touching GLFW or other APIs bound to the thread that created the window
+        void requireMainThread()
+        {
+            mainThreadRequired = true;
+        }
+
+        [[nodiscard]] const std::vector<ServiceTypeKey>& getDependencies() const
+        {
+            return dependencies;
+        }
+
+        [[nodiscard]] bool isMainThreadRequired() const
+        {
+            return mainThreadRequired;
+        }
+
+    private:
+        std::vector<ServiceTypeKey> dependencies;
+        bool mainThreadRequired = false;
+    };
+
     class IService
     {
     public:
@@ -11,5 +56,10 @@ namespace Prism::Utility
         virtual void initializeDeferred() = 0;
         virtual void deInitialize() = 0;
         virtual std::string getFullName() = 0;
+
+        // Services without dependencies may be initialized concurrently on any thread
+        virtual void declareDependencies([[maybe_unused]] ServiceDependencies& dependencies)
+        {
+        }
     };
 }
@@ -0,0 +1,30 @@
+﻿#include "JobSystem.hpp"
+
+#include <algorithm>
+
+#include "ConsoleVariables.hpp"
+#include "Logging/Log.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<uint32_t> cvarWorkerThreads(
+        "jobs.workerThreads", 0, 0, 256, "Worker threads of the job system, 0 uses one less than the hardware threads",
+        Prism::Utility::ConsoleVariableFlags::RequiresRestart);
+}
+
+void Prism::Utility::JobSystem::initialize()
+{
+    // Leave one core to the main thread
+    auto workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    if (const uint32_t configuredWorkerCount = cvarWorkerThreads.get(); configuredWorkerCount != 0)
+    {
+        workerCount = configuredWorkerCount;
+    }
+    threadPool = std::make_unique<ThreadPool>(workerCount, "JobSystem");
+    LOG_DEBUG("Started job system with {} workers", workerCount);
+}
+
+void Prism::Utility::JobSystem::deInitialize()
+{
+    threadPool.reset();
+}
@@ -0,0 +1,52 @@
+﻿#pragma once
+#include <memory>
+
+#include "IService.hpp"
+#include "ThreadPool.hpp"
+
+namespace Prism::Utility
+{
+    // Engine wide worker pool for background work like asset loading
+    class JobSystem final : public IService
+    {
+    public:
+        ~JobSystem() override = default;
+
+        void initialize() override;
+
+        void initializeDeferred() override
+        {
+        }
+
+        void deInitialize() override;
+
+        std::string getFullName() override
+        {
+            return "Prism::Utility::JobSystem";
+        }
+
+        void enqueue(std::function<void()> job)
+        {
+            threadPool->enqueue(std::move(job));
+        }
+
+        template <typename F>
+        [[nodiscard]] auto submit(F&& function)
+        {
+            return threadPool->submit(std::forward<F>(function));
+        }
+
+        [[nodiscard]] uint32_t getWorkerCount() const
+        {
+            return threadPool ? threadPool->getWorkerCount() : 0;
+        }
+
+        [[nodiscard]] bool isWorkerThread() const
+        {
+            return threadPool && threadPool->isWorkerThread();
+        }
+
+    private:
+        std::unique_ptr<ThreadPool> threadPool;
+    };
+}
@@ -1,6 +1,26 @@
 ﻿#include "Log.hpp"
+#include "spdlog/async.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/sinks/basic_file_sink.h"
+#include "../ConsoleVariables.hpp"
+
+namespace
+{
+#ifdef Prism_DEBUG
+    constexpr auto defaultLogLevel = spdlog::level::trace;
+#else
+    constexpr auto defaultLogLevel = spdlog::level::warn;
+#endif
+
+    Prism::Utility::ConsoleVariable<int32_t> cvarLogLevel(
+        "log.level", defaultLogLevel, spdlog::level::trace, spdlog::level::off,
+        "Minimum level that is written, 0 trace to 6 off. Levels stripped at compile time stay off.",
+        Prism::Utility::ConsoleVariableFlags::None, [](const int32_t level)
+        {
+            Prism::Utility::Logging::Log::logInstance().coreLogger->set_level(
+                static_cast<spdlog::level::level_enum>(level));
+        });
+}
 
 namespace Prism::Utility::Logging
 {
@@ -14,17 +34,25 @@ namespace Prism::Utility::Logging
         const auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         const auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("Prism.log");
         spdlog::sinks_init_list sinks = {consoleSink, fileSink};
-        coreLogger = std::make_shared<spdlog::logger>("Prism", sinks);
+        // A single writer thread keeps the messages in order
+        threadPool = std::make_shared<spdlog::details::thread_pool>(queueCapacity, 1);
+        coreLogger = std::make_shared<spdlog::async_logger>("Prism", sinks, threadPool,
+                                                            spdlog::async_overflow_policy::overrun_oldest);
         coreLogger->flush_on(spdlog::level::err);
-#ifdef Prism_DEBUG
-        coreLogger->set_level(spdlog::level::trace);
-#else
-		coreLogger->set_level(spdlog::level::warn);
-#endif
+        // Not read from log.level, the first message may be logged before that variable is constructed
+        coreLogger->set_level(defaultLogLevel);
+    }
+
+    size_t Log::getDroppedMessageCount() const
+    {
+        return threadPool->overrun_counter();
     }
 
     void Log::shutdown()
     {
         coreLogger->flush();
+        // Joining the writer thread drains everything that is still queued. The logger stays, so late messages from
+        // other static destructors end up in spdlog's error handler instead of crashing.
+        threadPool.reset();
     }
 }
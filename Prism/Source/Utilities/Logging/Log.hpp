@@ -1,13 +1,27 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include "spdlog/spdlog.h"
 
+namespace spdlog::details
+{
+    class thread_pool;
+}
+
 namespace Prism::Utility::Logging
 {
+    /*
+     * Messages are formatted on the calling thread and queued, a background thread writes them to the console and
+     * Prism.log. A full queue drops the oldest messages instead of blocking the caller.
+     */
     class Log
     {
     public:
+        inline constexpr static size_t queueCapacity = 8192;
+
         std::shared_ptr<spdlog::logger> coreLogger;
 
         Log(const Log& other) = delete;
@@ -18,6 +32,9 @@ namespace Prism::Utility::Logging
 
         void initialize();
 
+        // Messages lost because the queue was full
+        [[nodiscard]] size_t getDroppedMessageCount() const;
+
         // instance generation and retrieval
         static Log& logInstance()
         {
@@ -31,17 +48,114 @@ namespace Prism::Utility::Logging
             initialize();
         }
 
+        // Owned instead of spdlog's global pool, which may already be gone when this singleton is destroyed
+        std::shared_ptr<spdlog::details::thread_pool> threadPool;
+
         void shutdown();
     };
+
+    // Lets through at most maxMessages per interval, the state is per call site when used via LOG_RATE_LIMITED
+    class LogRateLimiter
+    {
+    public:
+        explicit LogRateLimiter(const uint32_t maxMessages = 1,
+                                const std::chrono::milliseconds interval = std::chrono::seconds(1)) :
+            maxMessages(maxMessages), intervalTicks(std::chrono::duration_cast<Clock::duration>(interval).count())
+        {
+        }
+
+        // Returns whether the message may be logged, suppressed messages are counted
+        bool tryAcquire()
+        {
+            const auto now = Clock::now().time_since_epoch().count();
+            auto start = intervalStart.load(std::memory_order_relaxed);
+            if (now - start >= intervalTicks && intervalStart.compare_exchange_strong(start, now,
+                std::memory_order_relaxed))
+            {
+                messageCount.store(0, std::memory_order_relaxed);
+            }
+            if (messageCount.fetch_add(1, std::memory_order_relaxed) < maxMessages)
+            {
+                return true;
+            }
+            suppressedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Suppressed messages since the last call
+        uint64_t takeSuppressedCount()
+        {
+            return suppressedCount.exchange(0, std::memory_order_relaxed);
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        uint32_t maxMessages;
+        Clock::rep intervalTicks;
+        // Starts expired, so the first message always passes
+        std::atomic<Clock::rep> intervalStart = std::numeric_limits<Clock::rep>::min() / 2;
+        std::atomic<uint32_t> messageCount = 0;
+        std::atomic<uint64_t> suppressedCount = 0;
+    };
 }
 
-#if defined(LOG_CRITICAL) || defined(LOG_ERROR) || defined(LOG_WARN) || defined(LOG_INFO) || defined(LOG_DEBUG) || defined(LOG_TRACE)
+// Levels below Prism_LOG_ACTIVE_LEVEL are compiled out, their arguments are not evaluated. Uses the SPDLOG_LEVEL_* values.
+#ifndef Prism_LOG_ACTIVE_LEVEL
+#ifdef Prism_DEBUG
+#define Prism_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define Prism_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#if defined(LOG_CRITICAL) || defined(LOG_ERROR) || defined(LOG_WARN) || defined(LOG_INFO) || defined(LOG_DEBUG) || defined(LOG_TRACE) || defined(LOG_RATE_LIMITED)
     #error "Logging macros must not be previously defined!"
 #else
+#if Prism_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
 #define LOG_CRITICAL(...) Prism::Utility::Logging::Log::logInstance().coreLogger->critical(__VA_ARGS__)
+#else
+#define LOG_CRITICAL(...) ((void)0)
+#endif
+#if Prism_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
 #define LOG_ERROR(...) Prism::Utility::Logging::Log::logInstance().coreLogger->error(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+#if Prism_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
 #define LOG_WARN(...) Prism::Utility::Logging::Log::logInstance().coreLogger->warn(__VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+#if Prism_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
 #define LOG_INFO(...) Prism::Utility::Logging::Log::logInstance().coreLogger->info(__VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+#if Prism_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
 #define LOG_DEBUG(...) Prism::Utility::Logging::Log::logInstance().coreLogger->debug(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+#if Prism_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
 #define LOG_TRACE(...) Prism::Utility::Logging::Log::logInstance().coreLogger->trace(__VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+// For call sites that may fire every frame, e.g. LOG_RATE_LIMITED(LOG_WARN, "Missing {}", name). At most one message per
+// second passes, the next one that passes reports how many were suppressed in between.
+#define LOG_RATE_LIMITED(logMacro, ...) \
+    do \
+    { \
+        static Prism::Utility::Logging::LogRateLimiter logRateLimiter; \
+        if (logRateLimiter.tryAcquire()) \
+        { \
+            logMacro(__VA_ARGS__); \
+            if (const auto suppressedMessages = logRateLimiter.takeSuppressedCount(); suppressedMessages > 0) \
+            { \
+                logMacro("{} similar messages were suppressed", suppressedMessages); \
+            } \
+        } \
+    } \
+    while (false)
 #endif
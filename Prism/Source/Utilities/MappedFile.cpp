@@ -0,0 +1,100 @@
+﻿#include "MappedFile.hpp"
+#include "Logging/Log.hpp"
+
+#ifdef _WIN64
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Prism::Utility::MappedFile::~MappedFile()
+{
+#ifdef _WIN64
+    if (data)
+    {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle)
+    {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle && fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (data)
+    {
+        munmap(const_cast<std::byte*>(data), size);
+    }
+    if (fileDescriptor >= 0)
+    {
+        close(fileDescriptor);
+    }
+#endif
+}
+
+std::unique_ptr<Prism::Utility::MappedFile> Prism::Utility::MappedFile::open(const std::string& fileName)
+{
+    // Private constructor, therefore no make_unique
+    auto mappedFile = std::unique_ptr<MappedFile>(new MappedFile());
+    mappedFile->fileName = fileName;
+#ifdef _WIN64
+    mappedFile->fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (mappedFile->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("Failed to open file for mapping: {}, error code: {}", fileName, GetLastError());
+        return nullptr;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(mappedFile->fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        LOG_ERROR("Failed to query size of file or file is empty: {}", fileName);
+        return nullptr;
+    }
+    mappedFile->size = static_cast<size_t>(fileSize.QuadPart);
+    mappedFile->mappingHandle = CreateFileMappingA(mappedFile->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappedFile->mappingHandle)
+    {
+        LOG_ERROR("Failed to create file mapping: {}, error code: {}", fileName, GetLastError());
+        return nullptr;
+    }
+    mappedFile->data = static_cast<const std::byte*>(MapViewOfFile(mappedFile->mappingHandle, FILE_MAP_READ, 0, 0,
+                                                                   0));
+    if (!mappedFile->data)
+    {
+        LOG_ERROR("Failed to map view of file: {}, error code: {}", fileName, GetLastError());
+        return nullptr;
+    }
+#else
+    mappedFile->fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (mappedFile->fileDescriptor < 0)
+    {
+        LOG_ERROR("Failed to open file for mapping: {}, errno: {}", fileName, errno);
+        return nullptr;
+    }
+    struct stat fileStat = {};
+    if (fstat(mappedFile->fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        LOG_ERROR("Failed to query size of file or file is empty: {}", fileName);
+        return nullptr;
+    }
+    mappedFile->size = static_cast<size_t>(fileStat.st_size);
+    void* mapping = mmap(nullptr, mappedFile->size, PROT_READ, MAP_PRIVATE, mappedFile->fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        LOG_ERROR("Failed to map file: {}, errno: {}", fileName, errno);
+        return nullptr;
+    }
+    // The whole file is usually consumed right away by the uploader
+    madvise(mapping, mappedFile->size, MADV_WILLNEED);
+    mappedFile->data = static_cast<const std::byte*>(mapping);
+#endif
+    return mappedFile;
+}
@@ -0,0 +1,49 @@
+﻿#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Prism::Utility
+{
+    // Read-only memory mapping of a whole file. The mapping stays valid for the lifetime of the object.
+    class MappedFile
+    {
+    public:
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) noexcept = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile& operator=(MappedFile&& other) noexcept = delete;
+        ~MappedFile();
+
+        // Returns nullptr if the file could not be opened or mapped
+        [[nodiscard]] static std::unique_ptr<MappedFile> open(const std::string& fileName);
+
+        [[nodiscard]] const std::byte* getData() const
+        {
+            return data;
+        }
+
+        [[nodiscard]] size_t getSize() const
+        {
+            return size;
+        }
+
+        [[nodiscard]] std::string getFileName() const
+        {
+            return fileName;
+        }
+
+    private:
+        MappedFile() = default;
+
+        std::string fileName;
+        const std::byte* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN64
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fileDescriptor = -1;
+#endif
+    };
+}
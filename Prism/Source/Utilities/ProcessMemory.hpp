@@ -0,0 +1,14 @@
+﻿#pragma once
+#include <cstddef>
+
+namespace Prism::Utility
+{
+    class ProcessMemory
+    {
+    public:
+        // Resident set size (working set on Windows) of the process in bytes, 0 if it can't be queried
+        [[nodiscard]] static size_t getCurrentResidentBytes();
+        // Highest resident set size since the process started in bytes, 0 if it can't be queried
+        [[nodiscard]] static size_t getPeakResidentBytes();
+    };
+}
@@ -0,0 +1,364 @@
+﻿#include "AllocationTracker.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PRISM_ALLOCATION_DEBUG_BREAK() __debugbreak()
+#else
+#include <csignal>
+#define PRISM_ALLOCATION_DEBUG_BREAK() std::raise(SIGTRAP)
+#endif
+
+namespace
+{
+    thread_local uint32_t currentTag = Prism::Utility::Profiling::AllocationTracker::untaggedTag;
+    thread_local uint32_t allowAllocationsDepth = 0;
+    thread_local bool isFrameThread = false;
+    // Guards against reporting allocations made while reporting one
+    thread_local bool isReportingFailure = false;
+}
+
+Prism::Utility::Profiling::AllocationTracker& Prism::Utility::Profiling::AllocationTracker::allocationTrackerInstance()
+{
+    static constinit AllocationTracker instance;
+    return instance;
+}
+
+uint32_t Prism::Utility::Profiling::AllocationTracker::registerTag(const char* name)
+{
+    std::scoped_lock lock(tagsMutex);
+    const uint32_t count = tagCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (std::strcmp(tags[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+    if (count == maxTags)
+    {
+        // No logging here, the logger allocates and may itself be what's being tagged
+        std::fprintf(stderr, "AllocationTracker: tag limit of %u reached, counting '%s' as untagged\n", maxTags, name);
+        return untaggedTag;
+    }
+    tags[count].name = name;
+    tagCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+uint32_t Prism::Utility::Profiling::AllocationTracker::getCurrentTag()
+{
+    return currentTag;
+}
+
+uint32_t Prism::Utility::Profiling::AllocationTracker::exchangeCurrentTag(const uint32_t tag)
+{
+    return std::exchange(currentTag, tag);
+}
+
+void Prism::Utility::Profiling::AllocationTracker::beginFrame()
+{
+    isFrameThread = true;
+    const uint32_t count = tagCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        auto& counters = tags[i];
+        counters.lastFrameAllocationCount = counters.frameAllocationCount.exchange(0, std::memory_order_relaxed);
+        counters.lastFrameAllocatedBytes = counters.frameAllocatedBytes.exchange(0, std::memory_order_relaxed);
+    }
+
+    if (failOnSteadyStateAllocation.load(std::memory_order_relaxed) && !steadyState.load(std::memory_order_relaxed)
+        && ++framesSinceEnabled >= warmupFrames)
+    {
+        steadyState.store(true, std::memory_order_relaxed);
+    }
+}
+
+void Prism::Utility::Profiling::AllocationTracker::setFailOnSteadyStateAllocation(const bool enabled,
+    const uint32_t warmupFrames)
+{
+    this->warmupFrames = warmupFrames;
+    framesSinceEnabled = 0;
+    steadyState.store(false, std::memory_order_relaxed);
+    failOnSteadyStateAllocation.store(enabled, std::memory_order_relaxed);
+}
+
+void Prism::Utility::Profiling::AllocationTracker::pushAllowAllocations()
+{
+    ++allowAllocationsDepth;
+}
+
+void Prism::Utility::Profiling::AllocationTracker::popAllowAllocations()
+{
+    --allowAllocationsDepth;
+}
+
+uint32_t Prism::Utility::Profiling::AllocationTracker::getTagStatistics(
+    std::array<AllocationTagStatistics, maxTags>& statistics) const
+{
+    const uint32_t count = tagCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const auto& counters = tags[i];
+        auto& tagStatistics = statistics[i];
+        tagStatistics.name = counters.name;
+        tagStatistics.frameAllocationCount = counters.lastFrameAllocationCount;
+        tagStatistics.frameAllocatedBytes = counters.lastFrameAllocatedBytes;
+        tagStatistics.totalAllocationCount = counters.totalAllocationCount.load(std::memory_order_relaxed);
+        tagStatistics.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        tagStatistics.peakLiveBytes = counters.peakLiveBytes.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t Prism::Utility::Profiling::AllocationTracker::getLastFrameAllocationCount() const
+{
+    uint64_t allocationCount = 0;
+    const uint32_t count = tagCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        allocationCount += tags[i].lastFrameAllocationCount;
+    }
+    return allocationCount;
+}
+
+uint64_t Prism::Utility::Profiling::AllocationTracker::getLastFrameAllocatedBytes() const
+{
+    uint64_t allocatedBytes = 0;
+    const uint32_t count = tagCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        allocatedBytes += tags[i].lastFrameAllocatedBytes;
+    }
+    return allocatedBytes;
+}
+
+void Prism::Utility::Profiling::AllocationTracker::onAllocation(const uint32_t tag, const size_t size)
+{
+    auto& counters = tags[tag];
+    const auto bytes = static_cast<int64_t>(size);
+    counters.frameAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.frameAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    counters.totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    const int64_t liveBytes = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peakLiveBytes = counters.peakLiveBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakLiveBytes && !counters.peakLiveBytes.compare_exchange_weak(
+        peakLiveBytes, liveBytes, std::memory_order_relaxed))
+    {
+    }
+
+    if (isFrameThread && allowAllocationsDepth == 0 && steadyState.load(std::memory_order_relaxed))
+    {
+        failSteadyStateAllocation(tag, size);
+    }
+}
+
+void Prism::Utility::Profiling::AllocationTracker::onDeallocation(const uint32_t tag, const size_t size)
+{
+    tags[tag].liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+void Prism::Utility::Profiling::AllocationTracker::failSteadyStateAllocation(const uint32_t tag, const size_t size)
+{
+    if (isReportingFailure)
+    {
+        return;
+    }
+    isReportingFailure = true;
+    std::fprintf(stderr, "AllocationTracker: steady state allocation of %zu bytes in tag '%s'\n", size,
+                 tags[tag].name);
+    std::fflush(stderr);
+    // Continuing in the debugger reports the next allocation, the call stack is the interesting part
+    PRISM_ALLOCATION_DEBUG_BREAK();
+    isReportingFailure = false;
+}
+
+#if defined(Prism_ALLOCATION_TRACKING)
+namespace
+{
+    // Placed directly in front of every tracked block, 16 bytes keep the default new alignment
+    struct AllocationHeader
+    {
+        uint64_t size;
+        uint32_t tag;
+        // Distance from the start of the underlying allocation to the user pointer
+        uint32_t offset;
+    };
+
+    static_assert(sizeof(AllocationHeader) == 16);
+
+    void* alignedMalloc(const size_t size, const size_t alignment)
+    {
+#if defined(_MSC_VER)
+        return _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void alignedFree(void* pointer)
+    {
+#if defined(_MSC_VER)
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+    void* trackedAllocate(size_t size, const size_t alignment, const bool aligned) noexcept
+    {
+        size = std::max<size_t>(size, 1);
+        const size_t offset = std::max(alignment, sizeof(AllocationHeader));
+        void* rawPointer = aligned ? alignedMalloc(size + offset, alignment) : std::malloc(size + offset);
+        if (!rawPointer)
+        {
+            return nullptr;
+        }
+        auto* userPointer = static_cast<std::byte*>(rawPointer) + offset;
+        const uint32_t tag = currentTag;
+        auto* header = reinterpret_cast<AllocationHeader*>(userPointer) - 1;
+        header->size = size;
+        header->tag = tag;
+        header->offset = static_cast<uint32_t>(offset);
+        Prism::Utility::Profiling::AllocationTracker::allocationTrackerInstance().onAllocation(tag, size);
+        return userPointer;
+    }
+
+    void* trackedAllocateOrThrow(const size_t size, const size_t alignment, const bool aligned)
+    {
+        while (true)
+        {
+            if (void* pointer = trackedAllocate(size, alignment, aligned))
+            {
+                return pointer;
+            }
+            const auto newHandler = std::get_new_handler();
+            if (!newHandler)
+            {
+                throw std::bad_alloc();
+            }
+            newHandler();
+        }
+    }
+
+    void trackedFree(void* pointer, const bool aligned) noexcept
+    {
+        if (!pointer)
+        {
+            return;
+        }
+        const auto* header = static_cast<AllocationHeader*>(pointer) - 1;
+        Prism::Utility::Profiling::AllocationTracker::allocationTrackerInstance().onDeallocation(
+            header->tag, header->size);
+        void* rawPointer = static_cast<std::byte*>(pointer) - header->offset;
+        aligned ? alignedFree(rawPointer) : std::free(rawPointer);
+    }
+}
+
+void* operator new(const size_t size)
+{
+    return trackedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, false);
+}
+
+void* operator new[](const size_t size)
+{
+    return trackedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, false);
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, false);
+}
+
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, false);
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment)
+{
+    return trackedAllocateOrThrow(size, static_cast<size_t>(alignment), true);
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment)
+{
+    return trackedAllocateOrThrow(size, static_cast<size_t>(alignment), true);
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size, static_cast<size_t>(alignment), true);
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size, static_cast<size_t>(alignment), true);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    trackedFree(pointer, false);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    trackedFree(pointer, false);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    trackedFree(pointer, false);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    trackedFree(pointer, false);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    trackedFree(pointer, false);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    trackedFree(pointer, false);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    trackedFree(pointer, true);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    trackedFree(pointer, true);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept
+{
+    trackedFree(pointer, true);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept
+{
+    trackedFree(pointer, true);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    trackedFree(pointer, true);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    trackedFree(pointer, true);
+}
+#endif
@@ -0,0 +1,168 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Prism::Utility::Profiling
+{
+    struct AllocationTagStatistics
+    {
+        const char* name = nullptr;
+        // Of the last finished frame, across all threads
+        uint64_t frameAllocationCount = 0;
+        uint64_t frameAllocatedBytes = 0;
+        uint64_t totalAllocationCount = 0;
+        int64_t liveBytes = 0;
+        int64_t peakLiveBytes = 0;
+    };
+
+    /*
+     * Counts heap allocations made through operator new per subsystem tag. The global operator new and delete are
+     * replaced in AllocationTracker.cpp and every block carries a small header with its size and the tag that was
+     * active on the allocating thread, so frees are attributed to the tag that allocated them.
+     * Optionally any allocation on the frame thread after a warmup breaks into the debugger, to find the allocations
+     * that keep the frame loop from reaching zero.
+     * Use the PRISM_ALLOCATION_* macros, they compile to nothing unless Prism_ALLOCATION_TRACKING is defined.
+     */
+    class AllocationTracker
+    {
+    public:
+        inline constexpr static uint32_t maxTags = 32;
+        inline constexpr static uint32_t untaggedTag = 0;
+        // Lazily created caches and pools usually settle within the first couple of frames
+        inline constexpr static uint32_t defaultWarmupFrames = 120;
+
+        AllocationTracker(const AllocationTracker& other) = delete;
+        AllocationTracker(AllocationTracker&& other) noexcept = delete;
+        AllocationTracker& operator=(const AllocationTracker& other) = delete;
+        AllocationTracker& operator=(AllocationTracker&& other) noexcept = delete;
+        ~AllocationTracker() = default;
+
+        // Constant initialized, so it is usable from operator new before any static constructor ran
+        static AllocationTracker& allocationTrackerInstance();
+
+        // Returns the id of the tag with this name, registering it on first use. Names must outlive the tracker.
+        uint32_t registerTag(const char* name);
+
+        // Tag of the calling thread, exchange returns the previous one
+        [[nodiscard]] static uint32_t getCurrentTag();
+        static uint32_t exchangeCurrentTag(uint32_t tag);
+
+        // Frame marker, must be called from the main thread which is then the thread checked in steady state
+        void beginFrame();
+
+        void setFailOnSteadyStateAllocation(bool enabled, uint32_t warmupFrames = defaultWarmupFrames);
+
+        [[nodiscard]] bool isFailOnSteadyStateAllocation() const
+        {
+            return failOnSteadyStateAllocation.load(std::memory_order_relaxed);
+        }
+
+        // Allocations made while at least one allow scope is active on the thread never fail
+        static void pushAllowAllocations();
+        static void popAllowAllocations();
+
+        // Copies into a fixed size array so the GUI can display it without allocating itself
+        [[nodiscard]] uint32_t getTagStatistics(std::array<AllocationTagStatistics, maxTags>& statistics) const;
+        [[nodiscard]] uint64_t getLastFrameAllocationCount() const;
+        [[nodiscard]] uint64_t getLastFrameAllocatedBytes() const;
+
+        // Only called by the replaced operator new and delete
+        void onAllocation(uint32_t tag, size_t size);
+        void onDeallocation(uint32_t tag, size_t size);
+
+    private:
+        struct TagCounters
+        {
+            const char* name = nullptr;
+            std::atomic<uint64_t> frameAllocationCount = 0;
+            std::atomic<uint64_t> frameAllocatedBytes = 0;
+            std::atomic<uint64_t> totalAllocationCount = 0;
+            std::atomic<int64_t> liveBytes = 0;
+            std::atomic<int64_t> peakLiveBytes = 0;
+            // Only touched by the frame thread
+            uint64_t lastFrameAllocationCount = 0;
+            uint64_t lastFrameAllocatedBytes = 0;
+        };
+
+        constexpr AllocationTracker()
+        {
+            tags[untaggedTag].name = "Untagged";
+        }
+
+        mutable std::mutex tagsMutex;
+        std::array<TagCounters, maxTags> tags = {};
+        std::atomic<uint32_t> tagCount = 1;
+        std::atomic<bool> failOnSteadyStateAllocation = false;
+        std::atomic<bool> steadyState = false;
+        uint32_t warmupFrames = defaultWarmupFrames;
+        uint32_t framesSinceEnabled = 0;
+
+        void failSteadyStateAllocation(uint32_t tag, size_t size);
+    };
+
+    class AllocationTagScope
+    {
+    public:
+        explicit AllocationTagScope(const uint32_t tag) : previousTag(AllocationTracker::exchangeCurrentTag(tag))
+        {
+        }
+
+        AllocationTagScope(const AllocationTagScope& other) = delete;
+        AllocationTagScope(AllocationTagScope&& other) noexcept = delete;
+        AllocationTagScope& operator=(const AllocationTagScope& other) = delete;
+        AllocationTagScope& operator=(AllocationTagScope&& other) noexcept = delete;
+
+        ~AllocationTagScope()
+        {
+            AllocationTracker::exchangeCurrentTag(previousTag);
+        }
+
+    private:
+        uint32_t previousTag;
+    };
+
+    class AllowAllocationsScope
+    {
+    public:
+        AllowAllocationsScope()
+        {
+            AllocationTracker::pushAllowAllocations();
+        }
+
+        AllowAllocationsScope(const AllowAllocationsScope& other) = delete;
+        AllowAllocationsScope(AllowAllocationsScope&& other) noexcept = delete;
+        AllowAllocationsScope& operator=(const AllowAllocationsScope& other) = delete;
+        AllowAllocationsScope& operator=(AllowAllocationsScope&& other) noexcept = delete;
+
+        ~AllowAllocationsScope()
+        {
+            AllocationTracker::popAllowAllocations();
+        }
+    };
+}
+
+#if defined(PRISM_ALLOCATION_SCOPE) || defined(PRISM_ALLOCATION_FRAME) || defined(PRISM_ALLOCATION_ALLOW)
+    #error "Allocation tracking macros must not be previously defined!"
+#elif defined(Prism_ALLOCATION_TRACKING)
+#define PRISM_ALLOCATION_CONCAT_INNER(a, b) a##b
+#define PRISM_ALLOCATION_CONCAT(a, b) PRISM_ALLOCATION_CONCAT_INNER(a, b)
+// Tags are registered once per call site, names must be string literals
+#define PRISM_ALLOCATION_SCOPE(tag) const Prism::Utility::Profiling::AllocationTagScope \
+    PRISM_ALLOCATION_CONCAT(allocationScope, __LINE__)([] \
+    { \
+        static const uint32_t tagId = Prism::Utility::Profiling::AllocationTracker::allocationTrackerInstance(). \
+            registerTag(tag); \
+        return tagId; \
+    }())
+#define PRISM_ALLOCATION_FRAME() Prism::Utility::Profiling::AllocationTracker::allocationTrackerInstance().beginFrame()
+// Marks allocations that are expected in steady state, e.g. once per second statistics
+#define PRISM_ALLOCATION_ALLOW() const Prism::Utility::Profiling::AllowAllocationsScope \
+    PRISM_ALLOCATION_CONCAT(allowAllocationsScope, __LINE__)
+#else
+#define PRISM_ALLOCATION_SCOPE(tag) ((void)0)
+#define PRISM_ALLOCATION_FRAME() ((void)0)
+#define PRISM_ALLOCATION_ALLOW() ((void)0)
+#endif
@@ -0,0 +1,65 @@
+﻿#include "AllocationTrackerGuiComponent.hpp"
+
+#include "../../Rendering/Vulkan/ImGui/imgui.h"
+
+void Prism::Utility::Profiling::AllocationTrackerGuiComponent::renderUi()
+{
+    ImGui::Begin("Allocations");
+#ifndef Prism_ALLOCATION_TRACKING
+    ImGui::TextUnformatted(
+        "Allocation tracking is compiled out, generate the project with --allocation-tracking to enable it.");
+#else
+    auto& tracker = AllocationTracker::allocationTrackerInstance();
+    const uint64_t frameAllocationCount = tracker.getLastFrameAllocationCount();
+    allocationCountHistory[historyOffset] = static_cast<float>(frameAllocationCount);
+    historyOffset = (historyOffset + 1) % historyLength;
+
+    ImGui::Text("Last frame: %llu allocations, %.2f KiB", static_cast<unsigned long long>(frameAllocationCount),
+                static_cast<double>(tracker.getLastFrameAllocatedBytes()) / 1024.0);
+    bool failOnSteadyStateAllocation = tracker.isFailOnSteadyStateAllocation();
+    if (ImGui::Checkbox("Break on steady state allocation", &failOnSteadyStateAllocation))
+    {
+        tracker.setFailOnSteadyStateAllocation(failOnSteadyStateAllocation);
+    }
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("After %u warmup frames any allocation on the main thread outside of the debug GUI breaks "
+                          "into the debugger", AllocationTracker::defaultWarmupFrames);
+    }
+    ImGui::PlotLines("Allocations/Frame", allocationCountHistory.data(), static_cast<int>(historyLength),
+                     static_cast<int>(historyOffset), nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+
+    const uint32_t tagCount = tracker.getTagStatistics(tagStatistics);
+    if (ImGui::BeginTable("Table_Allocations", 6, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg))
+    {
+        for (const char* header : {"Tag", "Allocs/Frame", "KiB/Frame", "Live KiB", "Peak KiB", "Total Allocs"})
+        {
+            ImGui::TableSetupColumn(header);
+        }
+        ImGui::TableHeadersRow();
+        for (uint32_t i = 0; i < tagCount; ++i)
+        {
+            const auto& statistics = tagStatistics[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(statistics.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(statistics.frameAllocationCount));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(statistics.frameAllocatedBytes) / 1024.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(statistics.liveBytes) / 1024.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(statistics.peakLiveBytes) / 1024.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(statistics.totalAllocationCount));
+        }
+        ImGui::EndTable();
+    }
+#endif
+    ImGui::End();
+}
+
+void Prism::Utility::Profiling::AllocationTrackerGuiComponent::shutdown()
+{
+}
@@ -0,0 +1,25 @@
+﻿#pragma once
+#include <array>
+
+#include "AllocationTracker.hpp"
+#include "../../Rendering/Vulkan/ImGui/IImmediateModeGuiComponent.hpp"
+
+namespace Prism::Utility::Profiling
+{
+    // Heap allocations of the last frame and live bytes per subsystem tag, plus the steady state allocation check
+    class AllocationTrackerGuiComponent : public Rendering::IImmediateModeGuiComponent
+    {
+    public:
+        inline constexpr static size_t historyLength = 240;
+
+        AllocationTrackerGuiComponent() = default;
+        void renderUi() override;
+        void shutdown() override;
+
+    private:
+        std::array<AllocationTagStatistics, AllocationTracker::maxTags> tagStatistics = {};
+        // Allocations per frame, ring buffer so the panel doesn't allocate itself
+        std::array<float, historyLength> allocationCountHistory = {};
+        size_t historyOffset = 0;
+    };
+}
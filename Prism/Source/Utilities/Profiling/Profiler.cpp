@@ -0,0 +1,212 @@
+﻿#include "Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "../Logging/Log.hpp"
+
+Prism::Utility::Profiling::Profiler::Profiler()
+{
+    // Calibrate the TSC against the steady clock, assumes an invariant TSC which every x64 CPU of the last decade has
+    const auto calibrationStartTime = std::chrono::steady_clock::now();
+    const uint64_t calibrationStartTicks = readTimestamp();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const uint64_t calibrationEndTicks = readTimestamp();
+    const auto calibrationEndTime = std::chrono::steady_clock::now();
+    const double elapsedMilliseconds = std::chrono::duration<double, std::milli>(
+        calibrationEndTime - calibrationStartTime).count();
+    if (elapsedMilliseconds > 0.0 && calibrationEndTicks > calibrationStartTicks)
+    {
+        ticksPerMillisecond = static_cast<double>(calibrationEndTicks - calibrationStartTicks) / elapsedMilliseconds;
+    }
+    frameBeginTicks = readTimestamp();
+}
+
+Prism::Utility::Profiling::ThreadProfileBuffer& Prism::Utility::Profiling::Profiler::getThreadBuffer()
+{
+    // Pool threads come and go, so the buffer has to be handed back when its thread exits
+    struct ThreadRegistration
+    {
+        ThreadProfileBuffer& buffer = profilerInstance().registerThread();
+
+        ~ThreadRegistration()
+        {
+            profilerInstance().unregisterThread(buffer);
+        }
+    };
+
+    thread_local ThreadRegistration registration;
+    return registration.buffer;
+}
+
+Prism::Utility::Profiling::ThreadProfileBuffer& Prism::Utility::Profiling::Profiler::registerThread()
+{
+    std::scoped_lock lock(threadsMutex);
+    const auto threadId = nextThreadId++;
+    threads.push_back({std::make_unique<ThreadProfileBuffer>(threadId), "Thread " + std::to_string(threadId)});
+    return *threads.back().buffer;
+}
+
+void Prism::Utility::Profiling::Profiler::unregisterThread(const ThreadProfileBuffer& threadBuffer)
+{
+    std::scoped_lock lock(threadsMutex);
+    const auto thread = std::ranges::find(threads, &threadBuffer, [](const RegisteredThread& registeredThread)
+    {
+        return registeredThread.buffer.get();
+    });
+    if (thread != threads.end())
+    {
+        thread->exited = true;
+    }
+}
+
+void Prism::Utility::Profiling::Profiler::setThreadName(const std::string& threadName)
+{
+    const auto& threadBuffer = getThreadBuffer();
+    std::scoped_lock lock(threadsMutex);
+    const auto thread = std::ranges::find(threads, &threadBuffer, [](const RegisteredThread& registeredThread)
+    {
+        return registeredThread.buffer.get();
+    });
+    if (thread != threads.end())
+    {
+        thread->name = threadName;
+    }
+}
+
+void Prism::Utility::Profiling::Profiler::beginFrame()
+{
+    const uint64_t now = readTimestamp();
+    ProfileFrame frame;
+    frame.frameIndex = frameIndex++;
+    frame.beginTicks = frameBeginTicks;
+    frame.endTicks = now;
+    {
+        std::scoped_lock lock(threadsMutex);
+        // Reuse the allocations of the previous frame when possible
+        frame.threads = std::move(lastFrame.threads);
+        frame.threads.resize(threads.size());
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            auto& threadFrame = frame.threads[i];
+            threadFrame.threadId = threads[i].buffer->getThreadId();
+            threadFrame.threadName = threads[i].name;
+            threadFrame.events.clear();
+            threads[i].buffer->drain(threadFrame.events);
+        }
+        // Exited threads can't push anymore and their last events are in this frame
+        std::erase_if(threads, [](const RegisteredThread& thread)
+        {
+            return thread.exited;
+        });
+    }
+    frameBeginTicks = now;
+
+    if (capturing)
+    {
+        capturedFrames.emplace_back(frame);
+        if (capturedFrames.size() >= maxCapturedFrames)
+        {
+            LOG_WARN("Profiler capture reached its limit of {} frames, stopping", maxCapturedFrames);
+            capturing = false;
+        }
+    }
+    lastFrame = std::move(frame);
+}
+
+void Prism::Utility::Profiling::Profiler::startCapture()
+{
+    capturedFrames.clear();
+    capturing = true;
+}
+
+void Prism::Utility::Profiling::Profiler::stopCapture()
+{
+    capturing = false;
+}
+
+bool Prism::Utility::Profiling::Profiler::exportChromeTrace(const std::string& fileName) const
+{
+    if (capturedFrames.empty())
+    {
+        LOG_WARN("No captured profiler frames to export");
+        return false;
+    }
+
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open profiler trace file {}", fileName);
+        return false;
+    }
+
+    // Timestamps are in microseconds, relative to the start of the capture
+    const uint64_t originTicks = capturedFrames.front().beginTicks;
+    const auto toMicroseconds = [&](const uint64_t ticks)
+    {
+        return ticksToMilliseconds(ticks) * 1000.0;
+    };
+
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    const auto separator = [&]() -> std::ofstream&
+    {
+        if (!first)
+        {
+            file << ",\n";
+        }
+        first = false;
+        return file;
+    };
+
+    // Threads can start or exit during the capture, so every frame contributes names, the latest one per thread id wins
+    std::map<uint32_t, const std::string*> threadNames;
+    for (const auto& frame : capturedFrames)
+    {
+        for (const auto& threadFrame : frame.threads)
+        {
+            threadNames[threadFrame.threadId] = &threadFrame.threadName;
+        }
+    }
+    for (const auto& [threadId, threadName] : threadNames)
+    {
+        separator() << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << threadId
+            << R"(,"args":{"name":")" << *threadName << "\"}}";
+    }
+    for (const auto& frame : capturedFrames)
+    {
+        separator() << R"({"name":"Frame )" << frame.frameIndex << R"(","ph":"i","s":"g","pid":1,"tid":0,"ts":)"
+            << toMicroseconds(frame.beginTicks - originTicks) << "}";
+        for (const auto& threadFrame : frame.threads)
+        {
+            for (const auto& event : threadFrame.events)
+            {
+                // Scopes that started before the capture are clamped to its start
+                const uint64_t beginTicks = std::max(event.beginTicks, originTicks);
+                separator() << R"({"name":")" << event.name << R"(","ph":"X","pid":1,"tid":)" << threadFrame.
+                    threadId << R"(,"ts":)" << toMicroseconds(beginTicks - originTicks) << R"(,"dur":)"
+                    << toMicroseconds(event.endTicks - std::min(beginTicks, event.endTicks)) << "}";
+            }
+        }
+    }
+    file << "\n]}\n";
+
+    LOG_INFO("Exported {} profiler frames to {}", capturedFrames.size(), fileName);
+    return true;
+}
+
+uint64_t Prism::Utility::Profiling::Profiler::getDroppedEventCount() const
+{
+    std::scoped_lock lock(threadsMutex);
+    uint64_t droppedEventCount = 0;
+    for (const auto& thread : threads)
+    {
+        droppedEventCount += thread.buffer->getDroppedEventCount();
+    }
+    return droppedEventCount;
+}
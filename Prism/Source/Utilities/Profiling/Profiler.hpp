@@ -0,0 +1,232 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace Prism::Utility::Profiling
+{
+    // Names must outlive the profiler, string literals or __func__ are expected
+    struct ProfileEvent
+    {
+        const char* name;
+        uint64_t beginTicks;
+        uint64_t endTicks;
+        uint32_t depth;
+    };
+
+    struct ProfileThreadFrame
+    {
+        uint32_t threadId = 0;
+        std::string threadName;
+        std::vector<ProfileEvent> events;
+    };
+
+    struct ProfileFrame
+    {
+        uint64_t frameIndex = 0;
+        uint64_t beginTicks = 0;
+        uint64_t endTicks = 0;
+        std::vector<ProfileThreadFrame> threads;
+    };
+
+    // Single producer (the owning thread), single consumer (the frame marker on the main thread)
+    class ThreadProfileBuffer
+    {
+    public:
+        inline constexpr static size_t capacity = 1 << 14;
+
+        explicit ThreadProfileBuffer(const uint32_t threadId) : threadId(threadId)
+        {
+        }
+
+        void push(const ProfileEvent& event)
+        {
+            const uint64_t write = writeIndex.load(std::memory_order_relaxed);
+            if (write - readIndex.load(std::memory_order_acquire) >= capacity)
+            {
+                droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            events[write & (capacity - 1)] = event;
+            writeIndex.store(write + 1, std::memory_order_release);
+        }
+
+        void drain(std::vector<ProfileEvent>& destination)
+        {
+            const uint64_t read = readIndex.load(std::memory_order_relaxed);
+            const uint64_t write = writeIndex.load(std::memory_order_acquire);
+            for (uint64_t i = read; i < write; ++i)
+            {
+                destination.emplace_back(events[i & (capacity - 1)]);
+            }
+            readIndex.store(write, std::memory_order_release);
+        }
+
+        [[nodiscard]] uint32_t getThreadId() const
+        {
+            return threadId;
+        }
+
+        [[nodiscard]] uint64_t getDroppedEventCount() const
+        {
+            return droppedEventCount.load(std::memory_order_relaxed);
+        }
+
+        // Only touched by the owning thread
+        uint32_t depth = 0;
+
+    private:
+        uint32_t threadId;
+        std::array<ProfileEvent, capacity> events = {};
+        alignas(64) std::atomic<uint64_t> writeIndex = 0;
+        alignas(64) std::atomic<uint64_t> readIndex = 0;
+        std::atomic<uint64_t> droppedEventCount = 0;
+    };
+
+    /*
+     * Collects scoped CPU timings of all threads. Scopes are written into lock-free per thread ring buffers using the
+     * TSC, beginFrame() drains them on the main thread and keeps the last finished frame for display. While capturing,
+     * finished frames are kept as well and can be exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+     * Use the PRISM_PROFILE_* macros, they compile to nothing unless Prism_PROFILING is defined.
+     */
+    class Profiler
+    {
+    public:
+        inline constexpr static size_t maxCapturedFrames = 1000;
+
+        Profiler(const Profiler& other) = delete;
+        Profiler(Profiler&& other) noexcept = delete;
+        Profiler& operator=(const Profiler& other) = delete;
+        Profiler& operator=(Profiler&& other) noexcept = delete;
+        ~Profiler() = default;
+
+        static Profiler& profilerInstance()
+        {
+            static Profiler instance;
+            return instance;
+        }
+
+        [[nodiscard]] static uint64_t readTimestamp()
+        {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        // Buffer of the calling thread, registered on first use and unregistered when the thread exits
+        [[nodiscard]] static ThreadProfileBuffer& getThreadBuffer();
+
+        void setThreadName(const std::string& threadName);
+        // Frame marker, must be called from the main thread
+        void beginFrame();
+
+        void startCapture();
+        void stopCapture();
+        [[nodiscard]] bool exportChromeTrace(const std::string& fileName) const;
+
+        [[nodiscard]] bool isCapturing() const
+        {
+            return capturing;
+        }
+
+        [[nodiscard]] size_t getCapturedFrameCount() const
+        {
+            return capturedFrames.size();
+        }
+
+        [[nodiscard]] const ProfileFrame& getLastFrame() const
+        {
+            return lastFrame;
+        }
+
+        [[nodiscard]] double ticksToMilliseconds(const uint64_t ticks) const
+        {
+            return static_cast<double>(ticks) / ticksPerMillisecond;
+        }
+
+        [[nodiscard]] uint64_t getDroppedEventCount() const;
+
+    private:
+        Profiler();
+
+        struct RegisteredThread
+        {
+            std::unique_ptr<ThreadProfileBuffer> buffer;
+            std::string name;
+            // Set when the thread exited, the buffer is drained one last time by the next beginFrame()
+            bool exited = false;
+        };
+
+        ThreadProfileBuffer& registerThread();
+        void unregisterThread(const ThreadProfileBuffer& threadBuffer);
+
+        double ticksPerMillisecond = 1.0;
+        uint64_t frameIndex = 0;
+        uint64_t frameBeginTicks = 0;
+        bool capturing = false;
+
+        mutable std::mutex threadsMutex;
+        std::vector<RegisteredThread> threads;
+        uint32_t nextThreadId = 0;
+
+        ProfileFrame lastFrame;
+        std::vector<ProfileFrame> capturedFrames;
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name) : buffer(Profiler::getThreadBuffer()), name(name),
+                                                  depth(buffer.depth++), beginTicks(Profiler::readTimestamp())
+        {
+        }
+
+        ProfileScope(const ProfileScope& other) = delete;
+        ProfileScope(ProfileScope&& other) noexcept = delete;
+        ProfileScope& operator=(const ProfileScope& other) = delete;
+        ProfileScope& operator=(ProfileScope&& other) noexcept = delete;
+
+        ~ProfileScope()
+        {
+            const uint64_t endTicks = Profiler::readTimestamp();
+            --buffer.depth;
+            buffer.push({name, beginTicks, endTicks, depth});
+        }
+
+    private:
+        ThreadProfileBuffer& buffer;
+        const char* name;
+        uint32_t depth;
+        uint64_t beginTicks;
+    };
+}
+
+#if defined(PRISM_PROFILE_SCOPE) || defined(PRISM_PROFILE_FUNCTION) || defined(PRISM_PROFILE_FRAME) || defined(PRISM_PROFILE_THREAD)
+    #error "Profiling macros must not be previously defined!"
+#elif defined(Prism_PROFILING)
+#define PRISM_PROFILE_CONCAT_INNER(a, b) a##b
+#define PRISM_PROFILE_CONCAT(a, b) PRISM_PROFILE_CONCAT_INNER(a, b)
+#define PRISM_PROFILE_SCOPE(name) const Prism::Utility::Profiling::ProfileScope PRISM_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PRISM_PROFILE_FUNCTION() PRISM_PROFILE_SCOPE(__func__)
+#define PRISM_PROFILE_FRAME() Prism::Utility::Profiling::Profiler::profilerInstance().beginFrame()
+#define PRISM_PROFILE_THREAD(name) Prism::Utility::Profiling::Profiler::profilerInstance().setThreadName(name)
+#else
+#define PRISM_PROFILE_SCOPE(name) ((void)0)
+#define PRISM_PROFILE_FUNCTION() ((void)0)
+#define PRISM_PROFILE_FRAME() ((void)0)
+#define PRISM_PROFILE_THREAD(name) ((void)0)
+#endif
@@ -0,0 +1,159 @@
+﻿#include "ProfilerGuiComponent.hpp"
+
+#include <algorithm>
+
+#include "../Hash.hpp"
+#include "../ServiceLocator.hpp"
+#include "../../Rendering/IRendererManager.hpp"
+#include "../../Core/ITimeManager.hpp"
+#include "../../Rendering/Vulkan/ImGui/imgui.h"
+
+void Prism::Utility::Profiling::ProfilerGuiComponent::renderUi()
+{
+    ImGui::Begin("Profiler");
+    // GPU timestamps are independent of the CPU instrumentation
+    const auto renderer = ServiceLocator::getService<Rendering::IRendererManager>()->getRenderer();
+    for (const auto& [passName, passMilliseconds] : renderer->getGpuPassTimings())
+    {
+        ImGui::Text("GPU %s: %.3f ms", passName, passMilliseconds);
+        ImGui::SameLine();
+    }
+    ImGui::NewLine();
+    renderFrameStatistics();
+    ImGui::Separator();
+#ifndef Prism_PROFILING
+    ImGui::TextUnformatted("Profiling is compiled out, generate the project with --profiling to enable it.");
+#else
+    auto& profiler = Profiler::profilerInstance();
+    ImGui::Checkbox("Pause", &paused);
+    if (!paused)
+    {
+        displayedFrame = profiler.getLastFrame();
+    }
+
+    ImGui::SameLine();
+    if (profiler.isCapturing())
+    {
+        if (ImGui::Button("Stop Capture"))
+        {
+            profiler.stopCapture();
+        }
+    }
+    else if (ImGui::Button("Start Capture"))
+    {
+        profiler.startCapture();
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(profiler.isCapturing() || profiler.getCapturedFrameCount() == 0);
+    if (ImGui::Button("Export Chrome Trace"))
+    {
+        [[maybe_unused]] const bool exported = profiler.exportChromeTrace(traceFileName);
+    }
+    ImGui::EndDisabled();
+
+    ImGui::Text("Frame %llu: %.3f ms | Captured frames: %zu | Dropped events: %llu",
+                static_cast<unsigned long long>(displayedFrame.frameIndex),
+                profiler.ticksToMilliseconds(displayedFrame.endTicks - displayedFrame.beginTicks),
+                profiler.getCapturedFrameCount(), static_cast<unsigned long long>(profiler.getDroppedEventCount()));
+    ImGui::Separator();
+
+    for (const auto& threadFrame : displayedFrame.threads)
+    {
+        if (threadFrame.events.empty())
+        {
+            continue;
+        }
+        ImGui::TextUnformatted(threadFrame.threadName.c_str());
+        renderFlameGraph(threadFrame);
+    }
+#endif
+    ImGui::End();
+}
+
+void Prism::Utility::Profiling::ProfilerGuiComponent::shutdown()
+{
+}
+
+void Prism::Utility::Profiling::ProfilerGuiComponent::renderFrameStatistics()
+{
+    const auto& frameStatistics = ServiceLocator::getService<Core::ITimeManager>()->getFrameStatistics();
+    if (ImGui::BeginTable("Table_FrameStatistics", 7, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg))
+    {
+        for (const char* header : {"ms", "Min", "Avg", "P50", "P95", "P99", "Max"})
+        {
+            ImGui::TableSetupColumn(header);
+        }
+        ImGui::TableHeadersRow();
+        constexpr std::array metricNames = {"Frame", "Update", "Render", "Physics"};
+        for (size_t i = 0; i < metricNames.size(); ++i)
+        {
+            const auto summary = frameStatistics.computeSummary(static_cast<FrameMetric>(i));
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(metricNames[i]);
+            for (const float value : {summary.min, summary.average, summary.p50, summary.p95, summary.p99, summary.max})
+            {
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", value);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    const auto histogram = frameStatistics.buildHistogram(FrameMetric::Frame);
+    std::array<float, FrameHistogram::bucketCount> bucketValues;
+    std::ranges::transform(histogram.counts, bucketValues.begin(), [](const uint32_t count)
+    {
+        return static_cast<float>(count);
+    });
+    const auto overlay = std::to_string(static_cast<int>(FrameHistogram::firstBucketMilliseconds * 1000.0f)) +
+        "us .. " + std::to_string(static_cast<int>(FrameHistogram::getBucketLowerBound(FrameHistogram::bucketCount -
+            1))) + "ms (log2)";
+    ImGui::PlotHistogram("Frame Times", bucketValues.data(), static_cast<int>(bucketValues.size()), 0,
+                         overlay.c_str(), 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+}
+
+void Prism::Utility::Profiling::ProfilerGuiComponent::renderFlameGraph(const ProfileThreadFrame& threadFrame) const
+{
+    const auto& profiler = Profiler::profilerInstance();
+    uint32_t maxDepth = 0;
+    for (const auto& event : threadFrame.events)
+    {
+        maxDepth = std::max(maxDepth, event.depth);
+    }
+
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(ImVec2(width, rowHeight * static_cast<float>(maxDepth + 1)));
+
+    // Scopes of other threads may overlap the frame boundaries, they get clipped to the frame
+    const auto frameTicks = static_cast<double>(std::max<uint64_t>(displayedFrame.endTicks - displayedFrame.beginTicks,
+                                                                   1));
+    const auto toX = [&](const uint64_t ticks)
+    {
+        const uint64_t clamped = std::clamp(ticks, displayedFrame.beginTicks, displayedFrame.endTicks);
+        return origin.x + static_cast<float>(static_cast<double>(clamped - displayedFrame.beginTicks) / frameTicks) *
+            width;
+    };
+
+    auto* drawList = ImGui::GetWindowDrawList();
+    const ImVec2 mousePosition = ImGui::GetMousePos();
+    for (const auto& event : threadFrame.events)
+    {
+        const ImVec2 min(toX(event.beginTicks), origin.y + rowHeight * static_cast<float>(event.depth));
+        const ImVec2 max(std::max(toX(event.endTicks), min.x + 1.0f), min.y + rowHeight - 1.0f);
+        // Same name, same color across frames
+        const auto hue = static_cast<float>(Hash::fnv1a64(event.name) % 360) / 360.0f;
+        drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.8f));
+        if (max.x - min.x > ImGui::CalcTextSize(event.name).x)
+        {
+            drawList->AddText(min, IM_COL32_BLACK, event.name);
+        }
+        if (ImGui::IsWindowHovered() && mousePosition.x >= min.x && mousePosition.x < max.x &&
+            mousePosition.y >= min.y && mousePosition.y < max.y)
+        {
+            ImGui::SetTooltip("%s: %.3f ms", event.name, profiler.ticksToMilliseconds(event.endTicks - event.beginTicks));
+        }
+    }
+}
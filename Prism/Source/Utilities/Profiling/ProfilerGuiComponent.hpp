@@ -0,0 +1,24 @@
+﻿#pragma once
+#include "Profiler.hpp"
+#include "../../Rendering/Vulkan/ImGui/IImmediateModeGuiComponent.hpp"
+
+namespace Prism::Utility::Profiling
+{
+    // Frame time statistics, GPU pass timings and a flame view of the last profiled frame with capture controls
+    class ProfilerGuiComponent : public Rendering::IImmediateModeGuiComponent
+    {
+    public:
+        inline constexpr static const char* traceFileName = "Prism.trace.json";
+
+        ProfilerGuiComponent() = default;
+        void renderUi() override;
+        void shutdown() override;
+
+    private:
+        bool paused = false;
+        ProfileFrame displayedFrame;
+
+        void renderFlameGraph(const ProfileThreadFrame& threadFrame) const;
+        static void renderFrameStatistics();
+    };
+}
@@ -1,9 +1,11 @@
 ﻿#pragma once
-#include <ranges>
+#include <cassert>
+#include <memory>
+#include <vector>
 
 #include "IService.hpp"
-#include "TypeMap.hpp"
 #include "Globals.hpp"
+#include "ServiceStartupScheduler.hpp"
 
 namespace Prism::Utility
 {
@@ -17,6 +19,18 @@ namespace Prism::Utility
     concept ClassImplementsInterfaceOfIService = ImplementsIService<T> && std::is_base_of_v<T, U> && !std::is_abstract_v
         <U>;
 
+    // One pointer per service interface. Constant initialized, so a lookup is a single load without a guard or hash.
+    template <typename T>
+    struct ServiceSlot
+    {
+        inline static constinit T* instance = nullptr;
+
+        static void reset()
+        {
+            instance = nullptr;
+        }
+    };
+
     class ServiceLocator
     {
     public:
@@ -33,30 +47,21 @@ namespace Prism::Utility
         template <typename I, ClassImplementsInterfaceOfIService<I> T>
         static RawPtr<I> registerService()
         {
-            ServiceLocator& instance = serviceLocatorInstance();
-            const auto result = instance.services.find<T>();
-            if (result != instance.services.end())
-                return RawPtr<I>();
-            auto service = std::make_unique<T>();
-            auto returnServicePtr = static_cast<I*>(service.get());
-            instance.servicesBootOrder.push_back(returnServicePtr);
-            auto returnService = RawPtr<I>(returnServicePtr);
-            instance.services.put<I>(std::move(service));
-            LOG_DEBUG("Registered service: {}", returnService->getFullName());
-            return returnService;
+            return registerService<I, T>(std::make_unique<T>());
         }
 
         template <typename I, ClassImplementsInterfaceOfIService<I> T>
         static RawPtr<I> registerService(std::unique_ptr<T>&& service)
         {
             ServiceLocator& instance = serviceLocatorInstance();
-            const auto result = instance.services.find<I>();
-            if (result != instance.services.end())
+            if (ServiceSlot<I>::instance)
                 return RawPtr<I>();
             auto returnServicePtr = static_cast<I*>(service.get());
-            instance.servicesBootOrder.push_back(returnServicePtr);
+            instance.servicesBootOrder.push_back({returnServicePtr, getServiceTypeKey<I>()});
+            instance.services.push_back(std::move(service));
+            instance.slotResets.push_back(&ServiceSlot<I>::reset);
+            ServiceSlot<I>::instance = returnServicePtr;
             auto returnService = RawPtr<I>(returnServicePtr);
-            instance.services.put<I>(std::move(service));
             LOG_DEBUG("Registered service: {}", returnService->getFullName());
             return returnService;
         }
@@ -64,49 +69,56 @@ namespace Prism::Utility
         template <ImplementsIService T>
         static RawPtr<T> getService()
         {
-            const ServiceLocator& instance = serviceLocatorInstance();
-            auto result = instance.services.find<T>();
-            assert(result != instance.services.end());
-            if (result == instance.services.end())
+            T* service = ServiceSlot<T>::instance;
+            assert(service);
+            if (!service)
             {
-                LOG_WARN("Service instance of type {} not found, nullptr is returned!", typeid(T).name());
+                LOG_RATE_LIMITED(LOG_WARN, "Service instance of type {} not found, nullptr is returned!",
+                                 typeid(T).name());
                 return nullptr;
             }
-
-            return RawPtr<T>(static_cast<T*>(result->second.get()));
+            return RawPtr<T>(service);
         }
 
         static void initializeServicesInternal()
         {
-            const ServiceLocator& instance = serviceLocatorInstance();
-            for (const auto service : instance.servicesBootOrder)
-            {
-                service->initialize();
-                LOG_DEBUG("Initialized service: {}", service->getFullName());
-            }
+            ServiceLocator& instance = serviceLocatorInstance();
+            // Filled while services finish, if one throws the ones that initialized are still deinitialized
+            ServiceStartupScheduler::run(instance.servicesBootOrder, ServiceStartupPhase::Initialize,
+                                         instance.servicesInitializationOrder);
         }
 
         static void deferredInitializeServicesInternal()
         {
             const ServiceLocator& instance = serviceLocatorInstance();
-            for (const auto service : instance.servicesBootOrder)
-            {
-                service->initializeDeferred();
-                LOG_DEBUG("Deferred Initialized service: {}", service->getFullName());
-            }
+            std::vector<IService*> finishOrder;
+            ServiceStartupScheduler::run(instance.servicesBootOrder, ServiceStartupPhase::InitializeDeferred,
+                                         finishOrder);
         }
 
         static void deInitializeServicesInternal()
         {
             ServiceLocator& instance = serviceLocatorInstance();
-            for (auto it = instance.servicesBootOrder.rbegin(); it != instance.servicesBootOrder.rend(); ++it)
+            // Dependents finished initializing after their dependencies, so they are torn down first
+            for (auto it = instance.servicesInitializationOrder.rbegin();
+                 it != instance.servicesInitializationOrder.rend(); ++it)
             {
                 auto service = *it;
                 service->deInitialize();
                 LOG_DEBUG("Deinitialized service: {}", service->getFullName());
             }
+            instance.servicesInitializationOrder.clear();
             instance.servicesBootOrder.clear();
-            instance.services.clear();
+            // Destroyed in reverse registration order, later services may still use earlier ones in their destructor
+            while (!instance.services.empty())
+            {
+                instance.services.pop_back();
+            }
+            for (const auto slotReset : instance.slotResets)
+            {
+                slotReset();
+            }
+            instance.slotResets.clear();
         }
 
         // instance generation and retrieval
@@ -117,8 +129,44 @@ namespace Prism::Utility
         }
 
     private:
-        TypeMap<std::unique_ptr<IService>> services;
-        std::vector<IService*> servicesBootOrder;
+        std::vector<std::unique_ptr<IService>> services;
+        std::vector<ServiceStartupEntry> servicesBootOrder;
+        std::vector<IService*> servicesInitializationOrder;
+        std::vector<void(*)()> slotResets;
         ServiceLocator() = default;
     };
+
+    /*
+     * Caches the service pointer on first use, for members of objects that access a service all the time.
+     * Debug builds check on every access that the cached service is still the registered one.
+     */
+    template <ImplementsIService T>
+    class ServiceRef
+    {
+    public:
+        [[nodiscard]] T* get() const
+        {
+            if (!service)
+            {
+                service = ServiceLocator::getService<T>().get();
+            }
+#ifdef Prism_DEBUG
+            assert(service == ServiceSlot<T>::instance && "ServiceRef outlived the service it refers to!");
+#endif
+            return service;
+        }
+
+        T* operator->() const
+        {
+            return get();
+        }
+
+        T& operator*() const
+        {
+            return *get();
+        }
+
+    private:
+        mutable T* service = nullptr;
+    };
 }
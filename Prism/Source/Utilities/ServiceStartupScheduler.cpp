@@ -0,0 +1,310 @@
+﻿#include "ServiceStartupScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "ConsoleVariables.hpp"
+#include "ThreadPool.hpp"
+#include "Logging/Log.hpp"
+
+namespace
+{
+    Prism::Utility::ConsoleVariable<bool> cvarParallelServiceStartup(
+        "services.parallelStartup", true,
+        "Initialize services without dependencies on each other concurrently, off runs them one by one",
+        Prism::Utility::ConsoleVariableFlags::RequiresRestart);
+
+    using Clock = std::chrono::steady_clock;
+
+    struct StartupNode
+    {
+        Prism::Utility::IService* service = nullptr;
+        std::string name;
+        std::vector<uint32_t> dependencies;
+        std::vector<uint32_t> dependents;
+        uint32_t remainingDependencies = 0;
+        bool mainThreadRequired = false;
+        double startMilliseconds = 0.0;
+        double endMilliseconds = 0.0;
+    };
+
+    [[nodiscard]] std::vector<StartupNode> buildGraph(const std::vector<Prism::Utility::ServiceStartupEntry>& entries)
+    {
+        std::vector<StartupNode> nodes(entries.size());
+        for (uint32_t i = 0; i < entries.size(); ++i)
+        {
+            auto& node = nodes[i];
+            node.service = entries[i].service;
+            node.name = node.service->getFullName();
+            Prism::Utility::ServiceDependencies dependencies;
+            node.service->declareDependencies(dependencies);
+            node.mainThreadRequired = dependencies.isMainThreadRequired();
+            for (const auto key : dependencies.getDependencies())
+            {
+                const auto it = std::ranges::find(entries, key, &Prism::Utility::ServiceStartupEntry::key);
+                if (it == entries.end())
+                {
+                    // e.g. an optional service that is not registered in this configuration
+                    LOG_DEBUG("Service {} depends on a service that is not registered, ignoring it", node.name);
+                    continue;
+                }
+                const auto dependency = static_cast<uint32_t>(it - entries.begin());
+                if (dependency != i && std::ranges::find(node.dependencies, dependency) == node.dependencies.end())
+                {
+                    node.dependencies.push_back(dependency);
+                }
+            }
+        }
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            nodes[i].remainingDependencies = static_cast<uint32_t>(nodes[i].dependencies.size());
+            for (const auto dependency : nodes[i].dependencies)
+            {
+                nodes[dependency].dependents.push_back(i);
+            }
+        }
+
+        // Kahn's algorithm on a copy of the counters, whatever is left over is part of a cycle
+        std::vector<uint32_t> remaining(nodes.size());
+        std::vector<uint32_t> ready;
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            remaining[i] = nodes[i].remainingDependencies;
+            if (remaining[i] == 0)
+            {
+                ready.push_back(i);
+            }
+        }
+        size_t visitedCount = 0;
+        while (!ready.empty())
+        {
+            const auto index = ready.back();
+            ready.pop_back();
+            ++visitedCount;
+            for (const auto dependent : nodes[index].dependents)
+            {
+                if (--remaining[dependent] == 0)
+                {
+                    ready.push_back(dependent);
+                }
+            }
+        }
+        if (visitedCount != nodes.size())
+        {
+            std::string cycle;
+            for (uint32_t i = 0; i < nodes.size(); ++i)
+            {
+                if (remaining[i] != 0)
+                {
+                    cycle += (cycle.empty() ? "" : ", ") + nodes[i].name;
+                }
+            }
+            throw std::runtime_error("ServiceStartupScheduler: dependency cycle between " + cycle);
+        }
+        return nodes;
+    }
+
+    void logTimeline(const std::vector<StartupNode>& nodes, const char* phaseName, const double wallMilliseconds,
+                     const uint32_t threadCount)
+    {
+        if (nodes.empty())
+        {
+            return;
+        }
+        // Walks back from the service that finished last, always over the dependency that finished last
+        std::vector<bool> onCriticalPath(nodes.size(), false);
+        auto current = static_cast<uint32_t>(std::ranges::max_element(nodes, {}, &StartupNode::endMilliseconds) -
+            nodes.begin());
+        std::vector<uint32_t> criticalPath;
+        while (true)
+        {
+            onCriticalPath[current] = true;
+            criticalPath.push_back(current);
+            const auto& dependencies = nodes[current].dependencies;
+            if (dependencies.empty())
+            {
+                break;
+            }
+            current = *std::ranges::max_element(dependencies, {}, [&nodes](const uint32_t dependency)
+            {
+                return nodes[dependency].endMilliseconds;
+            });
+        }
+
+        double summedMilliseconds = 0.0;
+        for (const auto& node : nodes)
+        {
+            summedMilliseconds += node.endMilliseconds - node.startMilliseconds;
+        }
+        LOG_INFO("Service {} took {:.2f} ms, {:.2f} ms of work on {} threads", phaseName, wallMilliseconds,
+                 summedMilliseconds, threadCount);
+
+        std::vector<uint32_t> startOrder(nodes.size());
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            startOrder[i] = i;
+        }
+        std::ranges::sort(startOrder, {}, [&nodes](const uint32_t index) { return nodes[index].startMilliseconds; });
+        for (const auto index : startOrder)
+        {
+            const auto& node = nodes[index];
+            LOG_INFO("  {} {:8.2f} ms +{:8.2f} ms  {}", onCriticalPath[index] ? '*' : ' ', node.startMilliseconds,
+                     node.endMilliseconds - node.startMilliseconds, node.name);
+        }
+
+        std::string criticalPathText;
+        for (auto it = criticalPath.rbegin(); it != criticalPath.rend(); ++it)
+        {
+            criticalPathText += (criticalPathText.empty() ? "" : " -> ") + nodes[*it].name;
+        }
+        LOG_INFO("  Critical path ({:.2f} ms): {}", nodes[criticalPath.front()].endMilliseconds, criticalPathText);
+    }
+}
+
+void Prism::Utility::ServiceStartupScheduler::run(const std::vector<ServiceStartupEntry>& entries,
+                                                  const ServiceStartupPhase phase,
+                                                  std::vector<IService*>& finishOrder)
+{
+    auto nodes = buildGraph(entries);
+    const auto workerEligibleCount = static_cast<uint32_t>(std::ranges::count(nodes, false,
+        &StartupNode::mainThreadRequired));
+    // Spawning threads only pays off if at least two services can actually overlap
+    std::optional<ThreadPool> threadPool;
+    if (cvarParallelServiceStartup.get() && workerEligibleCount > 1)
+    {
+        const auto workerCount = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, workerEligibleCount);
+        threadPool.emplace(workerCount, "ServiceStartup");
+    }
+
+    std::mutex mutex;
+    std::condition_variable nodeFinished;
+    std::deque<uint32_t> mainThreadReady;
+    // Taken by the pool and by the main thread whenever it has nothing of its own to do
+    std::deque<uint32_t> anyThreadReady;
+    finishOrder.reserve(finishOrder.size() + nodes.size());
+    std::exception_ptr firstException;
+    uint32_t runningCount = 0;
+    const auto phaseStart = Clock::now();
+
+    // schedule runs with the mutex held, runNode takes it after the service call
+    std::function<void(uint32_t)> schedule;
+    const auto runNode = [&](const uint32_t index)
+    {
+        auto& node = nodes[index];
+        const auto start = Clock::now();
+        std::exception_ptr exception;
+        try
+        {
+            if (phase == ServiceStartupPhase::Initialize)
+            {
+                node.service->initialize();
+            }
+            else
+            {
+                node.service->initializeDeferred();
+            }
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+        const auto end = Clock::now();
+
+        std::scoped_lock lock(mutex);
+        node.startMilliseconds = std::chrono::duration<double, std::milli>(start - phaseStart).count();
+        node.endMilliseconds = std::chrono::duration<double, std::milli>(end - phaseStart).count();
+        --runningCount;
+        if (exception)
+        {
+            firstException = firstException ? firstException : exception;
+        }
+        else
+        {
+            finishOrder.push_back(node.service);
+            for (const auto dependent : node.dependents)
+            {
+                if (--nodes[dependent].remainingDependencies == 0)
+                {
+                    schedule(dependent);
+                }
+            }
+        }
+        nodeFinished.notify_all();
+    };
+    schedule = [&](const uint32_t index)
+    {
+        if (firstException)
+        {
+            return;
+        }
+        if (!threadPool || nodes[index].mainThreadRequired)
+        {
+            mainThreadReady.push_back(index);
+            return;
+        }
+        anyThreadReady.push_back(index);
+        threadPool->enqueue([&]
+        {
+            std::unique_lock workerLock(mutex);
+            if (anyThreadReady.empty() || firstException)
+            {
+                return;
+            }
+            const auto readyIndex = anyThreadReady.front();
+            anyThreadReady.pop_front();
+            ++runningCount;
+            workerLock.unlock();
+            runNode(readyIndex);
+        });
+    };
+
+    std::unique_lock lock(mutex);
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].remainingDependencies == 0)
+        {
+            schedule(i);
+        }
+    }
+    while (true)
+    {
+        nodeFinished.wait(lock, [&]
+        {
+            return ((!mainThreadReady.empty() || !anyThreadReady.empty()) && !firstException) || runningCount == 0;
+        });
+        if (firstException || (mainThreadReady.empty() && anyThreadReady.empty()))
+        {
+            // Nothing is running and nothing new can become ready anymore
+            if (runningCount == 0)
+            {
+                break;
+            }
+            continue;
+        }
+        auto& ready = mainThreadReady.empty() ? anyThreadReady : mainThreadReady;
+        const auto index = ready.front();
+        ready.pop_front();
+        ++runningCount;
+        lock.unlock();
+        runNode(index);
+        lock.lock();
+    }
+    lock.unlock();
+    const double wallMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - phaseStart).count();
+    const uint32_t threadCount = threadPool ? threadPool->getWorkerCount() + 1 : 1;
+    threadPool.reset();
+
+    if (firstException)
+    {
+        std::rethrow_exception(firstException);
+    }
+    logTimeline(nodes, phase == ServiceStartupPhase::Initialize ? "initialization" : "deferred initialization",
+                wallMilliseconds, threadCount);
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+#include <vector>
+
+#include "IService.hpp"
+
+namespace Prism::Utility
+{
+    enum class ServiceStartupPhase
+    {
+        Initialize,
+        InitializeDeferred
+    };
+
+    struct ServiceStartupEntry
+    {
+        IService* service;
+        ServiceTypeKey key;
+    };
+
+    /*
+     * Runs one startup phase over all services as a DAG built from IService::declareDependencies. Services whose
+     * dependencies are done start right away, on a temporary worker pool unless they require the main thread, and the
+     * main thread works off its own ready services meanwhile. Logs a timeline with the duration of every service and
+     * the critical path afterwards.
+     */
+    class ServiceStartupScheduler
+    {
+    public:
+        /*
+         * Appends every service to finishOrder as soon as it finished, so after a failure it holds exactly the services
+         * that completed. The first exception thrown by a service is rethrown once no service is running anymore.
+         */
+        static void run(const std::vector<ServiceStartupEntry>& entries, ServiceStartupPhase phase,
+                        std::vector<IService*>& finishOrder);
+    };
+}
@@ -0,0 +1,86 @@
+﻿#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+#include "Logging/Log.hpp"
+#include "Profiling/AllocationTracker.hpp"
+#include "Profiling/Profiler.hpp"
+
+namespace
+{
+    thread_local const Prism::Utility::ThreadPool* currentPool = nullptr;
+}
+
+Prism::Utility::ThreadPool::ThreadPool(const uint32_t workerCount, std::string name) : name(std::move(name))
+{
+    workers.reserve(std::max(workerCount, 1u));
+    for (uint32_t i = 0; i < std::max(workerCount, 1u); ++i)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+Prism::Utility::ThreadPool::~ThreadPool()
+{
+    {
+        std::scoped_lock lock(jobsMutex);
+        stopRequested = true;
+    }
+    jobsAvailable.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void Prism::Utility::ThreadPool::enqueue(std::function<void()> job)
+{
+    {
+        std::scoped_lock lock(jobsMutex);
+        jobs.emplace_back(std::move(job));
+    }
+    jobsAvailable.notify_one();
+}
+
+bool Prism::Utility::ThreadPool::isWorkerThread() const
+{
+    return currentPool == this;
+}
+
+void Prism::Utility::ThreadPool::workerLoop()
+{
+    currentPool = this;
+    PRISM_PROFILE_THREAD(name);
+    PRISM_ALLOCATION_SCOPE("Jobs");
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(jobsMutex);
+            jobsAvailable.wait(lock, [this]
+            {
+                return stopRequested || !jobs.empty();
+            });
+            if (jobs.empty())
+            {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        try
+        {
+            PRISM_PROFILE_SCOPE("ThreadPool::job");
+            job();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Uncaught exception in job of thread pool {}: {}", name, e.what());
+        }
+        catch (...)
+        {
+            LOG_ERROR("Uncaught non-standard exception in job of thread pool {}", name);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+﻿#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Prism::Utility
+{
+    // Fixed size pool of worker threads consuming a shared FIFO job queue
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(uint32_t workerCount, std::string name = "Worker");
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool(ThreadPool&& other) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+        ThreadPool& operator=(ThreadPool&& other) noexcept = delete;
+        // Finishes all queued jobs before joining the workers
+        ~ThreadPool();
+
+        void enqueue(std::function<void()> job);
+
+        template <typename F>
+        [[nodiscard]] auto submit(F&& function) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using ResultType = std::invoke_result_t<std::decay_t<F>>;
+            // std::function requires copyable callables, therefore the task is shared
+            auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(function));
+            auto future = task->get_future();
+            enqueue([task]
+            {
+                (*task)();
+            });
+            return future;
+        }
+
+        [[nodiscard]] uint32_t getWorkerCount() const
+        {
+            return static_cast<uint32_t>(workers.size());
+        }
+
+        [[nodiscard]] std::string getName() const
+        {
+            return name;
+        }
+
+        // True if the calling thread is one of this pool's workers
+        [[nodiscard]] bool isWorkerThread() const;
+
+    private:
+        void workerLoop();
+
+        std::string name;
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> jobs;
+        std::mutex jobsMutex;
+        std::condition_variable jobsAvailable;
+        bool stopRequested = false;
+    };
+}
@@ -0,0 +1,216 @@
+﻿#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Assets/AssetManager.hpp"
+#include "Assets/CookedStaticMesh.hpp"
+#include "Assets/StaticMeshAssetFactory.hpp"
+#include "Assets/StaticMeshCooker.hpp"
+#include "Assets/TextureAssetFactory.hpp"
+#include "Utilities/JobSystem.hpp"
+#include "Utilities/ServiceLocator.hpp"
+// Only this file writes images, the stb_image implementation itself lives in TextureAssetFactory.cpp
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+namespace
+{
+    class BenchmarkAsset : public Prism::Assets::Asset
+    {
+    public:
+        explicit BenchmarkAsset(const std::string& name) : Asset(name)
+        {
+        }
+    };
+
+    // Names starting with "Missing" fail to load, everything else loads instantly without touching the disk
+    class BenchmarkAssetFactory : public Prism::Assets::IAssetFactory
+    {
+    public:
+        std::unique_ptr<Prism::Assets::Asset> loadAsset(const std::string& fileName) override
+        {
+            if (fileName.starts_with("Missing"))
+            {
+                return nullptr;
+            }
+            return std::make_unique<BenchmarkAsset>(fileName);
+        }
+    };
+
+    RawPtr<Prism::Assets::AssetManager> getAssetManager()
+    {
+        static const auto assetManager = []
+        {
+            Prism::Utility::ServiceLocator::registerService<Prism::Utility::JobSystem, Prism::Utility::JobSystem>();
+            auto manager = Prism::Utility::ServiceLocator::registerService<Prism::Assets::AssetManager,
+                                                                           Prism::Assets::AssetManager>();
+            Prism::Utility::ServiceLocator::initializeServicesInternal();
+            manager->registerAssetFactory<BenchmarkAssetFactory, BenchmarkAsset>();
+            return manager;
+        }();
+        return assetManager;
+    }
+
+    std::filesystem::path getBenchmarkDirectory()
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "PrismBenchmarks";
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+
+    // A flat grid with gridSize * gridSize quads, every vertex is shared by up to four quads
+    std::string writeObjGrid(const int64_t gridSize)
+    {
+        // Benchmarks run several times while calibrating, the files only need to be written once per process
+        static std::map<int64_t, std::string> writtenFiles;
+        if (const auto it = writtenFiles.find(gridSize); it != writtenFiles.end())
+        {
+            return it->second;
+        }
+        const auto fileName = (getBenchmarkDirectory() / ("Grid" + std::to_string(gridSize) + ".obj")).
+            generic_string();
+        writtenFiles[gridSize] = fileName;
+        std::ofstream file(fileName, std::ios::trunc);
+        const auto vertexRowLength = gridSize + 1;
+        for (int64_t y = 0; y <= gridSize; ++y)
+        {
+            for (int64_t x = 0; x <= gridSize; ++x)
+            {
+                file << "v " << x << " 0 " << y << "\n";
+                file << "vt " << static_cast<float>(x) / gridSize << " " << static_cast<float>(y) / gridSize << "\n";
+            }
+        }
+        file << "vn 0 1 0\n";
+        for (int64_t y = 0; y < gridSize; ++y)
+        {
+            for (int64_t x = 0; x < gridSize; ++x)
+            {
+                // OBJ indices are 1 based
+                const auto i0 = y * vertexRowLength + x + 1;
+                const auto i1 = i0 + 1;
+                const auto i2 = i0 + vertexRowLength;
+                const auto i3 = i2 + 1;
+                file << "f " << i0 << "/" << i0 << "/1 " << i2 << "/" << i2 << "/1 " << i1 << "/" << i1 << "/1\n";
+                file << "f " << i1 << "/" << i1 << "/1 " << i2 << "/" << i2 << "/1 " << i3 << "/" << i3 << "/1\n";
+            }
+        }
+        return fileName;
+    }
+
+    std::string writeTexture(const int64_t size)
+    {
+        static std::map<int64_t, std::string> writtenFiles;
+        if (const auto it = writtenFiles.find(size); it != writtenFiles.end())
+        {
+            return it->second;
+        }
+        const auto fileName = (getBenchmarkDirectory() / ("Texture" + std::to_string(size) + ".png")).
+            generic_string();
+        writtenFiles[size] = fileName;
+        const auto dimension = static_cast<int>(size);
+        std::vector<uint8_t> pixels(static_cast<size_t>(dimension) * dimension * 4);
+        for (int y = 0; y < dimension; ++y)
+        {
+            for (int x = 0; x < dimension; ++x)
+            {
+                // Gradient with some noise, so the PNG doesn't compress down to nothing
+                auto* pixel = &pixels[(static_cast<size_t>(y) * dimension + x) * 4];
+                pixel[0] = static_cast<uint8_t>(x);
+                pixel[1] = static_cast<uint8_t>(y);
+                pixel[2] = static_cast<uint8_t>((x * 7 + y * 13) ^ (x * y));
+                pixel[3] = 255;
+            }
+        }
+        stbi_write_png(fileName.c_str(), dimension, dimension, 4, pixels.data(), dimension * 4);
+        return fileName;
+    }
+
+    void getAssetHit(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto assetManager = getAssetManager();
+        const auto assetCount = state.getArg(0);
+        std::vector<std::string> names;
+        for (int64_t i = 0; i < assetCount; ++i)
+        {
+            names.push_back("Asset" + std::to_string(i));
+            // Handles are dropped right away but the assets stay cached as long as there is no memory budget
+            PrismBenchmarks::doNotOptimize(assetManager->getAsset<BenchmarkAsset>(names.back()));
+        }
+        size_t index = 0;
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(assetManager->getAsset<BenchmarkAsset>(names[index]));
+            index = index + 1 == names.size() ? 0 : index + 1;
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    // Failed loads aren't cached, so every miss goes through the request bookkeeping and the factory again
+    void getAssetMiss(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto assetManager = getAssetManager();
+        const std::string name = "MissingAsset";
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(assetManager->getAsset<BenchmarkAsset>(name));
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void parseObj(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto fileName = writeObjGrid(state.getArg(0));
+        const auto fileSize = std::filesystem::file_size(fileName);
+        std::vector<Prism::Rendering::Vertex> vertices;
+        std::vector<uint32_t> indices;
+        while (state.keepRunning())
+        {
+            Prism::Assets::StaticMeshAssetFactory::parseObj(fileName, vertices, indices);
+            PrismBenchmarks::doNotOptimize(vertices.data());
+        }
+        state.setItemsProcessed(state.getIterations() * indices.size() / 3);
+        state.setBytesProcessed(state.getIterations() * fileSize);
+    }
+
+    // The same mesh as parseObj but cooked, for comparison with the runtime path that maps .pmesh files
+    void loadCookedMesh(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto sourceFileName = writeObjGrid(state.getArg(0));
+        const auto cookedFileName = Prism::Assets::CookedStaticMesh::getCookedFileName(sourceFileName);
+        if (!Prism::Assets::StaticMeshCooker::isUpToDate(sourceFileName, cookedFileName))
+        {
+            Prism::Assets::StaticMeshCooker::cook(sourceFileName, cookedFileName);
+        }
+        const auto fileSize = std::filesystem::file_size(cookedFileName);
+        Prism::Assets::StaticMeshAssetFactory factory;
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(factory.loadAsset(cookedFileName));
+        }
+        state.setBytesProcessed(state.getIterations() * fileSize);
+    }
+
+    void loadTexture(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto size = state.getArg(0);
+        const auto fileName = writeTexture(size);
+        const auto fileSize = std::filesystem::file_size(fileName);
+        Prism::Assets::TextureAssetFactory factory;
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(factory.loadAsset(fileName));
+        }
+        // Items are decoded pixels
+        state.setItemsProcessed(state.getIterations() * size * size);
+        state.setBytesProcessed(state.getIterations() * fileSize);
+    }
+}
+
+PRISM_BENCHMARK("AssetManager/getAssetHit", getAssetHit)->args({1, 1'000, 100'000});
+PRISM_BENCHMARK("AssetManager/getAssetMiss", getAssetMiss);
+PRISM_BENCHMARK("StaticMeshAssetFactory/parseObj", parseObj)->args({16, 128, 512});
+PRISM_BENCHMARK("StaticMeshAssetFactory/loadCooked", loadCookedMesh)->args({16, 128, 512});
+PRISM_BENCHMARK("TextureAssetFactory/loadAsset", loadTexture)->args({64, 512, 2048});
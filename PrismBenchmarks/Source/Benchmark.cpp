@@ -0,0 +1,213 @@
+﻿#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    // Benchmarks that are still faster than the min time after this many iterations are simply reported as they are
+    constexpr uint64_t maxIterations = 1'000'000'000;
+
+    std::string escapeJson(const std::string& value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char c : value)
+        {
+            switch (c)
+            {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            default:
+                escaped += c;
+                break;
+            }
+        }
+        return escaped;
+    }
+
+    std::string getCurrentDate()
+    {
+        const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm localTime = {};
+#ifdef _WIN64
+        localtime_s(&localTime, &now);
+#else
+        localtime_r(&now, &localTime);
+#endif
+        std::ostringstream stream;
+        stream << std::put_time(&localTime, "%Y-%m-%dT%H:%M:%S");
+        return stream.str();
+    }
+}
+
+void PrismBenchmarks::useCharPointer(const volatile char*)
+{
+}
+
+PrismBenchmarks::Benchmark* PrismBenchmarks::BenchmarkRegistry::registerBenchmark(
+    const std::string& name, BenchmarkFunction function)
+{
+    return benchmarks.emplace_back(std::make_unique<Benchmark>(name, std::move(function))).get();
+}
+
+std::vector<std::string> PrismBenchmarks::BenchmarkRegistry::getBenchmarkNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& benchmark : benchmarks)
+    {
+        if (benchmark->getArgSets().empty())
+        {
+            names.push_back(benchmark->getName());
+            continue;
+        }
+        for (const auto& args : benchmark->getArgSets())
+        {
+            auto name = benchmark->getName();
+            for (const auto arg : args)
+            {
+                name += "/" + std::to_string(arg);
+            }
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+std::vector<PrismBenchmarks::BenchmarkResult> PrismBenchmarks::BenchmarkRegistry::runBenchmarks(
+    const BenchmarkRunOptions& options) const
+{
+    const std::regex filter(options.filter.empty() ? ".*" : options.filter);
+    std::vector<BenchmarkResult> results;
+
+    std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(16) << "Time (ns)" <<
+        std::setw(16) << "CPU (ns)" << std::setw(14) << "Iterations" << std::setw(18) << "Items/s" << std::endl;
+    std::cout << std::string(112, '-') << std::endl;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        auto argSets = benchmark->getArgSets();
+        if (argSets.empty())
+        {
+            argSets.emplace_back();
+        }
+        for (const auto& args : argSets)
+        {
+            auto name = benchmark->getName();
+            for (const auto arg : args)
+            {
+                name += "/" + std::to_string(arg);
+            }
+            if (!std::regex_search(name, filter))
+            {
+                continue;
+            }
+
+            const auto& result = results.emplace_back(runBenchmark(name, benchmark->getFunction(), args,
+                                                                   options.minTimeSeconds));
+            std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed <<
+                std::setprecision(1) << std::setw(16) << result.realTime << std::setw(16) << result.cpuTime <<
+                std::setw(14) << result.iterations << std::setw(18) << std::setprecision(0) <<
+                result.itemsPerSecond << std::endl;
+        }
+    }
+    return results;
+}
+
+PrismBenchmarks::BenchmarkResult PrismBenchmarks::BenchmarkRegistry::runBenchmark(
+    const std::string& name, const BenchmarkFunction& function, const std::vector<int64_t>& args,
+    const double minTimeSeconds)
+{
+    // Grow the iteration count until a single run takes at least minTimeSeconds, only the last run is reported
+    uint64_t iterations = 1;
+    while (true)
+    {
+        BenchmarkState state(iterations, args);
+        function(state);
+
+        const auto realTime = state.getRealTimeSeconds();
+        if (realTime >= minTimeSeconds || iterations >= maxIterations)
+        {
+            BenchmarkResult result;
+            result.name = name;
+            result.iterations = iterations;
+            result.realTime = realTime * 1.0e9 / static_cast<double>(iterations);
+            result.cpuTime = state.getCpuTimeSeconds() * 1.0e9 / static_cast<double>(iterations);
+            if (realTime > 0.0)
+            {
+                result.itemsPerSecond = static_cast<double>(state.getItemsProcessed()) / realTime;
+                result.bytesPerSecond = static_cast<double>(state.getBytesProcessed()) / realTime;
+            }
+            return result;
+        }
+
+        // Overshoot the prediction a bit so we usually need only one more run, but never grow more than 10x at once
+        const auto multiplier = realTime > 0.0 ? minTimeSeconds * 1.4 / realTime : 10.0;
+        const auto nextIterations = static_cast<double>(iterations) * std::clamp(multiplier, 2.0, 10.0);
+        iterations = std::min(static_cast<uint64_t>(nextIterations), maxIterations);
+    }
+}
+
+bool PrismBenchmarks::BenchmarkRegistry::writeJson(const std::string& fileName,
+                                                   const std::vector<BenchmarkResult>& results)
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+#ifdef Prism_DEBUG
+    const std::string buildType = "debug";
+#else
+    const std::string buildType = "release";
+#endif
+
+    file << std::setprecision(17);
+    file << "{\n";
+    file << "  \"context\": {\n";
+    file << "    \"date\": \"" << getCurrentDate() << "\",\n";
+    file << "    \"executable\": \"PrismBenchmarks\",\n";
+    file << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "    \"library_build_type\": \"" << buildType << "\"\n";
+    file << "  },\n";
+    file << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        const auto name = escapeJson(result.name);
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\n";
+        file << "      \"name\": \"" << name << "\",\n";
+        file << "      \"run_name\": \"" << name << "\",\n";
+        file << "      \"run_type\": \"iteration\",\n";
+        file << "      \"iterations\": " << result.iterations << ",\n";
+        file << "      \"real_time\": " << result.realTime << ",\n";
+        file << "      \"cpu_time\": " << result.cpuTime << ",\n";
+        file << "      \"time_unit\": \"ns\"";
+        if (result.itemsPerSecond > 0.0)
+        {
+            file << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        }
+        if (result.bytesPerSecond > 0.0)
+        {
+            file << ",\n      \"bytes_per_second\": " << result.bytesPerSecond;
+        }
+        file << "\n    }";
+    }
+    file << "\n  ]\n";
+    file << "}\n";
+    return file.good();
+}
@@ -0,0 +1,229 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PrismBenchmarks
+{
+    void useCharPointer(const volatile char* pointer);
+
+    // Keeps the compiler from optimizing away the computation of value without adding any work itself
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+#ifdef _MSC_VER
+        // MSVC x64 has no inline assembly, passing the address to an opaque function has the same effect
+        useCharPointer(&reinterpret_cast<const volatile char&>(value));
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r"(&value) : "memory");
+#endif
+    }
+
+    /*
+     * Passed to every benchmark function. Everything before the first keepRunning() call is setup and isn't timed:
+     * while (state.keepRunning()) { ... }
+     */
+    class BenchmarkState
+    {
+    public:
+        BenchmarkState(const uint64_t iterations, std::vector<int64_t> args)
+            : iterations(iterations), remainingIterations(iterations), args(std::move(args))
+        {
+        }
+
+        bool keepRunning()
+        {
+            if (!started)
+            {
+                started = true;
+                resumeTiming();
+            }
+            if (remainingIterations == 0)
+            {
+                pauseTiming();
+                return false;
+            }
+            --remainingIterations;
+            return true;
+        }
+
+        // Excludes per iteration setup or teardown from the measurement, both calls are fairly expensive themselves
+        void pauseTiming()
+        {
+            if (!running)
+            {
+                return;
+            }
+            realTime += std::chrono::steady_clock::now() - realStart;
+            cpuTime += std::clock() - cpuStart;
+            running = false;
+        }
+
+        void resumeTiming()
+        {
+            if (running)
+            {
+                return;
+            }
+            running = true;
+            cpuStart = std::clock();
+            realStart = std::chrono::steady_clock::now();
+        }
+
+        [[nodiscard]] int64_t getArg(const size_t index) const
+        {
+            return args.at(index);
+        }
+
+        [[nodiscard]] uint64_t getIterations() const
+        {
+            return iterations;
+        }
+
+        // Totals over all iterations, reported as throughput per second
+        void setItemsProcessed(const uint64_t items)
+        {
+            itemsProcessed = items;
+        }
+
+        void setBytesProcessed(const uint64_t bytes)
+        {
+            bytesProcessed = bytes;
+        }
+
+        [[nodiscard]] uint64_t getItemsProcessed() const
+        {
+            return itemsProcessed;
+        }
+
+        [[nodiscard]] uint64_t getBytesProcessed() const
+        {
+            return bytesProcessed;
+        }
+
+        [[nodiscard]] double getRealTimeSeconds() const
+        {
+            return std::chrono::duration<double>(realTime).count();
+        }
+
+        [[nodiscard]] double getCpuTimeSeconds() const
+        {
+            return static_cast<double>(cpuTime) / CLOCKS_PER_SEC;
+        }
+
+    private:
+        uint64_t iterations;
+        uint64_t remainingIterations;
+        std::vector<int64_t> args;
+        bool started = false;
+        bool running = false;
+        std::chrono::steady_clock::time_point realStart;
+        std::chrono::steady_clock::duration realTime = std::chrono::steady_clock::duration::zero();
+        std::clock_t cpuStart = 0;
+        std::clock_t cpuTime = 0;
+        uint64_t itemsProcessed = 0;
+        uint64_t bytesProcessed = 0;
+    };
+
+    using BenchmarkFunction = std::function<void(BenchmarkState&)>;
+
+    class Benchmark
+    {
+    public:
+        Benchmark(std::string name, BenchmarkFunction function)
+            : name(std::move(name)), function(std::move(function))
+        {
+        }
+
+        // Runs the benchmark once per added argument, the argument is appended to the name, e.g. Scene/getComponents/1000
+        Benchmark* arg(const int64_t value)
+        {
+            argSets.push_back({value});
+            return this;
+        }
+
+        Benchmark* args(const std::vector<int64_t>& values)
+        {
+            for (const auto value : values)
+            {
+                arg(value);
+            }
+            return this;
+        }
+
+        [[nodiscard]] const std::string& getName() const
+        {
+            return name;
+        }
+
+        [[nodiscard]] const BenchmarkFunction& getFunction() const
+        {
+            return function;
+        }
+
+        [[nodiscard]] const std::vector<std::vector<int64_t>>& getArgSets() const
+        {
+            return argSets;
+        }
+
+    private:
+        std::string name;
+        BenchmarkFunction function;
+        std::vector<std::vector<int64_t>> argSets;
+    };
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        // Per iteration in nanoseconds
+        double realTime = 0.0;
+        double cpuTime = 0.0;
+        double itemsPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+    };
+
+    struct BenchmarkRunOptions
+    {
+        // Only benchmarks whose full name matches this regex are run, empty runs all
+        std::string filter;
+        double minTimeSeconds = 0.5;
+    };
+
+    class BenchmarkRegistry
+    {
+    public:
+        static BenchmarkRegistry& benchmarkRegistryInstance()
+        {
+            static BenchmarkRegistry instance;
+            return instance;
+        }
+
+        Benchmark* registerBenchmark(const std::string& name, BenchmarkFunction function);
+        [[nodiscard]] std::vector<std::string> getBenchmarkNames() const;
+        std::vector<BenchmarkResult> runBenchmarks(const BenchmarkRunOptions& options) const;
+
+        // Same layout as Google Benchmark's JSON reporter, so its compare.py tooling works on our results
+        static bool writeJson(const std::string& fileName, const std::vector<BenchmarkResult>& results);
+
+    private:
+        std::vector<std::unique_ptr<Benchmark>> benchmarks;
+
+        BenchmarkRegistry() = default;
+        static BenchmarkResult runBenchmark(const std::string& name, const BenchmarkFunction& function,
+                                            const std::vector<int64_t>& args, double minTimeSeconds);
+    };
+}
+
+#define PRISM_BENCHMARK_CONCAT_INTERNAL(a, b) a##b
+#define PRISM_BENCHMARK_CONCAT(a, b) PRISM_BENCHMARK_CONCAT_INTERNAL(a, b)
+
+// Registers a benchmark function at static initialization, the returned Benchmark* allows chaining ->args({...})
+#define PRISM_BENCHMARK(name, function) \
+    static PrismBenchmarks::Benchmark* PRISM_BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = \
+        PrismBenchmarks::BenchmarkRegistry::benchmarkRegistryInstance().registerBenchmark(name, function)
@@ -0,0 +1,67 @@
+﻿#include <iostream>
+
+#include "Benchmark.hpp"
+#include "Utilities/ServiceLocator.hpp"
+#include "Utilities/Logging/Log.hpp"
+#include "cxxopts.hpp"
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cxxopts::Options options("PrismBenchmarks", "Microbenchmarks for Prism's hot paths");
+        options.add_options()
+            ("f,filter", "Only run benchmarks whose name matches this regex", cxxopts::value<std::string>())
+            ("o,output", "JSON file the results are written to",
+             cxxopts::value<std::string>()->default_value("PrismBenchmarks.json"))
+            ("t,min-time", "Minimum time in seconds each benchmark runs for",
+             cxxopts::value<double>()->default_value("0.5"))
+            ("l,list", "List all benchmarks without running them")
+            ("h,help", "Print usage");
+
+        const auto parsedOptions = options.parse(argc, argv);
+        if (parsedOptions.count("help"))
+        {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
+
+        auto& registry = PrismBenchmarks::BenchmarkRegistry::benchmarkRegistryInstance();
+        if (parsedOptions.count("list"))
+        {
+            for (const auto& name : registry.getBenchmarkNames())
+            {
+                std::cout << name << std::endl;
+            }
+            return 0;
+        }
+
+        // Errors of benchmarks that provoke them on purpose, e.g. asset misses, would otherwise dominate the timings
+        Prism::Utility::Logging::Log::logInstance().coreLogger->set_level(spdlog::level::off);
+
+        PrismBenchmarks::BenchmarkRunOptions runOptions;
+        if (parsedOptions.count("filter"))
+        {
+            runOptions.filter = parsedOptions["filter"].as<std::string>();
+        }
+        runOptions.minTimeSeconds = parsedOptions["min-time"].as<double>();
+
+        const auto results = registry.runBenchmarks(runOptions);
+        // Shut down the services some benchmarks started while the logger is still alive
+        Prism::Utility::ServiceLocator::deInitializeServicesInternal();
+
+        const auto outputFileName = parsedOptions["output"].as<std::string>();
+        if (!PrismBenchmarks::BenchmarkRegistry::writeJson(outputFileName, results))
+        {
+            std::cerr << "Failed to write results to '" << outputFileName << "'" << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << results.size() << " results to '" << outputFileName << "'" << std::endl;
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Caught exception at top-level: \"" << e.what() << "\"" << std::endl;
+        return 1;
+    }
+}
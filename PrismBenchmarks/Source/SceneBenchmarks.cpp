@@ -0,0 +1,74 @@
+﻿#include <memory>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "Core/Scene.hpp"
+#include "Core/StaticMeshActor.hpp"
+#include "Core/StaticMeshComponent.hpp"
+
+namespace
+{
+    const std::vector<int64_t> actorCounts = {1'000, 10'000, 100'000};
+
+    /*
+     * The scene is never initialized, so registering actors doesn't call into the renderer or asset services.
+     * Every fourth actor is a StaticMeshActor, the rest are plain actors spread over 16 names.
+     */
+    std::unique_ptr<Prism::Core::Scene> createScene(const int64_t actorCount)
+    {
+        auto scene = std::make_unique<Prism::Core::Scene>();
+        for (int64_t i = 0; i < actorCount; ++i)
+        {
+            if (i % 4 == 0)
+            {
+                scene->registerActor(std::make_unique<Prism::Core::StaticMeshActor>());
+            }
+            else
+            {
+                const auto actor = scene->registerActor(std::make_unique<Prism::Core::Actor>());
+                actor->setName("Actor" + std::to_string(i % 16));
+            }
+        }
+        return scene;
+    }
+
+    void getComponents(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto actorCount = state.getArg(0);
+        const auto scene = createScene(actorCount);
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(scene->getComponents<Prism::Core::StaticMeshComponent>());
+        }
+        state.setItemsProcessed(state.getIterations() * actorCount);
+    }
+
+    void getActorsWithName(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto actorCount = state.getArg(0);
+        const auto scene = createScene(actorCount);
+        const std::string name = "Actor5";
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(scene->getActorsWithName<Prism::Core::Actor>(name));
+        }
+        state.setItemsProcessed(state.getIterations() * actorCount);
+    }
+
+    // Registers and immediately unregisters one actor in a scene that already holds the given amount of actors
+    void registerUnregisterActor(PrismBenchmarks::BenchmarkState& state)
+    {
+        const auto actorCount = state.getArg(0);
+        const auto scene = createScene(actorCount);
+        while (state.keepRunning())
+        {
+            const auto actor = scene->registerActor(std::make_unique<Prism::Core::Actor>());
+            scene->unregisterActor(actor);
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+}
+
+PRISM_BENCHMARK("Scene/getComponents", getComponents)->args(actorCounts);
+PRISM_BENCHMARK("Scene/getActorsWithName", getActorsWithName)->args(actorCounts);
+PRISM_BENCHMARK("Scene/registerUnregisterActor", registerUnregisterActor)->args(actorCounts);
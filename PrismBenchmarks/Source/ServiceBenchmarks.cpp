@@ -0,0 +1,59 @@
+﻿#include <memory>
+
+#include "Benchmark.hpp"
+#include "Utilities/JobSystem.hpp"
+#include "Utilities/ServiceLocator.hpp"
+#include "Utilities/TypeMap.hpp"
+
+namespace
+{
+    template <int N>
+    struct TypeKey
+    {
+    };
+
+    // Fills the map with count distinct keys, so lookups don't hit a trivially small hash table
+    template <int... N>
+    void putKeys(TypeMap<int>& map, std::integer_sequence<int, N...>)
+    {
+        (map.put<TypeKey<N>>(static_cast<int>(N)), ...);
+    }
+
+    void typeMapFind(PrismBenchmarks::BenchmarkState& state)
+    {
+        TypeMap<int> map;
+        putKeys(map, std::make_integer_sequence<int, 32>());
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(map.find<TypeKey<7>>()->second);
+            PrismBenchmarks::doNotOptimize(map.find<TypeKey<23>>()->second);
+        }
+        state.setItemsProcessed(state.getIterations() * 2);
+    }
+
+    void typeMapFindMiss(PrismBenchmarks::BenchmarkState& state)
+    {
+        TypeMap<int> map;
+        putKeys(map, std::make_integer_sequence<int, 32>());
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(map.find<TypeKey<100>>() == map.end());
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void getService(PrismBenchmarks::BenchmarkState& state)
+    {
+        // Registering twice is a no-op, the asset benchmarks may have already registered the job system
+        Prism::Utility::ServiceLocator::registerService<Prism::Utility::JobSystem, Prism::Utility::JobSystem>();
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(Prism::Utility::ServiceLocator::getService<Prism::Utility::JobSystem>());
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+}
+
+PRISM_BENCHMARK("TypeMap/find", typeMapFind);
+PRISM_BENCHMARK("TypeMap/findMiss", typeMapFindMiss);
+PRISM_BENCHMARK("ServiceLocator/getService", getService);
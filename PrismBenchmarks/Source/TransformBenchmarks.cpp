@@ -0,0 +1,55 @@
+﻿#include "Benchmark.hpp"
+#include "Core/Transform.hpp"
+
+namespace
+{
+    // toMatrix caches the matrix until the transform changes, so the transform is touched every iteration
+    void toMatrix(PrismBenchmarks::BenchmarkState& state)
+    {
+        Prism::Core::Transform transform;
+        transform.setRotation(30.0f, 45.0f, 60.0f);
+        transform.setScale(2.0f);
+        float x = 0.0f;
+        while (state.keepRunning())
+        {
+            transform.setTranslationX(x);
+            x += 1.0f;
+            PrismBenchmarks::doNotOptimize(transform.toMatrix());
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void toMatrixCached(PrismBenchmarks::BenchmarkState& state)
+    {
+        Prism::Core::Transform transform;
+        transform.setTranslation(1.0f, 2.0f, 3.0f);
+        transform.setRotation(30.0f, 45.0f, 60.0f);
+        while (state.keepRunning())
+        {
+            PrismBenchmarks::doNotOptimize(transform.toMatrix());
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void combineWithParent(PrismBenchmarks::BenchmarkState& state)
+    {
+        Prism::Core::Transform parent;
+        parent.setTranslation(10.0f, 0.0f, -5.0f);
+        parent.setRotation(0.0f, 90.0f, 0.0f);
+        Prism::Core::Transform child;
+        child.setRotation(15.0f, 0.0f, 0.0f);
+        child.setScale(0.5f);
+        float x = 0.0f;
+        while (state.keepRunning())
+        {
+            child.setTranslationX(x);
+            x += 1.0f;
+            PrismBenchmarks::doNotOptimize(child.combineWithParent(parent));
+        }
+        state.setItemsProcessed(state.getIterations());
+    }
+}
+
+PRISM_BENCHMARK("Transform/toMatrix", toMatrix);
+PRISM_BENCHMARK("Transform/toMatrixCached", toMatrixCached);
+PRISM_BENCHMARK("Transform/combineWithParent", combineWithParent);
@@ -0,0 +1,116 @@
+#include <filesystem>
+#include <iostream>
+
+#include "Assets/CookedStaticMesh.hpp"
+#include "Assets/StaticMeshCooker.hpp"
+#include "Utilities/StringUtils.hpp"
+#include "cxxopts.hpp"
+
+namespace
+{
+    struct CookStatistics
+    {
+        uint32_t cooked = 0;
+        uint32_t upToDate = 0;
+        uint32_t failed = 0;
+    };
+
+    bool isCookableSource(const std::filesystem::path& path)
+    {
+        return Prism::Utility::equalsIgnoreCase(path.extension().string(), ".obj");
+    }
+
+    void cookFile(const std::filesystem::path& source, const std::filesystem::path& target, const bool force,
+                  CookStatistics& statistics)
+    {
+        const auto sourceFileName = source.generic_string();
+        const auto targetFileName = target.generic_string();
+        if (!force && Prism::Assets::StaticMeshCooker::isUpToDate(sourceFileName, targetFileName))
+        {
+            ++statistics.upToDate;
+            return;
+        }
+
+        if (target.has_parent_path())
+        {
+            std::filesystem::create_directories(target.parent_path());
+        }
+        if (Prism::Assets::StaticMeshCooker::cook(sourceFileName, targetFileName))
+        {
+            std::cout << "Cooked '" << sourceFileName << "' to '" << targetFileName << "'" << std::endl;
+            ++statistics.cooked;
+        }
+        else
+        {
+            std::cerr << "Failed to cook '" << sourceFileName << "'" << std::endl;
+            ++statistics.failed;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cxxopts::Options options("PrismMeshCooker", "Converts source meshes into Prism's cooked binary mesh format");
+        options.add_options()
+            ("i,input", "Source mesh file or directory to cook recursively", cxxopts::value<std::string>())
+            ("o,output", "Output file or directory, defaults to next to the source files", cxxopts::value<std::string>())
+            ("f,force", "Cook even if the cooked file is up to date", cxxopts::value<bool>()->default_value("false"))
+            ("h,help", "Print usage");
+        options.parse_positional({"input"});
+
+        const auto parsedOptions = options.parse(argc, argv);
+        if (parsedOptions.count("help") || !parsedOptions.count("input"))
+        {
+            std::cout << options.help() << std::endl;
+            return parsedOptions.count("help") ? 0 : 1;
+        }
+
+        const std::filesystem::path input = parsedOptions["input"].as<std::string>();
+        const auto hasOutput = parsedOptions.count("output") > 0;
+        const std::filesystem::path output = hasOutput ? parsedOptions["output"].as<std::string>() : "";
+        const auto force = parsedOptions["force"].as<bool>();
+
+        CookStatistics statistics;
+        if (std::filesystem::is_directory(input))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(input))
+            {
+                if (!entry.is_regular_file() || !isCookableSource(entry.path()))
+                {
+                    continue;
+                }
+                auto target = std::filesystem::path(
+                    Prism::Assets::CookedStaticMesh::getCookedFileName(entry.path().generic_string()));
+                if (hasOutput)
+                {
+                    target = output / std::filesystem::relative(target, input);
+                }
+                cookFile(entry.path(), target, force, statistics);
+            }
+        }
+        else if (std::filesystem::is_regular_file(input))
+        {
+            const auto target = hasOutput
+                                    ? output
+                                    : std::filesystem::path(
+                                        Prism::Assets::CookedStaticMesh::getCookedFileName(input.generic_string()));
+            cookFile(input, target, force, statistics);
+        }
+        else
+        {
+            std::cerr << "Input '" << input.generic_string() << "' doesn't exist" << std::endl;
+            return 1;
+        }
+
+        std::cout << "Cooked: " << statistics.cooked << ", up to date: " << statistics.upToDate << ", failed: " <<
+            statistics.failed << std::endl;
+        return statistics.failed == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Caught exception at top-level: \"" << e.what() << "\"" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,17 @@
+#version 460
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    // Debug lines are given in world space, flip Y the same way Transform::toMatrix does for scene objects
+    gl_Position = ubo.projection * ubo.view * vec4(inPosition * vec3(1.0, -1.0, 1.0), 1.0);
+    fragColor = inColor;
+}
@@ -1,12 +1,12 @@
 ﻿#include "EditorGuiComponent.hpp"
 #include "Utilities/ServiceLocator.hpp"
 #include "Core/ISceneManager.hpp"
+#include "Core/SceneFile.hpp"
 #include <glm/gtc/random.hpp>
 
 #include "Assets/AssetManager.hpp"
 #include "Rendering/Vulkan/ImGui/imgui.h"
 
-#include "Rendering/DebugDrawHelper.hpp"
 #include "Rendering/GraphicsDebugBridge.hpp"
 
 
@@ -18,7 +18,14 @@ void EditorGuiComponent::renderUi()
     const auto tableVerticalSize = ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * 10);
 
     const auto sceneManager = Prism::Utility::ServiceLocator::getService<Prism::Core::ISceneManager>();
-    const auto actors = sceneManager->getActiveScene()->getActors();
+    updateActorList();
+
+    if (ImGui::Button("Save Scene"))
+    {
+        Prism::Core::SceneFile::save(*sceneManager->getActiveScene(), savedSceneFileName);
+    }
+    ImGui::SameLine();
+    ImGui::Text("%s", savedSceneFileName);
 
     if (ImGui::BeginTable("Table_Actors", 1, flags, tableVerticalSize))
     {
@@ -65,6 +72,36 @@ void EditorGuiComponent::renderUi()
     ImGui::End();
 }
 
+void EditorGuiComponent::updateActorList()
+{
+    const auto activeScene = Prism::Utility::ServiceLocator::getService<Prism::Core::ISceneManager>()->
+        getActiveScene();
+    auto& journal = activeScene->getJournal();
+    if (journal.getId() != sceneJournalId)
+    {
+        sceneJournalId = journal.getId();
+        sceneJournalSubscriber = journal.subscribe();
+        actors = activeScene->getActors();
+        selectedActor = nullptr;
+        return;
+    }
+    for (const auto& change : journal.consumeChanges(sceneJournalSubscriber))
+    {
+        if (change.type == Prism::Core::SceneChangeType::ActorSpawned && change.actor)
+        {
+            actors.push_back(change.actor);
+        }
+        else if (change.type == Prism::Core::SceneChangeType::ActorDestroyed)
+        {
+            std::erase(actors, change.actor);
+            if (selectedActor == change.actor)
+            {
+                selectedActor = nullptr;
+            }
+        }
+    }
+}
+
 void EditorGuiComponent::renderSelectedActorInfo(const RawPtr<Prism::Core::Actor> actor)
 {
     ImGui::Begin("Selected Actor");
@@ -118,10 +155,6 @@ void EditorGuiComponent::renderSelectedActorInfo(const RawPtr<Prism::Core::Actor
         actor->setActorScale(actorScale);
     }
 
-    if (const auto debugDrawHelper = dynamic_cast<Prism::Rendering::DebugDrawHelper*>(actor.get()))
-    {
-    }
-
     ImGui::End();
 }
 
@@ -143,4 +176,13 @@ void EditorGuiComponent::renderGraphicsDebugBridgeInfo()
 
 void EditorGuiComponent::shutdown()
 {
+    // The scene may already be gone, its journal then went with it
+    const auto activeScene = Prism::Utility::ServiceLocator::getService<Prism::Core::ISceneManager>()->
+        getActiveScene();
+    if (activeScene && activeScene->getJournal().getId() == sceneJournalId)
+    {
+        activeScene->getJournal().unsubscribe(sceneJournalSubscriber);
+    }
+    actors.clear();
+    sceneJournalId = 0;
 }
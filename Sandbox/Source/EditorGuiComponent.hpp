@@ -12,5 +12,15 @@ public:
     void shutdown() override;
 
 private:
+    // Applies the spawns and kills of the active scene to the actor list
+    void updateActorList();
+
+    // Load it again with --scene
+    inline constexpr static auto savedSceneFileName = "Scene.pscene";
+
     RawPtr<Prism::Core::Actor> selectedActor;
+    std::vector<RawPtr<Prism::Core::Actor>> actors;
+    // Journal of the scene the actor list mirrors
+    uint64_t sceneJournalId = 0;
+    uint32_t sceneJournalSubscriber = 0;
 };
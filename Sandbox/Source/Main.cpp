@@ -7,6 +7,7 @@
 #include "BasicBootstrapper.hpp"
 #include "Utilities/Logging/Log.hpp"
 #include "SandboxScene.hpp"
+#include "StressBenchmarkScene.hpp"
 #include "cxxopts.hpp"
 #include "Utilities/CommandLineArgsManager.hpp"
 
@@ -20,7 +21,26 @@ int main(int argc, char* argv[])
             ("d,debug", "Enable debug logging", cxxopts::value<bool>()->default_value("false"))
             ("h,help", "Print usage")
             ("v,version", "Print version")
-            ("headless", "(NOT WORKING YET!) Disable window rendering", cxxopts::value<bool>()->default_value("false"));
+            ("headless", "Run without a window, nothing is rendered", cxxopts::value<bool>()->default_value("false"))
+            ("config", "Console variable file read at startup, defaults to Prism.cfg", cxxopts::value<std::string>())
+            ("cvar", "Set a console variable as name=value, overrides the config file, may be repeated",
+             cxxopts::value<std::vector<std::string>>())
+            ("scene", "Scene file (.pscene) the sandbox scene is loaded from", cxxopts::value<std::string>())
+            ("frame-stats-window", "Number of frames kept for frame time percentiles",
+             cxxopts::value<uint32_t>()->default_value("1000"))
+            ("frame-stats-csv", "Stream per frame timings to the given CSV file", cxxopts::value<std::string>())
+            ("fail-on-frame-allocation",
+             "Break into the debugger on main thread allocations after a warmup, needs --allocation-tracking builds",
+             cxxopts::value<bool>()->default_value("false"))
+            ("benchmark", "Run the deterministic stress benchmark scene and exit",
+             cxxopts::value<bool>()->default_value("false"))
+            ("benchmark-seed", "Seed the benchmark scene is generated from", cxxopts::value<uint32_t>())
+            ("benchmark-static-actors", "Number of static mesh actors", cxxopts::value<uint32_t>())
+            ("benchmark-moving-actors", "Number of actors that move every frame", cxxopts::value<uint32_t>())
+            ("benchmark-churn", "Actors spawned and killed per frame", cxxopts::value<uint32_t>())
+            ("benchmark-warmup-frames", "Frames simulated before measuring", cxxopts::value<uint32_t>())
+            ("benchmark-frames", "Number of measured frames", cxxopts::value<uint32_t>())
+            ("benchmark-report", "JSON file the benchmark report is written to", cxxopts::value<std::string>());
 
 
         auto parsedOptions = options.parse(argc, argv);
@@ -31,7 +51,15 @@ int main(int argc, char* argv[])
             commandLineArgs.push_back({kvp.key(), kvp.value()});
         }
 
-        auto* scene = new SandboxScene();
+        Prism::Core::Scene* scene;
+        if (parsedOptions["benchmark"].as<bool>())
+        {
+            scene = new StressBenchmarkScene();
+        }
+        else
+        {
+            scene = new SandboxScene(parsedOptions.count("scene") ? parsedOptions["scene"].as<std::string>() : "");
+        }
         auto engine = Prism::Core::Engine(new BasicBootstrapper(scene));
         engine.setup(commandLineArgs);
         engine.start();
@@ -1,17 +1,22 @@
 ﻿#include "SandboxScene.hpp"
 
 #include <filesystem>
+#include <stdexcept>
 #include <glm/gtc/random.hpp>
 
 #include "Assets/AssetManager.hpp"
+#include "Assets/AssetMemoryGuiComponent.hpp"
 #include "Core/CameraActor.hpp"
 #include "Core/StaticMeshActor.hpp"
 #include "Rendering/DebugDrawHelper.hpp"
 #include "EditorGuiComponent.hpp"
 #include "Rendering/IRendererManager.hpp"
+#include "Utilities/ConsoleVariablesGuiComponent.hpp"
 #include "Utilities/ServiceLocator.hpp"
+#include "Utilities/Profiling/AllocationTrackerGuiComponent.hpp"
+#include "Utilities/Profiling/ProfilerGuiComponent.hpp"
 
-SandboxScene::SandboxScene()
+SandboxScene::SandboxScene(std::string sceneFileName) : sceneFileName(std::move(sceneFileName))
 {
 }
 
@@ -24,18 +29,62 @@ void SandboxScene::tick(float deltaTime)
     Scene::tick(deltaTime);
 }
 
+void SandboxScene::preload()
+{
+    Scene::preload();
+    if (sceneFileName.empty())
+    {
+        return;
+    }
+    sceneFile = Prism::Core::SceneFile::open(sceneFileName);
+    if (!sceneFile)
+    {
+        throw std::runtime_error("Failed to load scene file " + sceneFileName);
+    }
+}
+
 void SandboxScene::init()
 {
     Scene::init();
+    if (sceneFile)
+    {
+        sceneFile->instantiate(*this);
+        // The mapping and the asset handles are not needed anymore, the components hold their own handles
+        sceneFile.reset();
+    }
+    else
+    {
+        initDefaultActors();
+    }
+
+    // World axes at the origin
+    const auto debugDrawHelper = Prism::Utility::ServiceLocator::getService<Prism::Rendering::DebugDrawHelper>();
+    constexpr float lifetime = Prism::Rendering::DebugDrawHelper::persistentLifetime;
+    debugDrawHelper->drawArrow(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f),
+                               lifetime);
+    debugDrawHelper->drawArrow(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+                               lifetime);
+    debugDrawHelper->drawArrow(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f),
+                               lifetime);
+}
+
+void SandboxScene::initDefaultActors()
+{
     const auto cameraActor = registerActor(std::make_unique<Prism::Core::CameraActor>());
     const auto staticMeshActor = registerActor(std::make_unique<Prism::Core::StaticMeshActor>());
-    const auto staticMeshAsset = Prism::Utility::ServiceLocator::getService<Prism::Assets::AssetManager>()->getAsset
-        <Prism::Assets::StaticMeshAsset>("Assets/StaticMeshes/Crate/Crate.obj");
     const auto staticMeshComp = staticMeshActor->getFirstComponentOfType<Prism::Core::StaticMeshComponent>();
     staticMeshComp->setMeshColor(glm::linearRand(glm::vec3(0.0f), glm::vec3(1.0f)));
-    staticMeshComp->setStaticMeshAsset(staticMeshAsset);
+    // Loads in the background, the mesh gets assigned on the main thread once it is ready
+    Prism::Utility::ServiceLocator::getService<Prism::Assets::AssetManager>()->requestAsset
+        <Prism::Assets::StaticMeshAsset>("Assets/StaticMeshes/Crate/Crate.obj",
+                                         [staticMeshComp](const Prism::Assets::AssetHandle<Prism::Assets::StaticMeshAsset>& asset)
+                                         {
+                                             if (asset)
+                                             {
+                                                 staticMeshComp->setStaticMeshAsset(asset);
+                                             }
+                                         });
     cameraActor->setActorPosition(glm::vec3(0.0f, 0.0f, -5.0f));
-    const auto debugDrawHelper = registerActor(std::make_unique<Prism::Rendering::DebugDrawHelper>());
 }
 
 void SandboxScene::beginPlay()
@@ -53,5 +102,15 @@ void SandboxScene::initGuiComponents()
     Scene::initGuiComponents();
     const auto renderer = Prism::Utility::ServiceLocator::getService<Prism::Rendering::IRendererManager>()->
         getRenderer();
-    renderer->getImmediateModeGui()->addImmediateModeGuiComponent<EditorGuiComponent>();
+    const auto immediateModeGui = renderer->getImmediateModeGui();
+    // Headless runs have no GUI
+    if (!immediateModeGui)
+    {
+        return;
+    }
+    immediateModeGui->addImmediateModeGuiComponent<EditorGuiComponent>();
+    immediateModeGui->addImmediateModeGuiComponent<Prism::Utility::Profiling::ProfilerGuiComponent>();
+    immediateModeGui->addImmediateModeGuiComponent<Prism::Utility::Profiling::AllocationTrackerGuiComponent>();
+    immediateModeGui->addImmediateModeGuiComponent<Prism::Assets::AssetMemoryGuiComponent>();
+    immediateModeGui->addImmediateModeGuiComponent<Prism::Utility::ConsoleVariablesGuiComponent>();
 }
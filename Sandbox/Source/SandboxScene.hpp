@@ -1,16 +1,28 @@
 ﻿#pragma once
+#include <memory>
+#include <string>
+
 #include "Core/Scene.hpp"
+#include "Core/SceneFile.hpp"
 
 class SandboxScene : public Prism::Core::Scene
 {
 public:
-    SandboxScene();
+    // Without a scene file the default crate scene is built
+    explicit SandboxScene(std::string sceneFileName = {});
     ~SandboxScene() override;
     void tick(float deltaTime) override;
 
 protected:
+    void preload() override;
     void init() override;
     void beginPlay() override;
     void shutdown() override;
     void initGuiComponents() override;
+
+private:
+    void initDefaultActors();
+
+    std::string sceneFileName;
+    std::unique_ptr<Prism::Core::SceneFile> sceneFile;
 };
@@ -0,0 +1,272 @@
+﻿#include "StressBenchmarkScene.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <glm/gtc/constants.hpp>
+
+#include "Assets/AssetManager.hpp"
+#include "Core/CameraActor.hpp"
+#include "Core/IEngineManager.hpp"
+#include "Core/ISceneManager.hpp"
+#include "Core/ITimeManager.hpp"
+#include "Core/StaticMeshActor.hpp"
+#include "Rendering/IRendererManager.hpp"
+#include "Utilities/CommandLineArgsManager.hpp"
+#include "Utilities/ProcessMemory.hpp"
+#include "Utilities/ServiceLocator.hpp"
+
+StressBenchmarkSettings StressBenchmarkSettings::fromCommandLine()
+{
+    const auto args = Prism::Utility::ServiceLocator::getService<Prism::Utility::CommandLineArgsManager>();
+    StressBenchmarkSettings settings;
+    settings.seed = args->getArgValueAsUInt32("benchmark-seed", settings.seed);
+    settings.staticActorCount = args->getArgValueAsUInt32("benchmark-static-actors", settings.staticActorCount);
+    settings.movingActorCount = args->getArgValueAsUInt32("benchmark-moving-actors", settings.movingActorCount);
+    settings.churnPerFrame = args->getArgValueAsUInt32("benchmark-churn", settings.churnPerFrame);
+    settings.warmupFrames = args->getArgValueAsUInt32("benchmark-warmup-frames", settings.warmupFrames);
+    settings.measuredFrames = std::max(args->getArgValueAsUInt32("benchmark-frames", settings.measuredFrames), 1u);
+    settings.reportFileName = args->getArgValue("benchmark-report", settings.reportFileName);
+    return settings;
+}
+
+void StressBenchmarkScene::preload()
+{
+    Scene::preload();
+    // Loaded before the scene starts, a mesh popping in during the run would make the frames incomparable
+    meshAsset = Prism::Utility::ServiceLocator::getService<Prism::Assets::AssetManager>()->getAsset<
+        Prism::Assets::StaticMeshAsset>("Assets/StaticMeshes/Crate/Crate.obj");
+}
+
+void StressBenchmarkScene::init()
+{
+    Scene::init();
+    settings = StressBenchmarkSettings::fromCommandLine();
+    random.seed(settings.seed);
+    LOG_INFO("Starting stress benchmark with seed {}: {} static actors, {} moving actors, {} spawns/kills per frame, "
+             "{} warmup frames, {} measured frames", settings.seed, settings.staticActorCount,
+             settings.movingActorCount, settings.churnPerFrame, settings.warmupFrames, settings.measuredFrames);
+
+    // Thrown here on the main thread instead of in the preload, so the benchmark run aborts
+    if (!meshAsset)
+    {
+        throw std::runtime_error("StressBenchmarkScene: failed to load the benchmark mesh");
+    }
+
+    const auto totalActorCount = settings.staticActorCount + settings.movingActorCount +
+        settings.churnPerFrame * churnLifetimeFrames;
+    worldExtent = std::sqrt(static_cast<float>(std::max(totalActorCount, 1u))) * actorSpacing * 0.5f;
+
+    cameraActor = registerActor(std::make_unique<Prism::Core::CameraActor>());
+    for (uint32_t i = 0; i < settings.staticActorCount; ++i)
+    {
+        registerActor(createMeshActor(randomPosition()));
+    }
+    movingActors.reserve(settings.movingActorCount);
+    for (uint32_t i = 0; i < settings.movingActorCount; ++i)
+    {
+        MovingActor movingActor;
+        movingActor.center = randomPosition();
+        movingActor.radius = randomFloat(1.0f, actorSpacing * 2.0f);
+        movingActor.angularSpeed = randomFloat(-2.0f, 2.0f);
+        movingActor.phase = randomFloat(0.0f, glm::two_pi<float>());
+        movingActor.actor = registerActor(createMeshActor(movingActor.center));
+        movingActors.push_back(movingActor);
+    }
+    updateMovingActors(0.0f);
+    updateCamera(0.0f);
+}
+
+void StressBenchmarkScene::tick(const float deltaTime)
+{
+    Scene::tick(deltaTime);
+    if (finished)
+    {
+        return;
+    }
+
+    // The simulation ignores the real frame delta, so every run produces the exact same frames
+    ++frameIndex;
+    const float simulationTime = static_cast<float>(frameIndex) * simulationStepSeconds;
+    updateMovingActors(simulationTime);
+    updateCamera(simulationTime);
+    churnActorsForFrame();
+
+    auto& frameStatistics = Prism::Utility::ServiceLocator::getService<Prism::Core::ITimeManager>()->
+        getFrameStatistics();
+    if (!measuring)
+    {
+        if (frameIndex < settings.warmupFrames)
+        {
+            return;
+        }
+        // Drops the warmup samples, afterwards the window holds exactly the measured frames
+        frameStatistics.setWindowSize(settings.measuredFrames);
+        measureStartFrameCount = frameStatistics.getTotalFrameCount();
+        measuring = true;
+        LOG_INFO("Stress benchmark warmup done, measuring {} frames", settings.measuredFrames);
+        return;
+    }
+
+    recordDrawCount();
+    if (frameStatistics.getTotalFrameCount() - measureStartFrameCount < settings.measuredFrames)
+    {
+        return;
+    }
+    finished = true;
+    writeReport();
+    Prism::Utility::ServiceLocator::getService<Prism::Core::IEngineManager>()->requestShutdown();
+}
+
+float StressBenchmarkScene::randomFloat(const float min, const float max)
+{
+    // 24 bits fit exactly into a float's mantissa
+    const float unit = static_cast<float>(random() >> 8) / 16777216.0f;
+    return min + (max - min) * unit;
+}
+
+glm::vec3 StressBenchmarkScene::randomPosition()
+{
+    const float x = randomFloat(-worldExtent, worldExtent);
+    const float y = randomFloat(-actorSpacing, actorSpacing);
+    const float z = randomFloat(-worldExtent, worldExtent);
+    return {x, y, z};
+}
+
+std::unique_ptr<Prism::Core::Actor> StressBenchmarkScene::createMeshActor(const glm::vec3& position)
+{
+    auto actor = std::make_unique<Prism::Core::StaticMeshActor>();
+    actor->setActorPosition(position);
+    actor->setActorRotation(glm::vec3(randomFloat(0.0f, 360.0f), randomFloat(0.0f, 360.0f), 0.0f));
+    const auto staticMeshComponent = actor->getFirstComponentOfType<Prism::Core::StaticMeshComponent>();
+    staticMeshComponent->setMeshColor(glm::vec3(randomFloat(0.0f, 1.0f), randomFloat(0.0f, 1.0f),
+                                                randomFloat(0.0f, 1.0f)));
+    // Set before the actor is initialized, so the mesh is created right away on registration
+    staticMeshComponent->setStaticMeshAsset(meshAsset);
+    return actor;
+}
+
+void StressBenchmarkScene::updateMovingActors(const float simulationTime)
+{
+    for (const auto& movingActor : movingActors)
+    {
+        const float angle = movingActor.phase + movingActor.angularSpeed * simulationTime;
+        const auto offset = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * movingActor.radius;
+        movingActor.actor->setActorPosition(movingActor.center + offset);
+        movingActor.actor->setActorRotation(glm::vec3(0.0f, glm::degrees(angle), 0.0f));
+    }
+}
+
+void StressBenchmarkScene::updateCamera(const float simulationTime)
+{
+    // Slow orbit around the whole scene with a gentle height change, always looking at the center
+    const float angle = simulationTime * 0.2f;
+    const float height = worldExtent * (0.5f + 0.25f * std::sin(simulationTime * 0.5f));
+    const auto position = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * worldExtent * 1.2f +
+        glm::vec3(0.0f, height, 0.0f);
+    cameraActor->setActorPosition(position);
+    cameraActor->setActorRotation(Prism::Core::Transform::lookAt(glm::normalize(-position),
+                                                                 Prism::Core::Transform::localUp));
+}
+
+void StressBenchmarkScene::churnActorsForFrame()
+{
+    if (settings.churnPerFrame == 0)
+    {
+        return;
+    }
+    const auto sceneManager = Prism::Utility::ServiceLocator::getService<Prism::Core::ISceneManager>();
+    // Kills and spawns are applied by the SceneManager after this tick, like gameplay code would do it
+    while (churnActors.size() + settings.churnPerFrame > settings.churnPerFrame * churnLifetimeFrames)
+    {
+        sceneManager->unregisterActor(churnActors.front());
+        churnActors.pop_front();
+        ++killedActorCount;
+    }
+    for (uint32_t i = 0; i < settings.churnPerFrame; ++i)
+    {
+        churnActors.push_back(sceneManager->registerActor(createMeshActor(randomPosition())));
+        ++spawnedActorCount;
+    }
+}
+
+void StressBenchmarkScene::recordDrawCount()
+{
+    // Refers to the previous frame, as the renderer runs after the scene tick
+    const auto drawCount = Prism::Utility::ServiceLocator::getService<Prism::Rendering::IRendererManager>()->
+                           getRenderer()->getDrawCount();
+    if (drawCountFrames++ == 0)
+    {
+        drawCountMin = drawCount;
+        drawCountMax = drawCount;
+    }
+    drawCountMin = std::min(drawCountMin, drawCount);
+    drawCountMax = std::max(drawCountMax, drawCount);
+    drawCountSum += drawCount;
+}
+
+void StressBenchmarkScene::writeReport() const
+{
+    const auto& frameStatistics = Prism::Utility::ServiceLocator::getService<Prism::Core::ITimeManager>()->
+        getFrameStatistics();
+    const bool headless = Prism::Utility::ServiceLocator::getService<Prism::Utility::CommandLineArgsManager>()->
+        getArgValueAsBool("headless", false);
+
+    std::ofstream file(settings.reportFileName, std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Failed to open benchmark report file: {}", settings.reportFileName);
+        return;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"settings\": {\n";
+    file << "    \"seed\": " << settings.seed << ",\n";
+    file << "    \"staticActors\": " << settings.staticActorCount << ",\n";
+    file << "    \"movingActors\": " << settings.movingActorCount << ",\n";
+    file << "    \"churnPerFrame\": " << settings.churnPerFrame << ",\n";
+    file << "    \"warmupFrames\": " << settings.warmupFrames << ",\n";
+    file << "    \"measuredFrames\": " << settings.measuredFrames << ",\n";
+    file << "    \"headless\": " << (headless ? "true" : "false") << "\n";
+    file << "  },\n";
+
+    constexpr std::array<std::pair<Prism::Utility::FrameMetric, const char*>, 4> metrics = {
+        {
+            {Prism::Utility::FrameMetric::Frame, "frame"},
+            {Prism::Utility::FrameMetric::Update, "update"},
+            {Prism::Utility::FrameMetric::Render, "render"},
+            {Prism::Utility::FrameMetric::Physics, "physics"}
+        }
+    };
+    file << "  \"phases\": {\n";
+    for (size_t i = 0; i < metrics.size(); ++i)
+    {
+        const auto summary = frameStatistics.computeSummary(metrics[i].first);
+        file << "    \"" << metrics[i].second << "\": {";
+        file << "\"samples\": " << summary.sampleCount << ", ";
+        file << "\"minMs\": " << summary.min << ", ";
+        file << "\"averageMs\": " << summary.average << ", ";
+        file << "\"p50Ms\": " << summary.p50 << ", ";
+        file << "\"p95Ms\": " << summary.p95 << ", ";
+        file << "\"p99Ms\": " << summary.p99 << ", ";
+        file << "\"maxMs\": " << summary.max << "}";
+        file << (i + 1 < metrics.size() ? ",\n" : "\n");
+    }
+    file << "  },\n";
+
+    file << "  \"draws\": {";
+    file << "\"min\": " << drawCountMin << ", ";
+    file << "\"average\": " << static_cast<double>(drawCountSum) / std::max(drawCountFrames, 1u) << ", ";
+    file << "\"max\": " << drawCountMax << "},\n";
+    file << "  \"actors\": {";
+    file << "\"final\": " << getActors().size() << ", ";
+    file << "\"spawned\": " << spawnedActorCount << ", ";
+    file << "\"killed\": " << killedActorCount << "},\n";
+    file << "  \"memory\": {";
+    file << "\"peakResidentBytes\": " << Prism::Utility::ProcessMemory::getPeakResidentBytes() << ", ";
+    file << "\"currentResidentBytes\": " << Prism::Utility::ProcessMemory::getCurrentResidentBytes() << "}\n";
+    file << "}\n";
+    LOG_INFO("Wrote stress benchmark report to {}", settings.reportFileName);
+}
@@ -0,0 +1,87 @@
+﻿#pragma once
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Assets/AssetHandle.hpp"
+#include "Assets/StaticMeshAsset.hpp"
+#include "Core/Actor.hpp"
+#include "Core/Scene.hpp"
+
+struct StressBenchmarkSettings
+{
+    uint32_t seed = 1337;
+    uint32_t staticActorCount = 2000;
+    uint32_t movingActorCount = 500;
+    // Actors spawned and killed per frame once the churn pool is full
+    uint32_t churnPerFrame = 10;
+    uint32_t warmupFrames = 120;
+    uint32_t measuredFrames = 1000;
+    std::string reportFileName = "BenchmarkReport.json";
+
+    // Reads the benchmark-* command line options, missing ones keep their default
+    [[nodiscard]] static StressBenchmarkSettings fromCommandLine();
+};
+
+/*
+ * Deterministic load for performance measurements, started with --benchmark.
+ * Everything is generated from the seed and simulated with a fixed step, so frame N always contains the same actors
+ * at the same places regardless of how fast the machine is. After the warmup the scene measures a fixed amount of
+ * frames, writes a JSON report and shuts the engine down. Works with and without --headless.
+ */
+class StressBenchmarkScene : public Prism::Core::Scene
+{
+public:
+    StressBenchmarkScene() = default;
+    ~StressBenchmarkScene() override = default;
+    void tick(float deltaTime) override;
+
+protected:
+    void preload() override;
+    void init() override;
+
+private:
+    struct MovingActor
+    {
+        RawPtr<Prism::Core::Actor> actor;
+        glm::vec3 center;
+        float radius;
+        float angularSpeed;
+        float phase;
+    };
+
+    // Churned actors live this many frames, the pool holds churnPerFrame * churnLifetimeFrames actors
+    inline constexpr static uint32_t churnLifetimeFrames = 60;
+    inline constexpr static float simulationStepSeconds = 1.0f / 60.0f;
+    inline constexpr static float actorSpacing = 4.0f;
+
+    StressBenchmarkSettings settings;
+    // mt19937 output is fully specified by the standard, unlike the std distributions, so it's used raw
+    std::mt19937 random;
+    Prism::Assets::AssetHandle<Prism::Assets::StaticMeshAsset> meshAsset;
+    RawPtr<Prism::Core::Actor> cameraActor;
+    std::vector<MovingActor> movingActors;
+    std::deque<RawPtr<Prism::Core::Actor>> churnActors;
+    float worldExtent = 0.0f;
+    uint32_t frameIndex = 0;
+    uint64_t measureStartFrameCount = 0;
+    uint32_t drawCountFrames = 0;
+    uint64_t drawCountSum = 0;
+    uint32_t drawCountMin = 0;
+    uint32_t drawCountMax = 0;
+    uint64_t spawnedActorCount = 0;
+    uint64_t killedActorCount = 0;
+    bool measuring = false;
+    bool finished = false;
+
+    [[nodiscard]] float randomFloat(float min, float max);
+    [[nodiscard]] glm::vec3 randomPosition();
+    std::unique_ptr<Prism::Core::Actor> createMeshActor(const glm::vec3& position);
+    void updateMovingActors(float simulationTime);
+    void updateCamera(float simulationTime);
+    void churnActorsForFrame();
+    void recordDrawCount();
+    void writeReport() const;
+};
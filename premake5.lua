@@ -3,12 +3,33 @@
 -- Dependency Inclusion
 include("conandeps.premake5.lua")
 
+newoption
+{
+	trigger = "profiling",
+	description = "Compile the PRISM_PROFILE_* instrumentation in, it expands to nothing otherwise"
+}
+
+newoption
+{
+	trigger = "allocation-tracking",
+	description = "Replace the global operator new/delete to count heap allocations per PRISM_ALLOCATION_SCOPE tag"
+}
+
 workspace "Prism"
 	conan_setup()
 	startproject "Sandbox"
 	architecture "x64"
 	configurations {"Debug", "Release"}
 
+	-- Set for the whole workspace, the instrumentation is header inline code and every project linking Prism has to agree on it
+	filter "options:profiling"
+		defines { "Prism_PROFILING" }
+
+	filter "options:allocation-tracking"
+		defines { "Prism_ALLOCATION_TRACKING" }
+
+	filter {}
+
 -- General Variables
 outputDir = "%{cfg.buildcfg}-%{cfg.system}-x64"
 
@@ -71,6 +92,93 @@ python3 "%{wks.location}/Build-Scripts/PostBuildExecutor.py" COPYFOLDER "../Dist
 		runtime "Release"
 		optimize "on"
 
+project "PrismMeshCooker"
+	location "PrismMeshCooker"
+	kind "ConsoleApp"
+	staticruntime "off"
+	language "C++"
+	cppdialect "C++20"
+	targetdir ("bin/" .. outputDir .. "/%{prj.name}")
+	objdir ("bin-intermediates/" .. outputDir .. "/%{prj.name}")
+	flags { "MultiProcessorCompile" }
+	linkoptions { conan_exelinkflags }
+	defines { "GLM_FORCE_DEPTH_ZERO_TO_ONE", "GLM_FORCE_LEFT_HANDED", "VULKAN_HPP_DISPATCH_LOADER_DYNAMIC=1" }
+	files
+	{
+		"%{prj.name}/Source/**.h", 
+		"%{prj.name}/Source/**.hpp", 
+		"%{prj.name}/Source/**.cpp"
+	}
+	
+	links
+	{
+		"Prism"
+	}
+
+	includedirs
+	{
+		"%{wks.location}/Prism/Source"
+	}
+	
+	filter "system:windows"
+		-- _CRT_SECURE_NO_WARNINGS is because a few dependencies use the old windows *cpy functions that are somewhat insecure
+		defines { "_CRT_SECURE_NO_WARNINGS" }
+		systemversion "latest"
+	
+	filter "configurations:Debug"
+		defines { "Prism_DEBUG" }
+		symbols "on"
+		runtime "Debug"
+		
+	filter "configurations:Release"
+		defines { "Prism_RELEASE" }
+		optimize "on"
+		runtime "Release"
+
+project "PrismBenchmarks"
+	location "PrismBenchmarks"
+	kind "ConsoleApp"
+	staticruntime "off"
+	language "C++"
+	cppdialect "C++20"
+	targetdir ("bin/" .. outputDir .. "/%{prj.name}")
+	objdir ("bin-intermediates/" .. outputDir .. "/%{prj.name}")
+	flags { "MultiProcessorCompile" }
+	linkoptions { conan_exelinkflags }
+	defines { "GLM_FORCE_DEPTH_ZERO_TO_ONE", "GLM_FORCE_LEFT_HANDED", "VULKAN_HPP_DISPATCH_LOADER_DYNAMIC=1" }
+	files
+	{
+		"%{prj.name}/Source/**.h", 
+		"%{prj.name}/Source/**.hpp", 
+		"%{prj.name}/Source/**.cpp"
+	}
+	
+	links
+	{
+		"Prism"
+	}
+
+	includedirs
+	{
+		"%{wks.location}/Prism/Source"
+	}
+	
+	filter "system:windows"
+		-- _CRT_SECURE_NO_WARNINGS is because a few dependencies use the old windows *cpy functions that are somewhat insecure
+		defines { "_CRT_SECURE_NO_WARNINGS" }
+		systemversion "latest"
+	
+	filter "configurations:Debug"
+		defines { "Prism_DEBUG" }
+		symbols "on"
+		runtime "Debug"
+		
+	-- Only Release numbers are meaningful, results are written to PrismBenchmarks.json in the working directory
+	filter "configurations:Release"
+		defines { "Prism_RELEASE" }
+		optimize "on"
+		runtime "Release"
+
 project "Sandbox"
 	location "Sandbox"
 	kind "ConsoleApp"
@@ -95,6 +203,12 @@ project "Sandbox"
 		"Prism"
 	}
 
+	-- The mesh cooker runs as part of the post build to cook the copied assets
+	dependson
+	{
+		"PrismMeshCooker"
+	}
+
 	includedirs
 	{
 		"%{wks.location}/Prism/Source"
@@ -110,6 +224,7 @@ project "Sandbox"
 python "%{wks.location}Build-Scripts\PostBuildExecutor.py" COPYFOLDER "../Distribution/%{cfg.buildcfg}/" "%{cfg.targetdir}/" --ignoredFiles=".gitkeep"
 python "%{wks.location}Build-Scripts\PostBuildExecutor.py" COPYFOLDER "./Assets/" "%{cfg.targetdir}/Assets/" --ignoredFiles=".gitkeep" --deleteExistingTarget
 python "%{wks.location}Build-Scripts\PostBuildExecutor.py" SHADERCOMPILE "%{cfg.targetdir}/Assets/" "../Bootstrap-Tools/glslc.exe" --deleteShaderSources
+python "%{wks.location}Build-Scripts\PostBuildExecutor.py" MESHCOOK "%{cfg.targetdir}/Assets/" "%{cfg.targetdir}/../PrismMeshCooker/PrismMeshCooker.exe"
 	if %errorlevel% neq 0 exit %errorlevel% else exit 0
 			]]
 		}
@@ -121,6 +236,7 @@ python "%{wks.location}Build-Scripts\PostBuildExecutor.py" SHADERCOMPILE "%{cfg.
 	python3 "%{wks.location}/Build-Scripts/PostBuildExecutor.py" COPYFOLDER "../Distribution/%{cfg.buildcfg}/" "%{cfg.targetdir}/" --ignoredFiles=".gitkeep"; \
 	python3 "%{wks.location}/Build-Scripts/PostBuildExecutor.py" COPYFOLDER "./Assets/" "%{cfg.targetdir}/Assets/" --ignoredFiles=".gitkeep" --deleteExistingTarget; \
 	python3 "%{wks.location}/Build-Scripts/PostBuildExecutor.py" SHADERCOMPILE "%{cfg.targetdir}/Assets/" "../Bootstrap-Tools/glslc" --deleteShaderSources; \
+	python3 "%{wks.location}/Build-Scripts/PostBuildExecutor.py" MESHCOOK "%{cfg.targetdir}/Assets/" "%{cfg.targetdir}/../PrismMeshCooker/PrismMeshCooker"; \
 	if [ $$? -ne 0 ]; then \
 		exit $$?; \
 	fi; \